@@ -0,0 +1,213 @@
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+#include <algorithm>    // std::max
+#include <chrono>       // std::chrono::steady_clock
+#include <cstddef>      // std::size_t
+#include <cstring>      // std::strlen
+#include <fstream>      // std::ofstream
+#include <functional>   // std::function
+#include <iomanip>      // std::setw
+#include <iostream>     // std::cout
+#include <string>       // std::string
+#include <vector>       // std::vector
+
+/// A tiny benchmark harness with the shape of Google Benchmark.
+/*!
+ * A benchmark is a function that takes a `bench::state&` and runs the code to measure inside
+ * `for (auto _ : st)`. The runner picks the number of iterations so each benchmark runs for at
+ * least `--min_time` seconds. A benchmark registered for both `sc::vector` and `std::vector`
+ * is reported on one row, with the ratio between the two.
+ *
+ *     void push_back(bench::state& st) {
+ *       for (auto _ : st) { std::vector<int> v; v.push_back(1); bench::do_not_optimize(v.data()); }
+ *     }
+ */
+namespace bench {
+
+/// Keeps the compiler from optimizing `value` (and the work that produced it) away.
+template <typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+/// Keeps the compiler from assuming memory is unchanged.
+inline void clobber_memory(void) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : : "memory");
+#endif
+}
+
+/// Drives the measured loop and keeps the time.
+class state {
+ public:
+  using clock = std::chrono::steady_clock;
+
+  state(std::size_t iterations, std::size_t range) : m_iterations{iterations}, m_range{range} { /* empty */ }
+
+  /// The size argument the benchmark was registered with.
+  std::size_t range(void) const { return m_range; }
+  std::size_t iterations(void) const { return m_iterations; }
+
+  /// Stops the clock, e.g. while rebuilding the input of the next iteration.
+  void pause_timing(void) { m_elapsed += clock::now() - m_start; }
+  /// Restarts the clock after `pause_timing()`.
+  void resume_timing(void) { m_start = clock::now(); }
+
+  /// Total time spent inside the loop, in nanoseconds, minus the paused parts.
+  double elapsed_ns(void) const { return std::chrono::duration<double, std::nano>(m_elapsed).count(); }
+
+  /// Returned by the loop iterator; it does nothing but must be named.
+  struct value {
+    ~value() { /* non-trivial, so `auto _` does not trigger unused-variable warnings */ }
+  };
+
+  /// Counts the iterations down and stops the clock at the end.
+  class iterator {
+   public:
+    iterator(state* st, std::size_t left) : m_state{st}, m_left{left} { /* empty */ }
+    value operator*(void) const { return {}; }
+    iterator& operator++(void) { --m_left; return *this; }
+    bool operator!=(const iterator&) {
+      if (m_left != 0) return true;
+      m_state->pause_timing();
+      return false;
+    }
+
+   private:
+    state* m_state;
+    std::size_t m_left;
+  };
+
+  iterator begin(void) { resume_timing(); return iterator{this, m_iterations}; }
+  iterator end(void) { return iterator{this, 0}; }
+
+ private:
+  std::size_t m_iterations;       //!< How many times the loop runs.
+  std::size_t m_range;            //!< The size argument.
+  clock::time_point m_start{};    //!< When the clock was last (re)started.
+  clock::duration m_elapsed{0};   //!< Time accumulated so far.
+};
+
+/// A benchmark the runner knows about.
+struct entry {
+  std::string name;       //!< What is measured, e.g. "push_back".
+  std::string type;       //!< The element type, e.g. "int".
+  std::string container;  //!< "sc::vector" or "std::vector".
+  std::size_t range;      //!< The size argument.
+  std::function<void(state&)> fn;
+};
+
+/// The registered benchmarks.
+inline std::vector<entry>& registry(void) {
+  static std::vector<entry> entries;
+  return entries;
+}
+
+/// Command line options.
+struct options {
+  double min_time{0.1};     //!< Minimum measuring time of each benchmark, in seconds.
+  std::string filter;       //!< Only run benchmarks whose full name contains this.
+  std::string json;         //!< Write the results to this file, as JSON.
+};
+
+/// Result of running one benchmark.
+struct result {
+  const entry* e;
+  std::size_t iterations;
+  double ns_per_iter;
+};
+
+/// Runs `e`, growing the iteration count until the loop takes at least `min_time`.
+inline result run_one(const entry& e, double min_time) {
+  std::size_t iterations{1};
+  for (;;) {
+    state st{iterations, e.range};
+    e.fn(st);
+    double ns = st.elapsed_ns();
+    if (ns >= min_time * 1e9 || iterations >= 1'000'000'000) return {&e, iterations, ns / iterations};
+    // Aim a bit past the target, without growing more than 10x at a time.
+    double factor = ns <= 0 ? 10 : std::min(10.0, std::max(1.5, 1.4 * min_time * 1e9 / ns));
+    iterations = static_cast<std::size_t>(iterations * factor) + 1;
+  }
+}
+
+inline std::string full_name(const entry& e) {
+  return e.name + "<" + e.type + ">/" + std::to_string(e.range) + "/" + e.container;
+}
+
+/// Writes the results in a format close to Google Benchmark's `--benchmark_format=json`.
+inline void write_json(std::ostream& os, const std::vector<result>& results, double min_time) {
+  os << "{\n  \"context\": { \"min_time\": " << min_time << " },\n  \"benchmarks\": [\n";
+  for (std::size_t i{0}; i < results.size(); ++i) {
+    const auto& r = results[i];
+    os << "    { \"name\": \"" << full_name(*r.e) << "\", \"benchmark\": \"" << r.e->name
+       << "\", \"type\": \"" << r.e->type << "\", \"container\": \"" << r.e->container
+       << "\", \"range\": " << r.e->range << ", \"iterations\": " << r.iterations
+       << ", \"real_time\": " << std::fixed << std::setprecision(2) << r.ns_per_iter
+       << ", \"time_unit\": \"ns\" }" << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  os << "  ]\n}\n";
+}
+
+/// Parses `--min_time=<s>`, `--filter=<text>` and `--json=<file>`.
+inline options parse(int argc, char* argv[]) {
+  options opt;
+  for (int i{1}; i < argc; ++i) {
+    std::string arg{argv[i]};
+    auto value = [&](const char* key) { return arg.substr(std::strlen(key)); };
+    if (arg.rfind("--min_time=", 0) == 0) opt.min_time = std::stod(value("--min_time="));
+    else if (arg.rfind("--filter=", 0) == 0) opt.filter = value("--filter=");
+    else if (arg.rfind("--json=", 0) == 0) opt.json = value("--json=");
+    else std::cerr << "Ignoring unknown option " << arg << "\n";
+  }
+  return opt;
+}
+
+/// Runs every registered benchmark and prints one row per (name, type, range).
+inline int run(int argc, char* argv[]) {
+  options opt = parse(argc, argv);
+  std::vector<result> results;
+  for (const auto& e : registry())
+    if (opt.filter.empty() || full_name(e).find(opt.filter) != std::string::npos)
+      results.push_back(run_one(e, opt.min_time));
+
+  std::cout << std::left << std::setw(40) << "Benchmark" << std::right << std::setw(16) << "sc::vector (ns)"
+            << std::setw(17) << "std::vector (ns)" << std::setw(10) << "sc/std" << "\n"
+            << std::string(83, '-') << "\n";
+  for (const auto& r : results) {
+    if (r.e->container != "sc::vector") continue;
+    // The std::vector twin of this benchmark, if any.
+    const result* twin{nullptr};
+    for (const auto& other : results)
+      if (other.e->container == "std::vector" && other.e->name == r.e->name && other.e->type == r.e->type &&
+          other.e->range == r.e->range)
+        twin = &other;
+    std::cout << std::left << std::setw(40) << (r.e->name + "<" + r.e->type + ">/" + std::to_string(r.e->range))
+              << std::right << std::fixed << std::setprecision(1) << std::setw(16) << r.ns_per_iter;
+    if (twin != nullptr)
+      std::cout << std::setw(17) << twin->ns_per_iter << std::setw(10) << std::setprecision(2)
+                << r.ns_per_iter / twin->ns_per_iter;
+    std::cout << "\n";
+  }
+
+  if (!opt.json.empty()) {
+    std::ofstream out{opt.json};
+    if (!out) {
+      std::cerr << "Cannot write " << opt.json << "\n";
+      return 1;
+    }
+    write_json(out, results, opt.min_time);
+    std::cout << "\nResults written to " << opt.json << "\n";
+  }
+  return 0;
+}
+
+} // namespace bench.
+
+#endif
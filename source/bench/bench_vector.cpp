@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench.h"
+#include "vector.h"
+
+// =============================================================
+// sc::vector vs std::vector, side by side
+// =============================================================
+
+/// A 64-byte trivially copyable record.
+struct pod64 {
+  std::uint64_t fields[8];
+  friend bool operator==(const pod64& a, const pod64& b) { return std::equal(a.fields, a.fields + 8, b.fields); }
+};
+
+/// The i-th value of each element type used by the benchmarks.
+template <typename T> T make_value(std::size_t i);
+template <> int make_value<int>(std::size_t i) { return static_cast<int>(i); }
+// Long enough to live on the heap (past the small-string buffer).
+template <> std::string make_value<std::string>(std::size_t i) { return "benchmark value #" + std::to_string(i); }
+template <> pod64 make_value<pod64>(std::size_t i) { return pod64{ { i, i, i, i, i, i, i, i } }; }
+
+/// Something the iteration benchmark can add up.
+inline std::size_t weight(int v) { return static_cast<std::size_t>(v); }
+inline std::size_t weight(const std::string& v) { return v.size(); }
+inline std::size_t weight(const pod64& v) { return v.fields[0]; }
+
+/// A container with `n` values.
+template <typename C>
+C make_filled(std::size_t n) {
+  C c;
+  c.reserve(n);
+  for (std::size_t i{0}; i < n; ++i) c.push_back(make_value<typename C::value_type>(i));
+  return c;
+}
+
+//=== The benchmarks. Each one is written once, for any vector-like container C.
+
+template <typename C>
+void push_back_growth(bench::state& st) {
+  auto value = make_value<typename C::value_type>(42);
+  for (auto _ : st) {
+    C c;
+    for (std::size_t i{0}; i < st.range(); ++i) c.push_back(value);
+    bench::do_not_optimize(c.data());
+  }
+}
+
+template <typename C>
+void emplace_back_growth(bench::state& st) {
+  for (auto _ : st) {
+    C c;
+    for (std::size_t i{0}; i < st.range(); ++i) c.emplace_back(make_value<typename C::value_type>(i));
+    bench::do_not_optimize(c.data());
+  }
+}
+
+template <typename C>
+void reserve_fill(bench::state& st) {
+  auto value = make_value<typename C::value_type>(42);
+  for (auto _ : st) {
+    C c;
+    c.reserve(st.range());
+    for (std::size_t i{0}; i < st.range(); ++i) c.push_back(value);
+    bench::do_not_optimize(c.data());
+  }
+}
+
+template <typename C>
+void insert_front(bench::state& st) {
+  auto value = make_value<typename C::value_type>(42);
+  for (auto _ : st) {
+    C c;
+    for (std::size_t i{0}; i < st.range(); ++i) c.insert(c.begin(), value);
+    bench::do_not_optimize(c.data());
+  }
+}
+
+template <typename C>
+void insert_middle(bench::state& st) {
+  auto value = make_value<typename C::value_type>(42);
+  for (auto _ : st) {
+    C c;
+    for (std::size_t i{0}; i < st.range(); ++i) c.insert(c.begin() + c.size() / 2, value);
+    bench::do_not_optimize(c.data());
+  }
+}
+
+template <typename C>
+void erase_front(bench::state& st) {
+  C src = make_filled<C>(st.range());
+  for (auto _ : st) {
+    st.pause_timing();
+    C c{src};
+    st.resume_timing();
+    while (!c.empty()) c.erase(c.begin());
+    bench::do_not_optimize(c.data());
+  }
+}
+
+template <typename C>
+void erase_middle(bench::state& st) {
+  C src = make_filled<C>(st.range());
+  for (auto _ : st) {
+    st.pause_timing();
+    C c{src};
+    st.resume_timing();
+    while (!c.empty()) c.erase(c.begin() + c.size() / 2);
+    bench::do_not_optimize(c.data());
+  }
+}
+
+template <typename C>
+void range_assign(bench::state& st) {
+  C src = make_filled<C>(st.range());
+  C c;
+  for (auto _ : st) {
+    c.assign(src.begin(), src.end());
+    bench::do_not_optimize(c.data());
+    bench::clobber_memory();
+  }
+}
+
+template <typename C>
+void copy_construct(bench::state& st) {
+  C src = make_filled<C>(st.range());
+  for (auto _ : st) {
+    C c{src};
+    bench::do_not_optimize(c.data());
+  }
+}
+
+template <typename C>
+void move_roundtrip(bench::state& st) {
+  C a = make_filled<C>(st.range());
+  for (auto _ : st) {
+    C b{std::move(a)};
+    a = std::move(b);
+    bench::do_not_optimize(a.data());
+  }
+}
+
+template <typename C>
+void iterate(bench::state& st) {
+  C c = make_filled<C>(st.range());
+  for (auto _ : st) {
+    std::size_t sum{0};
+    for (auto it = c.begin(); it != c.end(); ++it) sum += weight(*it);
+    bench::do_not_optimize(sum);
+  }
+}
+
+template <typename C>
+void equal_compare(bench::state& st) {
+  C a = make_filled<C>(st.range());
+  C b = make_filled<C>(st.range());
+  for (auto _ : st) {
+    bool same = a == b;
+    bench::do_not_optimize(same);
+    bench::clobber_memory();
+  }
+}
+
+template <typename C>
+void fill_assign(bench::state& st) {
+  auto value = make_value<typename C::value_type>(42);
+  C c;
+  for (auto _ : st) {
+    c.assign(st.range(), value);
+    bench::do_not_optimize(c.data());
+    bench::clobber_memory();
+  }
+}
+
+/// Deep copy of a big table: std::vector copies on one thread, sc::vector on all of them.
+template <typename T>
+void copy_into(std::vector<T>& dst, const std::vector<T>& src) { dst = src; }
+template <typename T>
+void copy_into(sc::vector<T>& dst, const sc::vector<T>& src) { dst.parallel_copy_from(src); }
+
+template <typename C>
+void parallel_copy(bench::state& st) {
+  C src = make_filled<C>(st.range());
+  for (auto _ : st) {
+    C c;
+    copy_into(c, src);
+    bench::do_not_optimize(c.data());
+  }
+}
+
+//=== Registration
+
+/// Registers `Bench<sc::vector<T>>` and `Bench<std::vector<T>>` for every size given.
+#define BENCH_PAIR(Bench, T, ...)                                                                 \
+  for (std::size_t n : { __VA_ARGS__ }) {                                                         \
+    bench::registry().push_back({ #Bench, #T, "sc::vector", n, Bench<sc::vector<T>> });          \
+    bench::registry().push_back({ #Bench, #T, "std::vector", n, Bench<std::vector<T>> });        \
+  }
+
+/// Registers every benchmark for element type `T`.
+#define BENCH_ALL(T)                                                                              \
+  BENCH_PAIR(push_back_growth, T, 1'000, 100'000)                                                 \
+  BENCH_PAIR(emplace_back_growth, T, 1'000, 100'000)                                              \
+  BENCH_PAIR(reserve_fill, T, 1'000, 100'000)                                                     \
+  BENCH_PAIR(insert_front, T, 1'000, 10'000)                                                      \
+  BENCH_PAIR(insert_middle, T, 1'000, 10'000)                                                     \
+  BENCH_PAIR(erase_front, T, 1'000, 10'000)                                                       \
+  BENCH_PAIR(erase_middle, T, 1'000, 10'000)                                                      \
+  BENCH_PAIR(range_assign, T, 1'000, 100'000)                                                     \
+  BENCH_PAIR(copy_construct, T, 1'000, 100'000)                                                   \
+  BENCH_PAIR(move_roundtrip, T, 1'000)                                                            \
+  BENCH_PAIR(iterate, T, 1'000, 100'000)                                                          \
+  BENCH_PAIR(equal_compare, T, 1'000, 100'000)                                                    \
+  BENCH_PAIR(fill_assign, T, 1'000, 100'000)
+
+int main(int argc, char* argv[]) {
+  BENCH_ALL(int)
+  BENCH_ALL(std::string)
+  BENCH_ALL(pod64)
+  BENCH_PAIR(parallel_copy, int, 10'000'000)
+  BENCH_PAIR(parallel_copy, std::string, 1'000'000)
+  return bench::run(argc, argv);
+}
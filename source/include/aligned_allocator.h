@@ -0,0 +1,95 @@
+#ifndef _ALIGNED_ALLOCATOR_H_
+#define _ALIGNED_ALLOCATOR_H_
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uintptr_t
+#include <new>          // ::operator new(std::align_val_t)
+#include <type_traits>  // std::true_type
+
+#include "vector.h"
+
+/// Sequence container namespace.
+namespace sc {
+
+/// The result of `allocate_at_least`: the memory and how many objects it really holds.
+template <typename Pointer>
+struct allocation_result {
+  Pointer ptr;
+  std::size_t count;
+};
+
+/// Standard allocator whose memory starts on an `Align`-byte boundary and spans whole `Align`-byte lines.
+/*!
+ * Every allocation is rounded up to a multiple of `Align` bytes, so the buffer never shares its
+ * first or last cache line with other data, and a kernel may load full `Align`-byte vectors up to
+ * the end of the last line. `allocate_at_least` reports the rounded-up element count, which
+ * `sc::vector` takes as its capacity: the padding is usable room, not waste.
+ *
+ * The allocator is stateless, so copies of a vector (and its reallocations) keep the alignment.
+ *
+ * \tparam T The type of the allocated objects.
+ * \tparam Align The alignment in bytes: a power of two, at least `alignof(T)`.
+ */
+template <typename T, std::size_t Align = 64>
+class aligned_allocator {
+  static_assert(Align > 0 && (Align & (Align - 1)) == 0, "Align must be a power of two");
+  static_assert(Align >= alignof(T), "Align cannot be weaker than alignof(T)");
+
+ public:
+  using value_type = T;
+  using is_always_equal = std::true_type;
+  static constexpr std::size_t alignment = Align;
+
+  template <typename U>
+  struct rebind {
+    using other = aligned_allocator<U, Align>;
+  };
+
+  aligned_allocator(void) noexcept = default;
+
+  /// Rebinding constructor.
+  template <typename U>
+  aligned_allocator(const aligned_allocator<U, Align>&) noexcept { /* empty */ }
+
+  T* allocate(std::size_t n) { return allocate_at_least(n).ptr; }
+
+  //Returns room for at least `n` objects: as many as fit in whole `Align`-byte lines.
+  allocation_result<T*> allocate_at_least(std::size_t n) {
+    std::size_t bytes = padded_bytes(n);
+    void* p = ::operator new(bytes, std::align_val_t{Align});
+    return {static_cast<T*>(p), bytes / sizeof(T)};
+  }
+
+  //`n` is the count asked for, or the one returned by `allocate_at_least`.
+  void deallocate(T* p, std::size_t n) noexcept {
+    ::operator delete(static_cast<void*>(p), padded_bytes(n), std::align_val_t{Align});
+  }
+
+  template <typename U>
+  friend bool operator==(const aligned_allocator&, const aligned_allocator<U, Align>&) noexcept { return true; }
+  template <typename U>
+  friend bool operator!=(const aligned_allocator&, const aligned_allocator<U, Align>&) noexcept { return false; }
+
+ private:
+  static std::size_t padded_bytes(std::size_t n) { return (n * sizeof(T) + Align - 1) / Align * Align; }
+};
+
+/// A vector whose `data()` is always `Align`-byte aligned (after `reserve`, `shrink_to_fit`, copies...).
+template <typename T, std::size_t Align = 64>
+using aligned_vector = vector<T, aligned_allocator<T, Align>>;
+
+/// Tells the compiler that `p` is `Align`-byte aligned, so it may use aligned loads and stores.
+template <std::size_t Align, typename T>
+T* assume_aligned(T* p) noexcept {
+  return static_cast<T*>(__builtin_assume_aligned(p, Align));
+}
+
+/// Whether `p` lies on an `Align`-byte boundary.
+template <std::size_t Align, typename T>
+bool is_aligned(const T* p) noexcept {
+  return reinterpret_cast<std::uintptr_t>(p) % Align == 0;
+}
+
+} // namespace sc.
+
+#endif
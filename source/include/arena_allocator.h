@@ -0,0 +1,164 @@
+#ifndef _ARENA_ALLOCATOR_H_
+#define _ARENA_ALLOCATOR_H_
+
+#include <cstddef>      // std::size_t, std::max_align_t
+#include <cstdint>      // std::uintptr_t
+#include <new>          // ::operator new, std::bad_alloc
+#include <type_traits>  // std::true_type, std::false_type
+
+/// Sequence container namespace.
+namespace sc {
+
+/// A monotonic memory resource: hands out memory by bumping a pointer inside big blocks.
+/*!
+ * Individual deallocations are no-ops; all the memory is given back at once by `reset()`
+ * (which keeps the blocks for reuse) or by the destructor. This fits request-scoped work where
+ * many short-lived containers are created and thrown away together.
+ *
+ * An arena is neither copyable nor movable, since allocators keep a pointer to it.
+ */
+class arena {
+ public:
+  /// Creates an arena whose blocks hold at least `block_size` bytes each.
+  explicit arena(std::size_t block_size = 64 * 1024) : m_block_size{block_size} { /* empty */ }
+
+  arena(const arena&) = delete;
+  arena& operator=(const arena&) = delete;
+
+  /// Frees every block.
+  ~arena(void) {
+    release(m_head);
+    release(m_free);
+  }
+
+  /// Returns `bytes` bytes aligned to `align` (a power of two).
+  void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t)) {
+    std::uintptr_t aligned = align_up(m_cursor, align);
+    if (m_head == nullptr || aligned + bytes > m_limit) {
+      new_block(bytes + align);
+      aligned = align_up(m_cursor, align);
+    }
+    m_cursor = aligned + bytes;
+    m_used += bytes;
+    return reinterpret_cast<void*>(aligned);
+  }
+
+  /// Individual deallocation does nothing: memory comes back on `reset()`.
+  void deallocate(void*, std::size_t) noexcept { /* empty */ }
+
+  /// Makes all the memory handed out so far available again, in O(#blocks).
+  /*!
+   * Every object allocated from the arena must be dead (or never touched again) by now.
+   */
+  void reset(void) noexcept {
+    // Keep the blocks in a free list, so the next round of allocations does not hit the heap.
+    while (m_head != nullptr) {
+      block* next = m_head->next;
+      m_head->next = m_free;
+      m_free = m_head;
+      m_head = next;
+    }
+    m_cursor = m_limit = 0;
+    m_used = 0;
+  }
+
+  /// Number of bytes handed out since construction or the last `reset()`.
+  std::size_t bytes_used(void) const noexcept { return m_used; }
+
+ private:
+  /// Header placed at the beginning of every block.
+  struct block {
+    block* next;        //!< The next block in the list.
+    std::size_t size;   //!< Usable bytes after this header.
+  };
+
+  static std::uintptr_t align_up(std::uintptr_t p, std::size_t align) {
+    return (p + align - 1) & ~static_cast<std::uintptr_t>(align - 1);
+  }
+
+  /// Makes a block with at least `min_bytes` usable bytes the current one.
+  void new_block(std::size_t min_bytes) {
+    block* b{nullptr};
+    // Recycle a block kept by `reset()`, if it is big enough.
+    if (m_free != nullptr && m_free->size >= min_bytes) {
+      b = m_free;
+      m_free = m_free->next;
+    }
+    else {
+      std::size_t size = min_bytes > m_block_size ? min_bytes : m_block_size;
+      b = static_cast<block*>(::operator new(sizeof(block) + size));
+      b->size = size;
+    }
+    b->next = m_head;
+    m_head = b;
+    m_cursor = reinterpret_cast<std::uintptr_t>(b + 1);
+    m_limit = m_cursor + b->size;
+  }
+
+  static void release(block* b) noexcept {
+    while (b != nullptr) {
+      block* next = b->next;
+      ::operator delete(b);
+      b = next;
+    }
+  }
+
+  std::size_t m_block_size;     //!< Minimum size of a new block.
+  block* m_head{nullptr};       //!< Blocks in use; the first one is being carved.
+  block* m_free{nullptr};       //!< Blocks released by `reset()`, ready for reuse.
+  std::uintptr_t m_cursor{0};   //!< Next free byte in the current block.
+  std::uintptr_t m_limit{0};    //!< One past the last byte of the current block.
+  std::size_t m_used{0};        //!< Bytes handed out.
+};
+
+/// Standard allocator that takes its memory from an `sc::arena`.
+/*!
+ * Two `arena_allocator`s are equal when they use the same arena. The allocator does not
+ * propagate on copy, move or swap, so containers never adopt memory from another arena.
+ *
+ *     sc::arena a;
+ *     sc::vector<int, sc::arena_allocator<int>> vec{ sc::arena_allocator<int>{a} };
+ *
+ * \tparam T The type of the allocated objects.
+ */
+template <typename T>
+class arena_allocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+  using is_always_equal = std::false_type;
+
+  /// Creates an allocator drawing from `a`, which must outlive it.
+  arena_allocator(arena& a) noexcept : m_arena{&a} { /* empty */ }
+
+  /// Rebinding constructor.
+  template <typename U>
+  arena_allocator(const arena_allocator<U>& other) noexcept : m_arena{other.get_arena()} { /* empty */ }
+
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept { m_arena->deallocate(p, n * sizeof(T)); }
+
+  /// Returns the arena this allocator draws from.
+  arena* get_arena(void) const noexcept { return m_arena; }
+
+  template <typename U>
+  friend bool operator==(const arena_allocator& a, const arena_allocator<U>& b) noexcept {
+    return a.get_arena() == b.get_arena();
+  }
+  template <typename U>
+  friend bool operator!=(const arena_allocator& a, const arena_allocator<U>& b) noexcept {
+    return a.get_arena() != b.get_arena();
+  }
+
+ private:
+  arena* m_arena; //!< Where the memory comes from.
+};
+
+} // namespace sc.
+
+#endif
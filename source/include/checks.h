@@ -0,0 +1,88 @@
+#ifndef _CHECKS_H_
+#define _CHECKS_H_
+
+#include <cassert>      // assert()
+#include <stdexcept>    // std::out_of_range, std::logic_error
+
+// How much sc::vector validates is chosen at build time with SC_VECTOR_CHECKS (the same value in
+// every translation unit of a program: the iterator layout depends on it):
+//
+//   -DSC_VECTOR_CHECKS=none      Nothing: a bad position, front() on an empty vector or a stale
+//                                iterator is undefined behavior. For release builds of hot loops.
+//   -DSC_VECTOR_CHECKS=assert    Each precondition is an assert(), gone only with NDEBUG.
+//   -DSC_VECTOR_CHECKS=checked   The default: insert/erase positions and front()/back() on an
+//                                empty vector throw std::out_of_range; iterators assert.
+//   -DSC_VECTOR_CHECKS=hardened  `checked`, plus bounds-checked operator[], and iterators that throw
+//                                std::logic_error when used after their vector gave up its buffer
+//                                (a reserve(), a growing insertion, shrink_to_fit(), ...).
+//
+// `at()` throws std::out_of_range in every mode: checking is what it is for.
+#define SC_VECTOR_CHECKS_none 1
+#define SC_VECTOR_CHECKS_assert 2
+#define SC_VECTOR_CHECKS_checked 3
+#define SC_VECTOR_CHECKS_hardened 4
+
+#ifndef SC_VECTOR_CHECKS
+#define SC_VECTOR_CHECKS checked
+#endif
+
+#define SC_VECTOR_CHECKS_CAT_(a, b) a##b
+#define SC_VECTOR_CHECKS_CAT(a, b) SC_VECTOR_CHECKS_CAT_(a, b)
+/// The selected mode, as one of the SC_VECTOR_CHECKS_* numbers above.
+#define SC_VECTOR_CHECK_LEVEL SC_VECTOR_CHECKS_CAT(SC_VECTOR_CHECKS_, SC_VECTOR_CHECKS)
+
+#if !SC_VECTOR_CHECK_LEVEL
+#error "SC_VECTOR_CHECKS must be none, assert, checked or hardened"
+#endif
+
+// Keeps the code that builds and throws an exception out of the callers' hot paths.
+#if defined(__GNUC__)
+#define SC_VECTOR_COLD __attribute__((cold, noinline))
+#else
+#define SC_VECTOR_COLD
+#endif
+
+/// Sequence container namespace.
+namespace sc {
+
+/// The checking modes of SC_VECTOR_CHECKS, weakest first.
+enum class check_level { none = SC_VECTOR_CHECKS_none, assertions = SC_VECTOR_CHECKS_assert,
+                         checked = SC_VECTOR_CHECKS_checked, hardened = SC_VECTOR_CHECKS_hardened };
+
+/// The mode this program is built with.
+inline constexpr check_level vector_checks = static_cast<check_level>(SC_VECTOR_CHECK_LEVEL);
+
+namespace detail {
+
+[[noreturn]] SC_VECTOR_COLD inline void throw_out_of_range(const char* what) { throw std::out_of_range{what}; }
+[[noreturn]] SC_VECTOR_COLD inline void throw_logic_error(const char* what) { throw std::logic_error{what}; }
+
+/// A precondition of a container operation (a valid position, a non-empty vector, ...).
+/*!
+ * Ignored with `none`, asserted with `assert`, and a `std::out_of_range` from `checked` on.
+ */
+constexpr void check(bool ok, const char* what) {
+  (void)ok;
+  (void)what;
+#if SC_VECTOR_CHECK_LEVEL == SC_VECTOR_CHECKS_assert
+  assert(ok && what);
+#elif SC_VECTOR_CHECK_LEVEL >= SC_VECTOR_CHECKS_checked
+  if (!ok) throw_out_of_range(what);
+#endif
+}
+
+/// A precondition of an iterator operation: asserted by `assert` and `checked`, thrown when hardened.
+constexpr void check_iterator(bool ok, const char* what) {
+  (void)ok;
+  (void)what;
+#if SC_VECTOR_CHECK_LEVEL == SC_VECTOR_CHECKS_assert || SC_VECTOR_CHECK_LEVEL == SC_VECTOR_CHECKS_checked
+  assert(ok && what);
+#elif SC_VECTOR_CHECK_LEVEL == SC_VECTOR_CHECKS_hardened
+  if (!ok) throw_logic_error(what);
+#endif
+}
+
+} // namespace detail.
+} // namespace sc.
+
+#endif
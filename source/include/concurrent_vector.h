@@ -0,0 +1,287 @@
+#ifndef _CONCURRENT_VECTOR_H_
+#define _CONCURRENT_VECTOR_H_
+
+#include <algorithm>    // std::max
+#include <atomic>       // std::atomic
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <initializer_list> // std::initializer_list
+#include <memory>       // std::destroy_at
+#include <new>          // ::operator new(std::align_val_t)
+#include <stdexcept>    // std::out_of_range
+#include <utility>      // std::forward, std::move, std::swap
+
+#include "index_iterator.h" // sc::index_iterator
+
+/// Sequence container namespace.
+namespace sc {
+
+/// A vector that many threads may append to at once, and whose elements never move.
+/*!
+ * The elements live in segments of power-of-two sizes (8, 16, 32, ...): segment `k` holds the
+ * indices `[8 * (2^k - 1), 8 * (2^(k+1) - 1))`. An append claims its indices with one atomic
+ * `fetch_add` on the size, allocates the segment behind them if no other thread did it first
+ * (a compare-and-swap decides), and constructs the elements in place. Segments are never moved
+ * or freed while the vector lives, so references, pointers and indices stay valid and a read is
+ * two loads, with no lock.
+ *
+ *     sc::concurrent_vector<event> log;
+ *     // From any thread:
+ *     auto idx = log.push_back(e);
+ *     use(log[idx]);
+ *
+ * `size()` counts the claimed indices, some of which another thread may still be constructing:
+ * read an element only once the thread that appended it has handed its index over (or call
+ * `ready(idx)`). Appends, `reserve` and reads are thread-safe; `clear`, copies, assignments and
+ * `swap` are not and need the vector to themselves.
+ */
+template <typename T>
+class concurrent_vector {
+ public:
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+
+  using iterator = index_iterator<concurrent_vector, T>;  //!< Stays valid while the vector grows.
+  using const_iterator = index_iterator<const concurrent_vector, const T>;
+
+  // [I] Special members
+  concurrent_vector(void) = default;
+
+  concurrent_vector(std::initializer_list<T> il) {
+    try { for (const auto& value : il) push_back(value); }
+    catch (...) { release(); throw; }
+  }
+
+  //Copies the elements at the same indices; a slot of `other` not constructed is broken in the copy.
+  concurrent_vector(const concurrent_vector& other) {
+    try {
+      size_type count = other.size();
+      reserve(count);
+      for (size_type i{0}; i < count; ++i) {
+        if (other.ready(i)) construct(i, other[i]);
+        else state(i).store(broken, std::memory_order_relaxed);
+        m_size.store(i + 1, std::memory_order_relaxed);
+      }
+    }
+    catch (...) { release(); throw; }
+  }
+
+  concurrent_vector(concurrent_vector&& other) noexcept { swap(other); }
+
+  concurrent_vector& operator=(concurrent_vector other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~concurrent_vector(void) { release(); }
+
+  void swap(concurrent_vector& other) noexcept {
+    for (size_type k{0}; k < max_segments; ++k) {
+      unsigned char* mine = m_segments[k].load(std::memory_order_relaxed);
+      m_segments[k].store(other.m_segments[k].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      other.m_segments[k].store(mine, std::memory_order_relaxed);
+    }
+    size_type mine = m_size.load(std::memory_order_relaxed);
+    m_size.store(other.m_size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    other.m_size.store(mine, std::memory_order_relaxed);
+  }
+  friend void swap(concurrent_vector& a, concurrent_vector& b) noexcept { a.swap(b); }
+
+  // [II] Iterators
+  iterator begin(void) { return iterator{this, 0}; }
+  iterator end(void) { return iterator{this, size()}; }
+  const_iterator begin(void) const { return cbegin(); }
+  const_iterator end(void) const { return cend(); }
+  const_iterator cbegin(void) const { return const_iterator{this, 0}; }
+  const_iterator cend(void) const { return const_iterator{this, size()}; }
+
+  // [III] Capacity
+  //The number of claimed indices (including elements still being constructed).
+  size_type size(void) const { return m_size.load(std::memory_order_acquire); }
+  bool empty(void) const { return size() == 0; }
+
+  //The number of slots in the segments allocated so far.
+  size_type capacity(void) const {
+    size_type total{0};
+    for (size_type k{0}; k < max_segments; ++k)
+      if (m_segments[k].load(std::memory_order_acquire) != nullptr) total += segment_size(k);
+    return total;
+  }
+
+  //Allocates the segments for the indices [0, new_cap). Thread-safe.
+  void reserve(size_type new_cap) {
+    if (new_cap == 0) return;
+    for (size_type k{0}; k <= segment_of(new_cap - 1); ++k) segment(k);
+  }
+
+  // [IV] Modifiers
+  //Appends a copy of `value`; returns its index. Thread-safe.
+  size_type push_back(const T& value) { return emplace_back(value); }
+  size_type push_back(T&& value) { return emplace_back(std::move(value)); }
+
+  //Appends an element built from `args`; returns its index. Thread-safe.
+  template <typename... Args>
+  size_type emplace_back(Args&&... args) {
+    size_type idx = m_size.fetch_add(1, std::memory_order_acq_rel);
+    construct(idx, std::forward<Args>(args)...);
+    return idx;
+  }
+
+  //Appends `count` value-initialized elements at consecutive indices; returns the first one. Thread-safe.
+  size_type grow_by(size_type count) {
+    size_type first = m_size.fetch_add(count, std::memory_order_acq_rel);
+    build_range(first, count, [](T* slot) { ::new (static_cast<void*>(slot)) T(); });
+    return first;
+  }
+
+  //Appends `count` copies of `value` at consecutive indices; returns the first one. Thread-safe.
+  size_type grow_by(size_type count, const T& value) {
+    size_type first = m_size.fetch_add(count, std::memory_order_acq_rel);
+    build_range(first, count, [&](T* slot) { ::new (static_cast<void*>(slot)) T(value); });
+    return first;
+  }
+
+  //Destroys every element, keeping the segments. Not thread-safe.
+  void clear(void) {
+    size_type count = m_size.load(std::memory_order_relaxed);
+    for (size_type k{0}; k < max_segments; ++k) {
+      if (segment_if_any(k) == nullptr) continue; // Its indices were claimed, but never allocated.
+      for (size_type i{segment_base(k)}; i < std::min(count, segment_base(k) + segment_size(k)); ++i) {
+        auto& st = state(i);
+        if (st.load(std::memory_order_relaxed) == constructed) std::destroy_at(slot(i));
+        st.store(empty_slot, std::memory_order_relaxed);
+      }
+    }
+    m_size.store(0, std::memory_order_relaxed);
+  }
+
+  // [V] Element access
+  //Wait-free: `idx` must be an element whose construction has finished.
+  reference operator[](size_type idx) { return *slot(idx); }
+  const_reference operator[](size_type idx) const { return *slot(idx); }
+
+  //Whether element `idx` has been constructed (and may be read).
+  bool ready(size_type idx) const {
+    return idx < size() && segment_if_any(segment_of(idx)) != nullptr &&
+           state(idx).load(std::memory_order_acquire) == constructed;
+  }
+
+  reference at(size_type idx) {
+    if (!ready(idx)) throw std::out_of_range{"The method 'at' cannot access this index"};
+    return *slot(idx);
+  }
+  const_reference at(size_type idx) const {
+    if (!ready(idx)) throw std::out_of_range{"The method 'at' cannot access this index"};
+    return *slot(idx);
+  }
+
+  reference front(void) { return at(0); }
+  const_reference front(void) const { return at(0); }
+  reference back(void) { return at(size() - 1); }
+  const_reference back(void) const { return at(size() - 1); }
+
+ private:
+  static constexpr size_type first_log = 3;                      //!< Segment 0 holds 2^3 elements.
+  static constexpr size_type max_segments = 64 - first_log;      //!< Enough for any size_type index.
+
+  /// The states of a slot: raw memory, a live element, or a construction that threw.
+  enum : unsigned char { empty_slot = 0, constructed = 1, broken = 2 };
+  using slot_state = std::atomic<unsigned char>;
+
+  static size_type segment_size(size_type k) { return size_type{1} << (k + first_log); }
+  static size_type segment_of(size_type idx) {
+    return (63 - static_cast<size_type>(__builtin_clzll((idx >> first_log) + 1)));
+  }
+  static size_type segment_base(size_type k) { return segment_size(k) - (size_type{1} << first_log); }
+
+  /// A segment block is its slot states, then (aligned) its slots.
+  static size_type slots_offset(size_type k) {
+    return (segment_size(k) * sizeof(slot_state) + alignof(T) - 1) / alignof(T) * alignof(T);
+  }
+  static constexpr std::align_val_t block_alignment{std::max(alignof(T), alignof(slot_state))};
+
+  /// Segment `k`, allocating it if no thread has yet; the first compare-and-swap wins.
+  unsigned char* segment(size_type k) {
+    unsigned char* block = m_segments[k].load(std::memory_order_acquire);
+    if (block != nullptr) return block;
+    unsigned char* fresh = allocate_segment(k);
+    if (m_segments[k].compare_exchange_strong(block, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+      return fresh;
+    free_segment(fresh, k); // Another thread got there first: `block` holds its segment.
+    return block;
+  }
+  unsigned char* segment_if_any(size_type k) const { return m_segments[k].load(std::memory_order_acquire); }
+
+  static unsigned char* allocate_segment(size_type k) {
+    size_type n = segment_size(k);
+    auto* block = static_cast<unsigned char*>(::operator new(slots_offset(k) + n * sizeof(T), block_alignment));
+    for (size_type i{0}; i < n; ++i) ::new (static_cast<void*>(block + i * sizeof(slot_state))) slot_state(empty_slot);
+    return block;
+  }
+  static void free_segment(unsigned char* block, size_type k) {
+    ::operator delete(block, slots_offset(k) + segment_size(k) * sizeof(T), block_alignment);
+  }
+
+  T* slot(size_type idx) const {
+    size_type k = segment_of(idx);
+    return reinterpret_cast<T*>(m_segments[k].load(std::memory_order_acquire) + slots_offset(k)) +
+           (idx - segment_base(k));
+  }
+  slot_state& state(size_type idx) const {
+    size_type k = segment_of(idx);
+    return reinterpret_cast<slot_state*>(m_segments[k].load(std::memory_order_acquire))[idx - segment_base(k)];
+  }
+
+  /// Constructs the element at the claimed index `idx`; a throwing constructor marks the slot broken.
+  template <typename... Args>
+  void construct(size_type idx, Args&&... args) {
+    segment(segment_of(idx));
+    try { ::new (static_cast<void*>(slot(idx))) T(std::forward<Args>(args)...); }
+    catch (...) {
+      state(idx).store(broken, std::memory_order_release);
+      throw;
+    }
+    state(idx).store(constructed, std::memory_order_release);
+  }
+
+  /// Builds the claimed indices [first, first + count); if one throws, it and the rest are broken.
+  template <typename Build>
+  void build_range(size_type first, size_type count, Build build) {
+    if (count == 0) return;
+    for (size_type k{segment_of(first)}; k <= segment_of(first + count - 1); ++k) segment(k);
+    size_type i{first};
+    try {
+      for (; i < first + count; ++i) {
+        build(slot(i));
+        state(i).store(constructed, std::memory_order_release);
+      }
+    }
+    catch (...) {
+      for (; i < first + count; ++i) state(i).store(broken, std::memory_order_release);
+      throw;
+    }
+  }
+
+  /// Destroys the elements and frees the segments.
+  void release(void) {
+    size_type count = m_size.load(std::memory_order_relaxed);
+    for (size_type k{0}; k < max_segments; ++k) {
+      unsigned char* block = m_segments[k].load(std::memory_order_relaxed);
+      if (block == nullptr) continue;
+      for (size_type i{segment_base(k)}; i < std::min(count, segment_base(k) + segment_size(k)); ++i)
+        if (state(i).load(std::memory_order_relaxed) == constructed) std::destroy_at(slot(i));
+      free_segment(block, k);
+      m_segments[k].store(nullptr, std::memory_order_relaxed);
+    }
+    m_size.store(0, std::memory_order_relaxed);
+  }
+
+  std::atomic<unsigned char*> m_segments[max_segments] = {}; //!< Segment k, or nullptr until it is needed.
+  std::atomic<size_type> m_size{0};                         //!< The number of claimed indices.
+};
+
+} // namespace sc.
+
+#endif
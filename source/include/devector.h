@@ -0,0 +1,499 @@
+#ifndef _DEVECTOR_H_
+#define _DEVECTOR_H_
+
+#include <exception>    // std::out_of_range
+#include <iostream>     // std::ostream
+#include <memory>       // std::allocator_traits, std::uninitialized_copy, std::destroy
+#include <new>          // placement new
+#include <iterator>     // std::distance, std::make_move_iterator
+#include <algorithm>    // std::move, std::move_backward, std::equal
+#include <initializer_list> // std::initializer_list
+#include <cassert>      // assert()
+#include <cstddef>      // std::size_t
+#include <cstring>      // std::memcpy, std::memmove
+#include <type_traits>  // std::is_nothrow_move_constructible_v
+#include <utility>      // std::move, std::forward, std::swap
+
+#include "vector.h"     // sc::MyForwardIterator, sc::is_trivially_relocatable, sc::is_forward_iterator_v
+#include "growth_policy.h"
+
+/// Sequence container namespace.
+namespace sc {
+
+/// A double-ended vector: contiguous storage with spare capacity at both ends.
+/*!
+ * The live elements occupy `[m_begin, m_end)` inside a buffer of `m_capacity` slots, so
+ * `push_front`/`pop_front` are amortized O(1), just like `push_back`/`pop_back`. This fits
+ * queues and sliding windows. The elements stay contiguous and `data()` points to the
+ * first one, as with `sc::vector`.
+ *
+ * When one end runs out of room and the buffer is at most half full, the elements are
+ * re-centered in place; otherwise the buffer grows (as the growth policy says) and the
+ * elements land in the middle of the new one. Either way both ends get Θ(n) free slots,
+ * which pays for the O(n) move. Insertions and erasures in the middle shift the shorter side.
+ *
+ * \tparam T The type of the elements.
+ * \tparam Allocator Provides the storage, through `std::allocator_traits`.
+ * \tparam GrowthPolicy Picks the new capacity when the buffer is too small (see growth_policy.h).
+ */
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = doubling_growth>
+class devector {
+  //=== Aliases
+ public:
+  using size_type = unsigned long;  //!< The size type.
+  using value_type = T;             //!< The value type.
+  using allocator_type = Allocator; //!< The allocator type.
+  using growth_policy = GrowthPolicy; //!< The growth policy type.
+  using pointer = value_type*;  //!< Pointer to a value stored in the container.
+  using reference = value_type&;  //!< Reference to a value stored in the container.
+  using const_reference = const value_type&; //!< Const reference to a value stored in the container.
+  using iterator = MyForwardIterator<value_type>; //!< The iterator.
+  using const_iterator = MyForwardIterator<const value_type>; //!< The const_iterator.
+
+ private:
+  using alloc_traits = std::allocator_traits<Allocator>;
+  static_assert(std::is_same_v<typename alloc_traits::value_type, T>, "Allocator::value_type must be T");
+  static_assert(std::is_same_v<typename alloc_traits::pointer, T*>, "fancy pointers are not supported");
+
+  //=== Methods
+ public:
+  //=== [I] SPECIAL MEMBERS
+
+  /// Creates an empty devector; nothing is allocated.
+  explicit devector(const Allocator& alloc = Allocator()) noexcept : m_alloc{alloc} { /* empty */ }
+
+  /// Creates a devector with `count` value-initialized elements.
+  explicit devector(size_type count, const Allocator& alloc = Allocator()) : m_alloc{alloc} {
+    m_storage = allocate(count);
+    try { std::uninitialized_value_construct_n(m_storage, count); }
+    catch (...) { deallocate(m_storage, count); throw; }
+    m_capacity = m_end = count;
+  }
+
+  devector(const std::initializer_list<T>& il, const Allocator& alloc = Allocator())
+    : devector(il.begin(), il.end(), alloc) { /* empty */ }
+
+  /// Range constructor.
+  /*!
+   * Forward ranges are measured first and take a single allocation; single-pass input ranges
+   * (e.g. `std::istream_iterator`) are appended one by one.
+   */
+  template <typename InputItr, typename = require_input_iterator<InputItr>>
+  devector(InputItr first, InputItr last, const Allocator& alloc = Allocator()) : m_alloc{alloc} {
+    if constexpr (is_forward_iterator_v<InputItr>) {
+      size_type count = std::distance(first, last);
+      m_storage = allocate(count);
+      try { std::uninitialized_copy(first, last, m_storage); }
+      catch (...) { deallocate(m_storage, count); throw; }
+      m_capacity = m_end = count;
+    }
+    else {
+      try { for (; first != last; ++first) emplace_back(*first); }
+      catch (...) { release(); throw; }
+    }
+  }
+
+  devector(const devector& other)
+    : devector(other.cbegin(), other.cend(),
+               alloc_traits::select_on_container_copy_construction(other.m_alloc)) { /* empty */ }
+
+  /// Steals the buffer of `other`, leaving it empty.
+  devector(devector&& other) noexcept
+    : m_alloc{std::move(other.m_alloc)}, m_storage{other.m_storage}, m_begin{other.m_begin},
+      m_end{other.m_end}, m_capacity{other.m_capacity} {
+    other.m_storage = nullptr;
+    other.m_begin = other.m_end = other.m_capacity = 0;
+  }
+
+  ~devector(void) {
+    std::destroy(m_storage + m_begin, m_storage + m_end);
+    deallocate(m_storage, m_capacity);
+  }
+
+  devector& operator=(const devector& other) {
+    if (this == &other) return *this;
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+      if (m_alloc != other.m_alloc) release();
+      m_alloc = other.m_alloc;
+    }
+    assign_range(other.cbegin(), other.size());
+    return *this;
+  }
+
+  devector& operator=(devector&& other)
+    noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
+    if (this == &other) return *this;
+    if constexpr (!alloc_traits::propagate_on_container_move_assignment::value) {
+      // Storage cannot change hands between unequal allocators.
+      if (m_alloc != other.m_alloc) {
+        assign_range(std::make_move_iterator(other.begin()), other.size());
+        other.clear();
+        return *this;
+      }
+    }
+    release();
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+      m_alloc = std::move(other.m_alloc);
+    m_storage = other.m_storage;
+    m_begin = other.m_begin;
+    m_end = other.m_end;
+    m_capacity = other.m_capacity;
+    other.m_storage = nullptr;
+    other.m_begin = other.m_end = other.m_capacity = 0;
+    return *this;
+  }
+
+  devector& operator=(const std::initializer_list<T>& il) {
+    assign_range(il.begin(), il.size());
+    return *this;
+  }
+
+  /// Returns a copy of the allocator associated with the container.
+  allocator_type get_allocator(void) const { return m_alloc; }
+
+  //=== [II] ITERATORS
+  iterator begin(void) { return iterator(m_storage + m_begin); }
+  iterator end(void) { return iterator(m_storage + m_end); }
+  const_iterator begin(void) const { return cbegin(); }
+  const_iterator end(void) const { return cend(); }
+  const_iterator cbegin(void) const { return const_iterator(m_storage + m_begin); }
+  const_iterator cend(void) const { return const_iterator(m_storage + m_end); }
+
+  //=== [III] CAPACITY
+  size_type size(void) const { return m_end - m_begin; }
+  size_type capacity(void) const { return m_capacity; }
+  bool empty(void) const { return m_end == m_begin; }
+  /// Number of elements that `push_front` may add without moving anything.
+  size_type front_free_capacity(void) const { return m_begin; }
+  /// Number of elements that `push_back` may add without moving anything.
+  size_type back_free_capacity(void) const { return m_capacity - m_end; }
+
+  /// Makes room for `n` elements in total, keeping the front gap as it is.
+  void reserve(size_type n) {
+    if (n > m_capacity - m_begin) reallocate(m_begin + n, m_begin);
+  }
+
+  /// Makes room for `n` elements in total with all the new slots in front.
+  void reserve_front(size_type n) {
+    if (n > m_end) reallocate(n + m_capacity - m_end, n - size());
+  }
+
+  /// Releases the unused capacity at both ends.
+  void shrink_to_fit(void) {
+    if (size() < m_capacity) reallocate(size(), 0);
+  }
+
+  //=== [IV] MODIFIERS
+  void clear(void) {
+    std::destroy(m_storage + m_begin, m_storage + m_end);
+    // Re-center, so both ends have room again.
+    m_begin = m_end = m_capacity / 2;
+  }
+
+  void push_front(const_reference value) { emplace_front(value); }
+  void push_front(value_type&& value) { emplace_front(std::move(value)); }
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(value_type&& value) { emplace_back(std::move(value)); }
+
+  /// Constructs an element in place before the first one, in amortized O(1).
+  template <typename... Args>
+  reference emplace_front(Args&&... args) {
+    if (m_begin == 0) {
+      if (needs_buffer()) {
+        // The new element is built in the new buffer before `args` (which may live in the old one) go away.
+        grow_and_emplace(0, std::forward<Args>(args)...);
+        return front();
+      }
+      recenter();
+    }
+    ::new (static_cast<void*>(m_storage + m_begin - 1)) T(std::forward<Args>(args)...);
+    --m_begin;
+    return front();
+  }
+
+  /// Constructs an element in place after the last one, in amortized O(1).
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    if (m_end == m_capacity) {
+      if (needs_buffer()) {
+        grow_and_emplace(size(), std::forward<Args>(args)...);
+        return back();
+      }
+      recenter();
+    }
+    ::new (static_cast<void*>(m_storage + m_end)) T(std::forward<Args>(args)...);
+    ++m_end;
+    return back();
+  }
+
+  /// Destroys the first element in O(1).
+  void pop_front(void) {
+    std::destroy_at(m_storage + m_begin);
+    ++m_begin;
+  }
+
+  /// Destroys the last element in O(1).
+  void pop_back(void) {
+    --m_end;
+    std::destroy_at(m_storage + m_end);
+  }
+
+  /// Constructs an element before `pos`, shifting the shorter side of the devector.
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    size_type idx = pos - cbegin();
+    if (idx > size()) throw std::out_of_range{ "devector::emplace" };
+    if (idx == 0) { emplace_front(std::forward<Args>(args)...); return begin(); }
+    if (idx == size()) { emplace_back(std::forward<Args>(args)...); return end() - 1; }
+
+    // Built aside: `args` may refer to elements that are about to be shifted.
+    value_type tmp(std::forward<Args>(args)...);
+    bool to_front = idx < size() / 2;
+    if ((to_front && m_begin == 0) || (!to_front && m_end == m_capacity)) {
+      if (m_begin == 0 && m_end == m_capacity) {
+        if (needs_buffer()) { grow_and_emplace(idx, std::move(tmp)); return begin() + idx; }
+        recenter();
+      }
+      else to_front = !to_front;
+    }
+
+    pointer first = m_storage + m_begin;
+    if (to_front) {
+      // Open the hole by sliding [0, idx) one slot to the left.
+      ::new (static_cast<void*>(first - 1)) T(std::move(*first));
+      --m_begin;
+      --first;
+      std::move(first + 2, first + idx + 1, first + 1);
+    }
+    else {
+      // Open the hole by sliding [idx, size) one slot to the right.
+      pointer last = m_storage + m_end;
+      ::new (static_cast<void*>(last)) T(std::move(*(last - 1)));
+      ++m_end;
+      std::move_backward(first + idx, last - 1, last);
+    }
+    first[idx] = std::move(tmp);
+    return begin() + idx;
+  }
+
+  iterator insert(const_iterator pos, const_reference value) { return emplace(pos, value); }
+  iterator insert(const_iterator pos, value_type&& value) { return emplace(pos, std::move(value)); }
+
+  /// Removes the element at `pos`.
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  /// Removes `[first, last)`, shifting the shorter remaining side.
+  iterator erase(const_iterator first, const_iterator last) {
+    if (first < cbegin() || last > cend() || first > last) throw std::out_of_range{ "devector::erase" };
+    size_type idx = first - cbegin();
+    size_type count = last - first;
+    if (count == 0) return begin() + idx;
+    pointer base = m_storage + m_begin;
+    if (idx < size() - idx - count) {
+      // Fewer elements before the range: slide them right.
+      std::move_backward(base, base + idx, base + idx + count);
+      std::destroy(base, base + count);
+      m_begin += count;
+    }
+    else {
+      std::move(base + idx + count, m_storage + m_end, base + idx);
+      std::destroy(m_storage + m_end - count, m_storage + m_end);
+      m_end -= count;
+    }
+    return begin() + idx;
+  }
+
+  //=== [V] ELEMENT ACCESS
+  reference operator[](size_type idx) { return m_storage[m_begin + idx]; }
+  const_reference operator[](size_type idx) const { return m_storage[m_begin + idx]; }
+
+  reference at(size_type idx) {
+    if (idx >= size()) throw std::out_of_range{ "devector::at" };
+    return (*this)[idx];
+  }
+  const_reference at(size_type idx) const {
+    if (idx >= size()) throw std::out_of_range{ "devector::at" };
+    return (*this)[idx];
+  }
+
+  reference front(void) { return m_storage[m_begin]; }
+  const_reference front(void) const { return m_storage[m_begin]; }
+  reference back(void) { return m_storage[m_end - 1]; }
+  const_reference back(void) const { return m_storage[m_end - 1]; }
+
+  /// Pointer to the first element; the elements are contiguous.
+  pointer data(void) { return m_storage + m_begin; }
+  const value_type* data(void) const { return m_storage + m_begin; }
+
+  friend std::ostream& operator<<(std::ostream& os, const devector& dv) {
+    os << "{ ";
+    for (const auto& e : dv) os << e << " ";
+    os << "}, front_free=" << dv.front_free_capacity() << ", back_free=" << dv.back_free_capacity();
+    return os;
+  }
+
+  friend void swap(devector& a, devector& b)
+    noexcept(alloc_traits::propagate_on_container_swap::value || alloc_traits::is_always_equal::value) {
+    using std::swap;
+    if constexpr (alloc_traits::propagate_on_container_swap::value) swap(a.m_alloc, b.m_alloc);
+    else assert(a.m_alloc == b.m_alloc && "swapping devectors with unequal allocators");
+    swap(a.m_storage, b.m_storage);
+    swap(a.m_begin, b.m_begin);
+    swap(a.m_end, b.m_end);
+    swap(a.m_capacity, b.m_capacity);
+  }
+
+ private:
+  pointer allocate(size_type n) { return n == 0 ? nullptr : alloc_traits::allocate(m_alloc, n); }
+
+  void deallocate(pointer p, size_type n) noexcept {
+    if (p != nullptr) alloc_traits::deallocate(m_alloc, p, n);
+  }
+
+  /// Destroys the elements and gives the buffer back.
+  void release(void) noexcept {
+    std::destroy(m_storage + m_begin, m_storage + m_end);
+    deallocate(m_storage, m_capacity);
+    m_storage = nullptr;
+    m_begin = m_end = m_capacity = 0;
+  }
+
+  /// Whether an end that ran out of room needs a new buffer, rather than re-centering.
+  /*!
+   * Re-centering moves every element in place, so it is only worth it (and only done) when
+   * the buffer is at most half full, and only when moving cannot throw. It also needs two free
+   * slots, so that both ends get one: with a single one, it may stay on the wrong side.
+   */
+  bool needs_buffer(void) const {
+    constexpr bool in_place_ok = is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>;
+    return !in_place_ok || 2 * size() > m_capacity || m_capacity - size() < 2;
+  }
+
+  /// Moves `count` live elements from `src` to raw slots at `dst`, in a buffer or across buffers.
+  /*!
+   * The ranges may overlap; `src` ends up raw. Only used when this cannot throw.
+   */
+  static void relocate(pointer src, size_type count, pointer dst) noexcept {
+    if (src == dst || count == 0) return;
+    if constexpr (is_trivially_relocatable_v<T>) {
+      std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+    }
+    else if (dst < src) {
+      for (size_type i{0}; i < count; ++i) {
+        ::new (static_cast<void*>(dst + i)) T(std::move(src[i]));
+        std::destroy_at(src + i);
+      }
+    }
+    else {
+      for (size_type i{count}; i > 0; --i) {
+        ::new (static_cast<void*>(dst + i - 1)) T(std::move(src[i - 1]));
+        std::destroy_at(src + i - 1);
+      }
+    }
+  }
+
+  /// Moves the elements to the middle of the current buffer.
+  void recenter(void) noexcept {
+    size_type n = size();
+    size_type new_begin = (m_capacity - n) / 2;
+    relocate(m_storage + m_begin, n, m_storage + new_begin);
+    m_begin = new_begin;
+    m_end = new_begin + n;
+  }
+
+  /// Moves the elements to a new buffer of `new_cap` slots, starting at slot `new_begin`.
+  void reallocate(size_type new_cap, size_type new_begin) {
+    pointer new_storage = allocate(new_cap);
+    size_type n = size();
+    try { transfer(m_storage + m_begin, n, new_storage + new_begin); }
+    catch (...) { deallocate(new_storage, new_cap); throw; }
+    deallocate(m_storage, m_capacity);
+    m_storage = new_storage;
+    m_capacity = new_cap;
+    m_begin = new_begin;
+    m_end = new_begin + n;
+  }
+
+  /// Relocates `count` elements to another buffer; if that throws, the source is untouched.
+  void transfer(pointer src, size_type count, pointer dst) {
+    if constexpr (is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+      relocate(src, count, dst);
+    }
+    else {
+      std::uninitialized_copy(src, src + count, dst);
+      std::destroy(src, src + count);
+    }
+  }
+
+  /// Grows into a new buffer, with the elements centered, and builds an element at index `idx` in it.
+  template <typename... Args>
+  void grow_and_emplace(size_type idx, Args&&... args) {
+    size_type n = size();
+    size_type new_cap = GrowthPolicy::next_capacity(m_capacity, n + 1, sizeof(T));
+    if (new_cap < n + 1) new_cap = n + 1;
+    size_type new_begin = (new_cap - n - 1) / 2;
+    pointer new_storage = allocate(new_cap);
+    pointer first = new_storage + new_begin;
+    // The new element first: `args` may refer to an element of the old buffer.
+    try { ::new (static_cast<void*>(first + idx)) T(std::forward<Args>(args)...); }
+    catch (...) { deallocate(new_storage, new_cap); throw; }
+    pointer old_first = m_storage + m_begin;
+    if constexpr (is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+      relocate(old_first, idx, first);
+      relocate(old_first + idx, n - idx, first + idx + 1);
+    }
+    else {
+      // Copy both sides before destroying anything, so a throwing copy leaves us untouched.
+      try {
+        std::uninitialized_copy(old_first, old_first + idx, first);
+        try { std::uninitialized_copy(old_first + idx, old_first + n, first + idx + 1); }
+        catch (...) { std::destroy(first, first + idx); throw; }
+      }
+      catch (...) {
+        std::destroy_at(first + idx);
+        deallocate(new_storage, new_cap);
+        throw;
+      }
+      std::destroy(old_first, old_first + n);
+    }
+    deallocate(m_storage, m_capacity);
+    m_storage = new_storage;
+    m_capacity = new_cap;
+    m_begin = new_begin;
+    m_end = new_begin + n + 1;
+  }
+
+  /// Replaces the contents with the `count` elements starting at `first`.
+  template <typename FwdItr>
+  void assign_range(FwdItr first, size_type count) {
+    clear();
+    if (count > m_capacity) {
+      release();
+      m_storage = allocate(count);
+      m_capacity = count;
+    }
+    m_begin = m_end = (m_capacity - count) / 2;
+    std::uninitialized_copy_n(first, count, m_storage + m_begin);
+    m_end += count;
+  }
+
+  SC_NO_UNIQUE_ADDRESS allocator_type m_alloc; //!< Provides the storage.
+  pointer m_storage{nullptr};   //!< The buffer.
+  size_type m_begin{0};         //!< Index of the first element.
+  size_type m_end{0};           //!< Index past the last element.
+  size_type m_capacity{0};      //!< Slots in the buffer.
+};
+
+template <typename T, typename Alloc, typename G>
+bool operator==(const devector<T, Alloc, G>& a, const devector<T, Alloc, G>& b) {
+  return a.size() == b.size() && std::equal(a.cbegin(), a.cend(), b.cbegin());
+}
+
+template <typename T, typename Alloc, typename G>
+bool operator!=(const devector<T, Alloc, G>& a, const devector<T, Alloc, G>& b) {
+  return !(a == b);
+}
+
+} // namespace sc.
+
+#endif
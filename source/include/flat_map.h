@@ -0,0 +1,161 @@
+#ifndef _FLAT_MAP_H_
+#define _FLAT_MAP_H_
+
+#include <functional>   // std::less
+#include <initializer_list> // std::initializer_list
+#include <memory>       // std::allocator
+#include <tuple>        // std::forward_as_tuple
+#include <utility>      // std::move, std::pair, std::piecewise_construct
+
+#include "checks.h"     // sc::detail::throw_out_of_range
+#include "flat_tree.h"  // sc::detail::flat_tree, sc::sorted_unique
+
+/// Sequence container namespace.
+namespace sc {
+
+/// A map kept as a sorted `sc::vector` of pairs: lookups are a branchless binary search.
+/*!
+ * The interface of `std::map` (`operator[]`, `at`, `try_emplace`, `insert_or_assign`, ...) over
+ * one contiguous buffer of `std::pair<Key, T>`, as `flat_set` is over its keys: fast lookups and
+ * iteration, single insertions and erasures that shift the pairs after the position, and bulk
+ * construction and `insert(first, last)` that sort once and merge in one pass. Of repeated keys
+ * in the input, the first one is kept, as `std::map` would.
+ *
+ *     sc::flat_map<std::string, int> ports{ { "http", 80 }, { "ssh", 22 } };
+ *     ports["https"] = 443;
+ *     if (auto it = ports.find("ssh"); it != ports.end()) ...
+ *
+ * `value_type` is `std::pair<Key, T>` (not `std::pair<const Key, T>`, since the pairs are moved
+ * around in the buffer): the key reached through an iterator must not be modified.
+ */
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<Key, T>>>
+class flat_map : public detail::flat_tree<std::pair<Key, T>, detail::first_key, Compare, Allocator> {
+  using base = detail::flat_tree<std::pair<Key, T>, detail::first_key, Compare, Allocator>;
+
+ public:
+  using typename base::key_type;
+  using mapped_type = T;
+  using typename base::value_type;
+  using typename base::size_type;
+  using typename base::container_type;
+  using iterator = typename container_type::iterator;
+  using const_iterator = typename container_type::const_iterator;
+
+  // [I] Special members
+  explicit flat_map(const Compare& comp = Compare{}, const Allocator& alloc = Allocator{}) : base(comp, alloc) { /* empty */ }
+
+  //Range constructor: sorts the pairs by key and keeps the first of each repeated key.
+  template <typename InputItr, typename = require_input_iterator<InputItr>>
+  flat_map(InputItr first, InputItr last, const Compare& comp = Compare{}, const Allocator& alloc = Allocator{})
+    : base(container_type(first, last, alloc), comp, false) { /* empty */ }
+
+  flat_map(std::initializer_list<value_type> il, const Compare& comp = Compare{}, const Allocator& alloc = Allocator{})
+    : flat_map(il.begin(), il.end(), comp, alloc) { /* empty */ }
+
+  //Adopts the pairs of `items`, sorting them by key and keeping the first of each repeated key.
+  explicit flat_map(container_type items, const Compare& comp = Compare{}) : base(std::move(items), comp, false) { /* empty */ }
+
+  //Adopts `items`, which must already be sorted by key and unique (asserted): no sort at all.
+  flat_map(sorted_unique_t, container_type items, const Compare& comp = Compare{}) : base(std::move(items), comp, true) { /* empty */ }
+
+  // [II] Iterators
+  iterator begin(void) { return this->m_items.begin(); }
+  iterator end(void) { return this->m_items.end(); }
+  const_iterator begin(void) const { return this->m_items.cbegin(); }
+  const_iterator end(void) const { return this->m_items.cend(); }
+  const_iterator cbegin(void) const { return this->m_items.cbegin(); }
+  const_iterator cend(void) const { return this->m_items.cend(); }
+
+  // [III] Element access
+  //The value of `key`, inserting a value-initialized one if `key` is not there.
+  T& operator[](const key_type& key) { return try_emplace(key).first->second; }
+  T& operator[](key_type&& key) { return try_emplace(std::move(key)).first->second; }
+
+  T& at(const key_type& key) {
+    size_type idx = this->find_index(key);
+    if (idx == this->size()) detail::throw_out_of_range("flat_map::at: no such key");
+    return this->m_items[idx].second;
+  }
+
+  const T& at(const key_type& key) const {
+    size_type idx = this->find_index(key);
+    if (idx == this->size()) detail::throw_out_of_range("flat_map::at: no such key");
+    return this->m_items[idx].second;
+  }
+
+  // [IV] Lookup
+  iterator find(const key_type& key) { return begin() + this->find_index(key); }
+  const_iterator find(const key_type& key) const { return begin() + this->find_index(key); }
+  iterator lower_bound(const key_type& key) { return begin() + this->lower_index(key); }
+  const_iterator lower_bound(const key_type& key) const { return begin() + this->lower_index(key); }
+  iterator upper_bound(const key_type& key) { return begin() + this->upper_index(key); }
+  const_iterator upper_bound(const key_type& key) const { return begin() + this->upper_index(key); }
+
+  std::pair<iterator, iterator> equal_range(const key_type& key) {
+    size_type idx = this->lower_index(key);
+    return { begin() + idx, begin() + this->past_equal(idx, key) };
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+    size_type idx = this->lower_index(key);
+    return { begin() + idx, begin() + this->past_equal(idx, key) };
+  }
+
+  // [V] Modifiers
+  std::pair<iterator, bool> insert(const value_type& value) { return placed(this->emplace_unique(value.first, value)); }
+  std::pair<iterator, bool> insert(value_type&& value) { return placed(this->emplace_unique(value.first, std::move(value))); }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) { return insert(value_type(std::forward<Args>(args)...)); }
+
+  //Inserts `key` with a value made from `args`, unless `key` is there (then `args` are left alone).
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+    return placed(this->emplace_unique(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                       std::forward_as_tuple(std::forward<Args>(args)...)));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+    return placed(this->emplace_unique(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                                       std::forward_as_tuple(std::forward<Args>(args)...)));
+  }
+
+  //Inserts `key` with `value`, or assigns `value` to the value `key` already has.
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& value) {
+    auto result = try_emplace(key, std::forward<M>(value));
+    if (!result.second) result.first->second = std::forward<M>(value);
+    return result;
+  }
+
+  //Inserts the pairs of `[first, last)` whose key is not there yet, sorting the batch and merging it in one pass.
+  template <typename InputItr, typename = require_input_iterator<InputItr>>
+  void insert(InputItr first, InputItr last) { this->insert_range(first, last); }
+
+  void insert(std::initializer_list<value_type> il) { this->insert_range(il.begin(), il.end()); }
+
+  using base::erase;
+  iterator erase(iterator pos) { return this->m_items.erase(pos); }
+  iterator erase(const_iterator pos) { return this->m_items.erase(pos); }
+  iterator erase(const_iterator first, const_iterator last) { return this->m_items.erase(first, last); }
+
+  void swap(flat_map& other) noexcept {
+    using std::swap;
+    swap(this->m_items, other.m_items);
+    swap(this->m_comp, other.m_comp);
+  }
+
+ private:
+  std::pair<iterator, bool> placed(std::pair<size_type, bool> where) { return { begin() + where.first, where.second }; }
+};
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void swap(flat_map<Key, T, Compare, Allocator>& first, flat_map<Key, T, Compare, Allocator>& second) noexcept {
+  first.swap(second);
+}
+
+} // namespace sc.
+
+#endif
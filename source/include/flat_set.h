@@ -0,0 +1,105 @@
+#ifndef _FLAT_SET_H_
+#define _FLAT_SET_H_
+
+#include <functional>   // std::less
+#include <initializer_list> // std::initializer_list
+#include <memory>       // std::allocator
+#include <utility>      // std::move, std::pair
+
+#include "flat_tree.h"  // sc::detail::flat_tree, sc::sorted_unique
+
+/// Sequence container namespace.
+namespace sc {
+
+/// A set kept as a sorted `sc::vector`: lookups are a branchless binary search over contiguous keys.
+/*!
+ * The interface of `std::set`, with the costs of a sorted array: `find`/`contains` touch
+ * log2(n) cache lines and no nodes; iterating is a walk over a buffer; inserting or erasing one
+ * key shifts the keys after it, so insert in bulk: the range constructor sorts once and drops the
+ * duplicates, and `insert(first, last)` merges a whole batch in one pass.
+ *
+ *     sc::flat_set<int> seen{ ids.begin(), ids.end() };   // sort + unique, one allocation.
+ *     seen.insert(more.begin(), more.end());               // sort the batch, merge once.
+ *     if (seen.contains(id)) ...
+ *
+ * Iterators are random access, always const, and invalidated by every insertion and erasure.
+ */
+template <typename Key, typename Compare = std::less<Key>, typename Allocator = std::allocator<Key>>
+class flat_set : public detail::flat_tree<Key, detail::identity_key, Compare, Allocator> {
+  using base = detail::flat_tree<Key, detail::identity_key, Compare, Allocator>;
+
+ public:
+  using typename base::key_type;
+  using typename base::value_type;
+  using typename base::size_type;
+  using typename base::container_type;
+  using iterator = typename container_type::const_iterator;
+  using const_iterator = iterator;
+
+  // [I] Special members
+  explicit flat_set(const Compare& comp = Compare{}, const Allocator& alloc = Allocator{}) : base(comp, alloc) { /* empty */ }
+
+  //Range constructor: sorts the elements and drops the repeated ones.
+  template <typename InputItr, typename = require_input_iterator<InputItr>>
+  flat_set(InputItr first, InputItr last, const Compare& comp = Compare{}, const Allocator& alloc = Allocator{})
+    : base(container_type(first, last, alloc), comp, false) { /* empty */ }
+
+  flat_set(std::initializer_list<Key> il, const Compare& comp = Compare{}, const Allocator& alloc = Allocator{})
+    : flat_set(il.begin(), il.end(), comp, alloc) { /* empty */ }
+
+  //Adopts the elements of `keys`, sorting them and dropping the repeated ones.
+  explicit flat_set(container_type keys, const Compare& comp = Compare{}) : base(std::move(keys), comp, false) { /* empty */ }
+
+  //Adopts `keys`, which must already be sorted and unique (asserted): no sort at all.
+  flat_set(sorted_unique_t, container_type keys, const Compare& comp = Compare{}) : base(std::move(keys), comp, true) { /* empty */ }
+
+  // [II] Iterators
+  iterator begin(void) const { return this->m_items.cbegin(); }
+  iterator end(void) const { return this->m_items.cend(); }
+  iterator cbegin(void) const { return this->m_items.cbegin(); }
+  iterator cend(void) const { return this->m_items.cend(); }
+
+  // [III] Lookup
+  iterator find(const key_type& key) const { return begin() + this->find_index(key); }
+  iterator lower_bound(const key_type& key) const { return begin() + this->lower_index(key); }
+  iterator upper_bound(const key_type& key) const { return begin() + this->upper_index(key); }
+  std::pair<iterator, iterator> equal_range(const key_type& key) const {
+    size_type idx = this->lower_index(key);
+    return { begin() + idx, begin() + this->past_equal(idx, key) };
+  }
+
+  // [IV] Modifiers
+  std::pair<iterator, bool> insert(const value_type& value) { return placed(this->emplace_unique(value, value)); }
+  std::pair<iterator, bool> insert(value_type&& value) { return placed(this->emplace_unique(value, std::move(value))); }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) { return insert(value_type(std::forward<Args>(args)...)); }
+
+  //Inserts the keys of `[first, last)` that are not there yet, sorting the batch and merging it in one pass.
+  template <typename InputItr, typename = require_input_iterator<InputItr>>
+  void insert(InputItr first, InputItr last) { this->insert_range(first, last); }
+
+  void insert(std::initializer_list<Key> il) { this->insert_range(il.begin(), il.end()); }
+
+  using base::erase;
+  iterator erase(const_iterator pos) { return this->m_items.erase(pos); }
+  iterator erase(const_iterator first, const_iterator last) { return this->m_items.erase(first, last); }
+
+  void swap(flat_set& other) noexcept {
+    using std::swap;
+    swap(this->m_items, other.m_items);
+    swap(this->m_comp, other.m_comp);
+  }
+
+ private:
+  std::pair<iterator, bool> placed(std::pair<size_type, bool> where) const { return { begin() + where.first, where.second }; }
+};
+
+template <typename Key, typename Compare, typename Allocator>
+void swap(flat_set<Key, Compare, Allocator>& first, flat_set<Key, Compare, Allocator>& second) noexcept {
+  first.swap(second);
+}
+
+} // namespace sc.
+
+#endif
@@ -0,0 +1,187 @@
+#ifndef _FLAT_TREE_H_
+#define _FLAT_TREE_H_
+
+#include <algorithm>    // std::stable_sort, std::unique, std::adjacent_find
+#include <cassert>      // assert()
+#include <cstddef>      // std::size_t
+#include <iterator>     // std::make_move_iterator
+#include <type_traits>  // std::decay_t
+#include <utility>      // std::declval, std::forward, std::move, std::pair
+
+#include "vector.h"
+
+/// Sequence container namespace.
+namespace sc {
+
+/// Tag for the constructors of `flat_set`/`flat_map` whose input is already sorted and unique.
+struct sorted_unique_t { explicit sorted_unique_t(void) = default; };
+inline constexpr sorted_unique_t sorted_unique{};
+
+namespace detail {
+
+/// Index of the first of the `n` elements at `first` whose key is not less than `key`.
+/*!
+ * Branchless: each step keeps one half of the range with a conditional move instead of a jump,
+ * so a lookup is log2(n) loads whose addresses the CPU cannot mispredict.
+ */
+template <typename T, typename Key, typename KeyOf, typename Compare>
+std::size_t branchless_lower_bound(const T* first, std::size_t n, const Key& key, KeyOf key_of, const Compare& comp) {
+  if (n == 0) return 0;
+  const T* base = first;
+  while (n > 1) {
+    std::size_t half = n / 2;
+    base = comp(key_of(base[half]), key) ? base + half : base;
+    n -= half;
+  }
+  return (base - first) + comp(key_of(*base), key);
+}
+
+/// The key of a `flat_set` element: the element.
+struct identity_key {
+  template <typename T>
+  const T& operator()(const T& value) const noexcept { return value; }
+};
+
+/// The key of a `flat_map` element: `first`.
+struct first_key {
+  template <typename Pair>
+  const auto& operator()(const Pair& value) const noexcept { return value.first; }
+};
+
+/// What `flat_set` and `flat_map` share: a `sc::vector` kept sorted by key, without duplicates.
+/*!
+ * The derived classes add the iterator-returning interface (a set only hands out const
+ * iterators). Positions are passed around as indices so the two can wrap them as they like.
+ */
+template <typename Value, typename KeyOf, typename Compare, typename Allocator>
+class flat_tree {
+ public:
+  using key_type = std::decay_t<decltype(KeyOf{}(std::declval<const Value&>()))>;
+  using value_type = Value;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using container_type = vector<Value, Allocator>;
+  using size_type = typename container_type::size_type;
+
+  size_type size(void) const noexcept { return m_items.size(); }
+  bool empty(void) const noexcept { return m_items.empty(); }
+  size_type capacity(void) const noexcept { return m_items.capacity(); }
+  void reserve(size_type count) { m_items.reserve(count); }
+  void shrink_to_fit(void) { m_items.shrink_to_fit(); }
+  void clear(void) noexcept { m_items.clear(); }
+
+  key_compare key_comp(void) const { return m_comp; }
+  allocator_type get_allocator(void) const { return m_items.get_allocator(); }
+
+  bool contains(const key_type& key) const { return find_index(key) != size(); }
+  size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+  /// Removes the element with `key`, if any; returns how many were removed (0 or 1).
+  size_type erase(const key_type& key) {
+    size_type idx = find_index(key);
+    if (idx == size()) return 0;
+    m_items.erase(m_items.cbegin() + idx);
+    return 1;
+  }
+
+  /// The sorted elements, e.g. to hand them to code that takes a `sc::vector` or a pointer.
+  const container_type& sequence(void) const noexcept { return m_items; }
+
+  /// Gives the elements away, leaving the container empty.
+  container_type extract(void) && {
+    container_type items = std::move(m_items);
+    m_items.clear();
+    return items;
+  }
+
+  friend bool operator==(const flat_tree& lhs, const flat_tree& rhs) { return lhs.m_items == rhs.m_items; }
+  friend bool operator!=(const flat_tree& lhs, const flat_tree& rhs) { return !(lhs == rhs); }
+
+ protected:
+  flat_tree(const Compare& comp, const Allocator& alloc) : m_items(alloc), m_comp{comp} { /* empty */ }
+
+  /// Adopts `items`, sorting them unless the caller says they are `sorted`.
+  flat_tree(container_type items, const Compare& comp, bool sorted) : m_items(std::move(items)), m_comp{comp} {
+    if (!sorted) sort_unique(m_items, m_comp);
+    else assert(is_sorted_unique(m_items, m_comp) && "sorted_unique: the elements are not sorted and unique");
+  }
+
+  /// Orders the elements by key and drops the later ones of each run of equal keys.
+  static void sort_unique(container_type& items, const Compare& comp) {
+    auto less = [&](const Value& a, const Value& b){ return comp(KeyOf{}(a), KeyOf{}(b)); };
+    std::stable_sort(items.begin(), items.end(), less);
+    auto equal = [&](const Value& a, const Value& b){ return !less(a, b) && !less(b, a); };
+    items.erase(std::unique(items.begin(), items.end(), equal), items.end());
+  }
+
+  static bool is_sorted_unique(const container_type& items, const Compare& comp) {
+    return std::adjacent_find(items.begin(), items.end(), [&](const Value& a, const Value& b){
+      return !comp(KeyOf{}(a), KeyOf{}(b));
+    }) == items.end();
+  }
+
+  size_type lower_index(const key_type& key) const {
+    return branchless_lower_bound(m_items.data(), m_items.size(), key, KeyOf{}, m_comp);
+  }
+
+  size_type upper_index(const key_type& key) const { return past_equal(lower_index(key), key); }
+
+  /// The index after the element with `key`, given the `lower_index` of `key` (keys are unique).
+  size_type past_equal(size_type idx, const key_type& key) const {
+    return idx + (idx < size() && !m_comp(key, KeyOf{}(m_items[idx])));
+  }
+
+  /// Index of the element with `key`, or `size()`.
+  size_type find_index(const key_type& key) const {
+    size_type idx = lower_index(key);
+    return idx < size() && !m_comp(key, KeyOf{}(m_items[idx])) ? idx : size();
+  }
+
+  /// Constructs an element from `args` at the place of `key`, unless `key` is there already.
+  /*!
+   * Returns the index of the element with `key` and whether it was inserted.
+   */
+  template <typename... Args>
+  std::pair<size_type, bool> emplace_unique(const key_type& key, Args&&... args) {
+    size_type idx = lower_index(key);
+    if (idx < size() && !m_comp(key, KeyOf{}(m_items[idx]))) return { idx, false };
+    m_items.emplace(m_items.cbegin() + idx, std::forward<Args>(args)...);
+    return { idx, true };
+  }
+
+  /// Inserts the elements of `[first, last)` whose key is not there yet, in O(size + k log k).
+  /*!
+   * The batch is sorted and deduplicated on its own (the first of equal keys wins, as with `k`
+   * single inserts), the keys already present are dropped in one walk, and what remains is merged
+   * in with `vector::merge_sorted`, moving every element once instead of once per insertion; a
+   * batch that goes after every key is just appended with the range `insert`.
+   */
+  template <typename InputItr>
+  void insert_range(InputItr first, InputItr last) {
+    container_type batch(first, last, m_items.get_allocator());
+    if (batch.empty()) return;
+    sort_unique(batch, m_comp);
+    size_type i{0};
+    batch.remove_if([&](const Value& v){
+      while (i < size() && m_comp(KeyOf{}(m_items[i]), KeyOf{}(v))) ++i;
+      return i < size() && !m_comp(KeyOf{}(v), KeyOf{}(m_items[i]));
+    });
+    if (batch.empty()) return;
+    if (m_items.empty() || m_comp(KeyOf{}(m_items.back()), KeyOf{}(batch.front()))) {
+      m_items.insert(m_items.cend(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+      return;
+    }
+    const Compare& comp = m_comp;
+    m_items.merge_sorted(std::move(batch), [&](const Value& a, const Value& b){
+      return comp(KeyOf{}(a), KeyOf{}(b));
+    });
+  }
+
+  container_type m_items; //!< Sorted by key, no two keys equivalent.
+  SC_NO_UNIQUE_ADDRESS Compare m_comp;
+};
+
+} // namespace detail.
+} // namespace sc.
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef _GROWTH_POLICY_H_
+#define _GROWTH_POLICY_H_
+
+#include <cstddef>      // std::size_t
+
+/// Sequence container namespace.
+namespace sc {
+
+// A growth policy tells `sc::vector` how many slots to allocate when it runs out of room.
+// It is a class with a single static member function:
+//
+//     static std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t elem_size);
+//
+// `capacity` is the current capacity, `required` the number of slots the operation needs and
+// `elem_size` is `sizeof(T)`. The result must be at least `required`. Growing geometrically
+// (by a constant factor) is what makes a sequence of appends amortized O(1).
+
+/// Starts with 10 slots, then doubles the capacity. The default policy.
+struct doubling_growth {
+  static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required,
+                                             std::size_t /* elem_size */) noexcept {
+    std::size_t new_cap = capacity == 0 ? 10 : 2 * capacity;
+    return new_cap < required ? required : new_cap;
+  }
+};
+
+/// Grows by a factor of 1.5.
+/*!
+ * With a factor below the golden ratio the blocks freed by earlier reallocations eventually add
+ * up to the size of the next request, so the allocator can reuse them; doubling never allows it.
+ */
+struct half_growth {
+  static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required,
+                                             std::size_t /* elem_size */) noexcept {
+    std::size_t new_cap = capacity < 4 ? 8 : capacity + capacity / 2;
+    return new_cap < required ? required : new_cap;
+  }
+};
+
+/// Grows by 1.5x and then rounds the byte size up to a jemalloc size class.
+/*!
+ * Allocators such as jemalloc (and tcmalloc, mimalloc) serve a request from the smallest size
+ * class that holds it: multiples of 16 bytes up to 128, then four classes per power of two
+ * (160, 192, 224, 256, 320, ...). Asking for a whole class turns slack the allocator would waste
+ * anyway into usable capacity.
+ */
+struct size_class_growth {
+  /// Smallest size class that holds `bytes` bytes.
+  static constexpr std::size_t round_to_class(std::size_t bytes) noexcept {
+    if (bytes <= 128) return bytes <= 16 ? 16 : (bytes + 15) & ~std::size_t{15};
+    // Four classes between 2^k (exclusive) and 2^(k+1) (inclusive), 2^(k-2) bytes apart.
+    std::size_t k{0};
+    while ((std::size_t{2} << k) < bytes) ++k;
+    std::size_t spacing = std::size_t{1} << (k - 2);
+    return (bytes + spacing - 1) & ~(spacing - 1);
+  }
+
+  static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required,
+                                             std::size_t elem_size) noexcept {
+    std::size_t new_cap = half_growth::next_capacity(capacity, required, elem_size);
+    return round_to_class(new_cap * elem_size) / elem_size;
+  }
+};
+
+} // namespace sc.
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef _INDEX_ITERATOR_H_
+#define _INDEX_ITERATOR_H_
+
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <iterator>     // std::random_access_iterator_tag
+#include <type_traits>  // std::remove_const_t, std::enable_if_t, std::is_same_v
+
+/// Sequence container namespace.
+namespace sc {
+
+/// Random access iterator for containers that are not contiguous but index in O(1).
+/*!
+ * It holds the container and an index, and goes through `operator[]` on every access, so it
+ * survives the growth of containers whose elements never move (`sc::concurrent_vector`,
+ * `sc::stable_vector`). The mutable version converts implicitly to the const one.
+ *
+ * \tparam Owner The container, `const`-qualified for a const_iterator.
+ * \tparam T The element type, `const`-qualified for a const_iterator.
+ */
+template <typename Owner, typename T>
+class index_iterator {
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::remove_const_t<T>;
+  using reference = T&;
+  using pointer = T*;
+  using difference_type = std::ptrdiff_t;
+
+  index_iterator(Owner* owner = nullptr, std::size_t idx = 0) : m_owner{owner}, m_idx{idx} { /* empty */ }
+  /// Converts an iterator into a const_iterator (only declared for the const one, so the mutable
+  /// one keeps its implicit copy constructor and assignment).
+  template <typename O, typename U, typename = std::enable_if_t<std::is_same_v<const O, Owner> &&
+                                                               std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+  index_iterator(const index_iterator<O, U>& other) : m_owner{other.m_owner}, m_idx{other.m_idx} { /* empty */ }
+
+  reference operator*(void) const { return (*m_owner)[m_idx]; }
+  pointer operator->(void) const { return &(*m_owner)[m_idx]; }
+  reference operator[](difference_type offset) const { return (*m_owner)[m_idx + offset]; }
+
+  /// The index this iterator points to.
+  std::size_t index(void) const { return m_idx; }
+
+  index_iterator& operator++(void) { ++m_idx; return *this; }
+  index_iterator operator++(int) { index_iterator temp{*this}; ++m_idx; return temp; }
+  index_iterator& operator--(void) { --m_idx; return *this; }
+  index_iterator operator--(int) { index_iterator temp{*this}; --m_idx; return temp; }
+  index_iterator& operator+=(difference_type offset) { m_idx += offset; return *this; }
+  index_iterator& operator-=(difference_type offset) { m_idx -= offset; return *this; }
+  friend index_iterator operator+(index_iterator it, difference_type offset) { return it += offset; }
+  friend index_iterator operator+(difference_type offset, index_iterator it) { return it += offset; }
+  friend index_iterator operator-(index_iterator it, difference_type offset) { return it -= offset; }
+  friend difference_type operator-(const index_iterator& a, const index_iterator& b) {
+    return static_cast<difference_type>(a.m_idx) - static_cast<difference_type>(b.m_idx);
+  }
+
+  friend bool operator==(const index_iterator& a, const index_iterator& b) { return a.m_idx == b.m_idx; }
+  friend bool operator!=(const index_iterator& a, const index_iterator& b) { return a.m_idx != b.m_idx; }
+  friend bool operator<(const index_iterator& a, const index_iterator& b) { return a.m_idx < b.m_idx; }
+  friend bool operator>(const index_iterator& a, const index_iterator& b) { return a.m_idx > b.m_idx; }
+  friend bool operator<=(const index_iterator& a, const index_iterator& b) { return a.m_idx <= b.m_idx; }
+  friend bool operator>=(const index_iterator& a, const index_iterator& b) { return a.m_idx >= b.m_idx; }
+
+ private:
+  template <typename, typename> friend class index_iterator;
+  Owner* m_owner;      //!< The container.
+  std::size_t m_idx;   //!< The position in it.
+};
+
+} // namespace sc.
+
+#endif
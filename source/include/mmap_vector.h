@@ -0,0 +1,301 @@
+#ifndef _MMAP_VECTOR_H_
+#define _MMAP_VECTOR_H_
+
+#include <cerrno>       // errno
+#include <cstddef>      // std::size_t
+#include <iterator>     // std::distance
+#include <memory>       // std::uninitialized_copy
+#include <new>          // placement new
+#include <stdexcept>    // std::out_of_range, std::logic_error
+#include <string>       // std::string
+#include <system_error> // std::system_error
+#include <type_traits>  // std::is_trivially_copyable_v
+#include <utility>      // std::exchange, std::forward
+
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap, munmap, msync
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // ftruncate, close, sysconf
+
+#include "vector.h"         // sc::MyForwardIterator
+#include "growth_policy.h"  // sc::doubling_growth
+
+/// Sequence container namespace.
+namespace sc {
+
+/// How an `mmap_vector` maps its file.
+enum class map_mode {
+  read_write,  //!< Creates the file if needed; changes go to the file.
+  read_only    //!< The file must exist; the mapping is shared, so processes share the page cache.
+};
+
+/// A vector of trivially copyable records that lives in a memory-mapped file (POSIX only).
+/*!
+ * The file holds the elements back to back, with nothing else: opening it maps them in place,
+ * with no reading or parsing, and the file can be produced or consumed by any other program.
+ * While open in `read_write` mode the file is extended (with `ftruncate`) to the capacity and
+ * remapped when it grows; sync() and closing trim it back to `size()` elements. So the file only
+ * ever shows records after a sync(): between two of them, a crash or another process opening it
+ * sees the records since the last sync() followed by zero-filled ones, up to the capacity. The
+ * mapping outlives sync(), and the next write past `size()` extends the file again.
+ *
+ *     sc::mmap_vector<record> table{ "table.bin", sc::map_mode::read_only };
+ *     for (const auto& r : table) ...
+ */
+template <typename T, typename GrowthPolicy = doubling_growth>
+class mmap_vector {
+  static_assert(std::is_trivially_copyable_v<T>, "mmap_vector stores its elements as raw bytes");
+
+ public:
+  using size_type = std::size_t;
+  using value_type = T;
+  using pointer = T*;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = MyForwardIterator<T>;
+  using const_iterator = MyForwardIterator<const T>;
+
+  //Maps the file at `path`.
+  /*!
+   * Throws `std::system_error` if the file cannot be opened or mapped, and
+   * `std::runtime_error` if its size is not a multiple of `sizeof(T)`.
+   */
+  explicit mmap_vector(const std::string& path, map_mode mode = map_mode::read_write) : m_mode{mode} {
+    m_fd = ::open(path.c_str(), mode == map_mode::read_only ? O_RDONLY : O_RDWR | O_CREAT, 0644);
+    if (m_fd < 0) throw_errno("open");
+    struct stat st;
+    if (::fstat(m_fd, &st) != 0) {
+      int err = errno;
+      ::close(m_fd);
+      throw std::system_error{err, std::generic_category(), "mmap_vector: fstat"};
+    }
+    if (static_cast<size_type>(st.st_size) % sizeof(T) != 0) {
+      ::close(m_fd);
+      throw std::runtime_error{"mmap_vector: the file size is not a multiple of sizeof(T)"};
+    }
+    m_end = m_file_end = static_cast<size_type>(st.st_size) / sizeof(T);
+    try { map(m_end); }
+    catch (...) { ::close(m_fd); throw; }
+  }
+
+  //Unmaps the file and trims it to `size()` elements. Errors are ignored here; call close() to see them.
+  ~mmap_vector(void) {
+    try { close(); }
+    catch (...) { /* nothing to do */ }
+  }
+
+  mmap_vector(const mmap_vector&) = delete;
+  mmap_vector& operator=(const mmap_vector&) = delete;
+
+  mmap_vector(mmap_vector&& other) noexcept
+    : m_fd{std::exchange(other.m_fd, -1)}, m_mode{other.m_mode}, m_storage{std::exchange(other.m_storage, nullptr)},
+      m_end{std::exchange(other.m_end, 0)}, m_capacity{std::exchange(other.m_capacity, 0)},
+      m_file_end{std::exchange(other.m_file_end, 0)} { /* empty */ }
+
+  mmap_vector& operator=(mmap_vector&& other) noexcept {
+    if (this != &other) {
+      try { close(); }
+      catch (...) { /* as in the destructor */ }
+      m_fd = std::exchange(other.m_fd, -1);
+      m_mode = other.m_mode;
+      m_storage = std::exchange(other.m_storage, nullptr);
+      m_end = std::exchange(other.m_end, 0);
+      m_capacity = std::exchange(other.m_capacity, 0);
+      m_file_end = std::exchange(other.m_file_end, 0);
+    }
+    return *this;
+  }
+
+  //Unmaps the file and trims it to `size()` elements; the vector is empty and unusable afterwards.
+  void close(void) {
+    if (m_fd < 0) return;
+    unmap();
+    int fd = std::exchange(m_fd, -1);
+    size_type count = std::exchange(m_end, 0);
+    if (m_mode == map_mode::read_write && ::ftruncate(fd, static_cast<off_t>(count * sizeof(T))) != 0) {
+      int err = errno;
+      ::close(fd);
+      throw std::system_error{err, std::generic_category(), "mmap_vector: ftruncate"};
+    }
+    if (::close(fd) != 0) throw_errno("close");
+  }
+
+  //Writes the dirty pages to the file, waits for it and trims the file to `size()` elements.
+  /*!
+   * The mapping stays as it is: only its slots past `size()` are no longer backed by the file,
+   * until a write needs them (see the class description).
+   */
+  void sync(void) {
+    if (m_mode != map_mode::read_write) return;
+    if (m_storage != nullptr && ::msync(m_storage, m_capacity * sizeof(T), MS_SYNC) != 0)
+      throw_errno("msync");
+    if (m_file_end != m_end) {
+      if (::ftruncate(m_fd, static_cast<off_t>(m_end * sizeof(T))) != 0) throw_errno("ftruncate");
+      m_file_end = m_end;
+    }
+  }
+
+  // [I] Iterators
+  iterator begin(void) { return iterator{m_storage}; }
+  iterator end(void) { return iterator{m_storage + m_end}; }
+  const_iterator begin(void) const { return cbegin(); }
+  const_iterator end(void) const { return cend(); }
+  const_iterator cbegin(void) const { return const_iterator{m_storage}; }
+  const_iterator cend(void) const { return const_iterator{m_storage + m_end}; }
+
+  // [II] Capacity
+  size_type size(void) const { return m_end; }
+  size_type capacity(void) const { return m_capacity; }
+  bool empty(void) const { return m_end == 0; }
+  bool read_only(void) const { return m_mode == map_mode::read_only; }
+
+  //Makes room for `new_cap` elements: extends the file and remaps it.
+  void reserve(size_type new_cap) {
+    writable("reserve");
+    if (new_cap > m_capacity) map(new_cap);
+  }
+
+  //Trims the file (and the mapping) to `size()` elements, rounded up to a page.
+  void shrink_to_fit(void) {
+    writable("shrink_to_fit");
+    if (page_round(m_end) < m_capacity) map(m_end);
+  }
+
+  // [III] Modifiers
+  void clear(void) {
+    writable("clear");
+    m_end = 0;
+  }
+
+  void push_back(const_reference value) { emplace_back(value); }
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    writable("emplace_back");
+    if (m_end == m_capacity) {
+      T value(std::forward<Args>(args)...); // The arguments may refer to an element.
+      map(GrowthPolicy::next_capacity(m_capacity, m_end + 1, sizeof(T)));
+      return *::new (static_cast<void*>(m_storage + m_end++)) T(value);
+    }
+    if (m_end == m_file_end) extend_file();
+    return *::new (static_cast<void*>(m_storage + m_end++)) T(std::forward<Args>(args)...);
+  }
+
+  void pop_back(void) {
+    writable("pop_back");
+    if (m_end > 0) --m_end;
+  }
+
+  //Resizes to `count` elements; new elements are value-initialized (zero-filled).
+  void resize(size_type count) {
+    writable("resize");
+    if (count > m_capacity) map(GrowthPolicy::next_capacity(m_capacity, count, sizeof(T)));
+    else if (count > m_file_end) extend_file();
+    for (size_type i{m_end}; i < count; ++i) ::new (static_cast<void*>(m_storage + i)) T();
+    m_end = count;
+  }
+
+  //Appends the elements of [first, last), growing the file once.
+  template <typename FwdItr>
+  void append_range(FwdItr first, FwdItr last) {
+    writable("append_range");
+    size_type count = std::distance(first, last);
+    if (m_end + count > m_capacity) map(GrowthPolicy::next_capacity(m_capacity, m_end + count, sizeof(T)));
+    else if (m_end + count > m_file_end) extend_file();
+    std::uninitialized_copy(first, last, m_storage + m_end);
+    m_end += count;
+  }
+
+  // [IV] Element access
+  reference operator[](size_type idx) { return m_storage[idx]; }
+  const_reference operator[](size_type idx) const { return m_storage[idx]; }
+
+  reference at(size_type idx) {
+    if (idx < m_end) return m_storage[idx];
+    throw std::out_of_range{"The method 'at' cannot access this index"};
+  }
+  const_reference at(size_type idx) const {
+    if (idx < m_end) return m_storage[idx];
+    throw std::out_of_range{"The method 'at' cannot access this index"};
+  }
+
+  reference front(void) { return at(0); }
+  const_reference front(void) const { return at(0); }
+  reference back(void) { return at(m_end - 1); }
+  const_reference back(void) const { return at(m_end - 1); }
+
+  //The mapped elements. Writing through them is only allowed in `read_write` mode.
+  pointer data(void) { return m_storage; }
+  const T* data(void) const { return m_storage; }
+
+ private:
+  [[noreturn]] static void throw_errno(const char* what) {
+    throw std::system_error{errno, std::generic_category(), std::string{"mmap_vector: "} + what};
+  }
+
+  void writable(const char* method) const {
+    if (m_mode == map_mode::read_only)
+      throw std::logic_error{std::string{"The method '"} + method + "' needs a read_write mmap_vector"};
+  }
+
+  /// `n` elements, rounded up to a whole number of pages (and back to elements).
+  static size_type page_round(size_type n) {
+    static const size_type page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+    size_type bytes = (n * sizeof(T) + page - 1) / page * page;
+    return bytes / sizeof(T);
+  }
+
+  /// Maps room for `n` elements (at least `m_end`): in `read_write` mode the file is resized too.
+  /*!
+   * The new mapping is made before the old one goes away, so on failure the vector keeps its
+   * elements (the file may stay longer than needed; close() trims it). A file that grows is
+   * extended before it is mapped; one that shrinks is truncated only once the new mapping
+   * exists, since the old one must not lose the pages under it while it is the only one.
+   */
+  void map(size_type n) {
+    size_type new_cap = m_mode == map_mode::read_only ? n : page_round(n);
+    bool writes = m_mode == map_mode::read_write;
+    if (writes && new_cap > m_file_end && ::ftruncate(m_fd, static_cast<off_t>(new_cap * sizeof(T))) != 0)
+      throw_errno("ftruncate");
+    T* new_storage{nullptr};
+    if (new_cap > 0) {
+      int prot = m_mode == map_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+      void* addr = ::mmap(nullptr, new_cap * sizeof(T), prot, MAP_SHARED, m_fd, 0);
+      if (addr == MAP_FAILED) throw_errno("mmap");
+      new_storage = static_cast<T*>(addr);
+    }
+    if (writes && new_cap < m_file_end && ::ftruncate(m_fd, static_cast<off_t>(new_cap * sizeof(T))) != 0) {
+      int err = errno;
+      if (new_storage != nullptr) ::munmap(new_storage, new_cap * sizeof(T));
+      throw std::system_error{err, std::generic_category(), "mmap_vector: ftruncate"};
+    }
+    // Both mappings show the same file pages: nothing needs to be copied.
+    unmap();
+    m_storage = new_storage;
+    m_capacity = new_cap;
+    m_file_end = new_cap;
+  }
+
+  /// Extends a file that sync() trimmed back to the whole mapping, before writing past its end.
+  void extend_file(void) {
+    if (::ftruncate(m_fd, static_cast<off_t>(m_capacity * sizeof(T))) != 0) throw_errno("ftruncate");
+    m_file_end = m_capacity;
+  }
+
+  void unmap(void) {
+    if (m_storage != nullptr) ::munmap(m_storage, m_capacity * sizeof(T));
+    m_storage = nullptr;
+    m_capacity = 0;
+  }
+
+  int m_fd{-1};                          //!< The mapped file.
+  map_mode m_mode{map_mode::read_write}; //!< How it was opened.
+  T* m_storage{nullptr};                 //!< The mapping (nullptr while the capacity is 0).
+  size_type m_end{0};                    //!< The number of elements.
+  size_type m_capacity{0};               //!< How many elements fit in the mapping.
+  size_type m_file_end{0};               //!< How many elements the file holds (fewer after a sync()).
+};
+
+} // namespace sc.
+
+#endif
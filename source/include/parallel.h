@@ -0,0 +1,79 @@
+#ifndef _PARALLEL_H_
+#define _PARALLEL_H_
+
+#include <algorithm>    // std::min
+#include <cstddef>      // std::size_t
+#include <exception>    // std::exception_ptr
+#include <thread>       // std::thread
+#include <vector>       // std::vector (the workers of one call)
+
+/// Sequence container namespace.
+namespace sc {
+
+/// Requests a parallel run of a bulk operation, e.g. `vec.assign(sc::par, first, last)`.
+/*!
+ * The elements are split into one contiguous chunk per thread; the calling thread runs the
+ * last chunk and waits for the others. Runs shorter than `threshold` elements stay serial, since
+ * starting threads costs more than copying a few thousand elements.
+ */
+struct parallel_policy {
+  std::size_t threshold{1 << 16};  //!< Fewer elements than this run on the calling thread only.
+  std::size_t min_chunk{1 << 14};  //!< No thread gets fewer elements than this.
+  unsigned threads{0};             //!< How many threads to use; 0 means one per hardware thread.
+};
+
+/// The default parallel policy.
+inline constexpr parallel_policy par{};
+
+namespace detail {
+
+/// How many chunks `n` elements are split into under `policy` (1 means serial).
+inline std::size_t parallel_chunks(std::size_t n, const parallel_policy& policy) {
+  if (n < policy.threshold) return 1;
+  std::size_t threads = policy.threads != 0 ? policy.threads : std::thread::hardware_concurrency();
+  std::size_t by_size = n / std::max<std::size_t>(policy.min_chunk, 1);
+  return std::max<std::size_t>(1, std::min(threads, by_size));
+}
+
+/// First index of chunk `i` out of `chunks` over `n` elements (chunk `chunks` ends at `n`).
+inline std::size_t chunk_begin(std::size_t n, std::size_t chunks, std::size_t i) {
+  // The remainder goes to the first chunks, one element each.
+  return i * (n / chunks) + std::min(i, n % chunks);
+}
+
+/// Calls `fn(chunk, first, last)` for each of the `chunks` parts of [0, n), on as many threads.
+/*!
+ * Every call runs to completion; if some of them throw, the first exception (by chunk order)
+ * is rethrown once all threads have been joined.
+ */
+template <typename Fn>
+void parallel_for_chunks(std::size_t n, std::size_t chunks, Fn fn) {
+  if (chunks <= 1) {
+    fn(std::size_t{0}, std::size_t{0}, n);
+    return;
+  }
+  std::vector<std::exception_ptr> errors(chunks);
+  auto run = [&](std::size_t i) {
+    try { fn(i, chunk_begin(n, chunks, i), chunk_begin(n, chunks, i + 1)); }
+    catch (...) { errors[i] = std::current_exception(); }
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(chunks - 1);
+  try {
+    for (std::size_t i{0}; i + 1 < chunks; ++i) workers.emplace_back(run, i);
+  }
+  catch (...) {
+    // Could not start a thread: run the chunks it would have run here.
+    for (std::size_t i{workers.size()}; i + 1 < chunks; ++i) run(i);
+  }
+  run(chunks - 1);
+  for (auto& w : workers) w.join();
+  for (auto& e : errors)
+    if (e) std::rethrow_exception(e);
+}
+
+} // namespace detail.
+
+} // namespace sc.
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef _POOL_ALLOCATOR_H_
+#define _POOL_ALLOCATOR_H_
+
+#include <cstddef>      // std::size_t, std::max_align_t
+#include <type_traits>  // std::false_type
+
+#include "arena_allocator.h"
+
+/// Sequence container namespace.
+namespace sc {
+
+/// A memory resource that recycles freed chunks through per-size free lists.
+/*!
+ * Requests are rounded up to a power-of-two size class (16 bytes up to `max_pooled` bytes).
+ * A freed chunk goes to the free list of its class and is handed out again by the next request
+ * of that class, so a workload that keeps creating and destroying small vectors stops hitting
+ * the global allocator. Fresh chunks, and requests bigger than `max_pooled`, are carved from
+ * an `sc::arena`. Resetting the pool forgets every chunk at once.
+ */
+class pool {
+ public:
+  static constexpr std::size_t min_chunk = 16;     //!< Smallest size class, in bytes.
+  static constexpr std::size_t max_pooled = 4096;  //!< Biggest size class, in bytes.
+
+  /// Creates a pool that owns its upstream arena.
+  explicit pool(std::size_t block_size = 64 * 1024)
+    : m_own{block_size}, m_upstream{&m_own} { /* empty */ }
+
+  /// Creates a pool on top of an external arena (e.g. a request-scoped one), which must outlive it.
+  explicit pool(arena& upstream) : m_own{0}, m_upstream{&upstream} { /* empty */ }
+
+  pool(const pool&) = delete;
+  pool& operator=(const pool&) = delete;
+
+  /// Returns `bytes` bytes aligned to `align`.
+  void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t)) {
+    if (bytes > max_pooled or align > alignof(std::max_align_t))
+      return m_upstream->allocate(bytes, align);
+    std::size_t c = size_class(bytes);
+    if (m_free[c] != nullptr) {
+      chunk* ch = m_free[c];
+      m_free[c] = ch->next;
+      return ch;
+    }
+    return m_upstream->allocate(min_chunk << c, alignof(std::max_align_t));
+  }
+
+  /// Puts the chunk back in its free list (big chunks stay in the arena until it is reset).
+  void deallocate(void* p, std::size_t bytes, std::size_t align = alignof(std::max_align_t)) noexcept {
+    if (p == nullptr or bytes > max_pooled or align > alignof(std::max_align_t)) return;
+    std::size_t c = size_class(bytes);
+    chunk* ch = static_cast<chunk*>(p);
+    ch->next = m_free[c];
+    m_free[c] = ch;
+  }
+
+  /// Empties the free lists and resets the upstream arena: every chunk is released at once.
+  void reset(void) noexcept {
+    for (auto& head : m_free) head = nullptr;
+    m_upstream->reset();
+  }
+
+  /// The arena that provides the chunks.
+  arena& upstream(void) const noexcept { return *m_upstream; }
+
+ private:
+  /// A free chunk stores the link to the next one in its own memory.
+  struct chunk {
+    chunk* next;
+  };
+
+  static constexpr std::size_t n_classes = 9; //!< 16, 32, ..., 4096 bytes.
+
+  /// Index of the smallest size class that holds `bytes` bytes.
+  static std::size_t size_class(std::size_t bytes) {
+    std::size_t c{0};
+    while ((min_chunk << c) < bytes) ++c;
+    return c;
+  }
+
+  arena m_own;                         //!< Used when no external arena is given.
+  arena* m_upstream;                   //!< Where fresh chunks come from.
+  chunk* m_free[n_classes] = {};       //!< One free list per size class.
+};
+
+/// Standard allocator that takes its memory from an `sc::pool`.
+/*!
+ * Like `sc::arena_allocator`, it compares equal only to allocators of the same pool and never
+ * propagates, so containers never mix chunks of different pools.
+ *
+ * \tparam T The type of the allocated objects.
+ */
+template <typename T>
+class pool_allocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+  using is_always_equal = std::false_type;
+
+  /// Creates an allocator drawing from `p`, which must outlive it.
+  pool_allocator(pool& p) noexcept : m_pool{&p} { /* empty */ }
+
+  /// Rebinding constructor.
+  template <typename U>
+  pool_allocator(const pool_allocator<U>& other) noexcept : m_pool{other.get_pool()} { /* empty */ }
+
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(m_pool->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept { m_pool->deallocate(p, n * sizeof(T), alignof(T)); }
+
+  /// Returns the pool this allocator draws from.
+  pool* get_pool(void) const noexcept { return m_pool; }
+
+  template <typename U>
+  friend bool operator==(const pool_allocator& a, const pool_allocator<U>& b) noexcept {
+    return a.get_pool() == b.get_pool();
+  }
+  template <typename U>
+  friend bool operator!=(const pool_allocator& a, const pool_allocator<U>& b) noexcept {
+    return a.get_pool() != b.get_pool();
+  }
+
+ private:
+  pool* m_pool; //!< Where the memory comes from.
+};
+
+} // namespace sc.
+
+#endif
@@ -0,0 +1,197 @@
+#ifndef _SERIALIZATION_H_
+#define _SERIALIZATION_H_
+
+#include <cstddef>      // std::size_t, std::byte
+#include <algorithm>    // std::min, std::max
+#include <cstdint>      // std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t
+#include <ios>          // std::ios
+#include <istream>      // std::istream
+#include <ostream>      // std::ostream
+#include <stdexcept>    // std::runtime_error
+#include <string>       // std::basic_string
+#include <type_traits>  // std::is_trivially_copyable_v
+
+// The binary format written by `sc::vector::write_to` and read by `sc::vector::read_from`:
+//
+//     offset  size  field
+//          0     4  magic "SCVB"
+//          4     2  format version (1)
+//          6     1  byte order of the payload: 1 little endian, 2 big endian
+//          7     1  layout: 0 raw elements, 1 length-prefixed strings
+//          8     4  element size: sizeof(T) for raw elements, sizeof(CharT) for strings
+//         12     8  element count
+//         20        payload
+//
+// The header fields are always little endian. A raw payload is the elements' bytes as they are
+// in memory, so it is written and read with a single call; a string payload is, for each
+// string, its length (8 bytes, little endian) followed by its characters.
+//
+// The counts and lengths are not trusted when reading: from a stream that can seek, each one is
+// checked against the bytes left before anything is allocated; from one that cannot, the data
+// is read in chunks of at most 1 MiB, so a corrupt count runs out of data (and throws) before
+// much more than what the stream holds is allocated.
+
+/// Sequence container namespace.
+namespace sc {
+
+/// A read-only view of the bytes of a contiguous range of trivially copyable objects.
+struct byte_view {
+  const std::byte* m_data{nullptr};
+  std::size_t m_size{0};
+
+  const std::byte* data(void) const { return m_data; }
+  std::size_t size(void) const { return m_size; }
+  bool empty(void) const { return m_size == 0; }
+  const std::byte* begin(void) const { return m_data; }
+  const std::byte* end(void) const { return m_data + m_size; }
+};
+
+/// Thrown by `read_from` when the stream does not hold what is expected.
+class serialization_error : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+namespace detail {
+
+enum class binary_layout : std::uint8_t { raw = 0, strings = 1 };
+
+/// How the elements of a `T` vector are laid out, if they can be serialized at all.
+template <typename T>
+struct binary_traits {
+  static constexpr bool supported = std::is_trivially_copyable_v<T>;
+  static constexpr binary_layout layout = binary_layout::raw;
+  static constexpr std::size_t unit_size = sizeof(T);
+};
+template <typename CharT, typename Traits, typename Alloc>
+struct binary_traits<std::basic_string<CharT, Traits, Alloc>> {
+  static constexpr bool supported = std::is_trivially_copyable_v<CharT>;
+  static constexpr binary_layout layout = binary_layout::strings;
+  static constexpr std::size_t unit_size = sizeof(CharT);
+};
+
+inline constexpr char binary_magic[4]{'S', 'C', 'V', 'B'};
+inline constexpr std::uint16_t binary_version{1};
+inline constexpr std::size_t binary_header_size{20};
+
+/// 1 on little endian machines, 2 on big endian ones.
+inline std::uint8_t native_byte_order(void) {
+  const std::uint16_t probe{1};
+  return *reinterpret_cast<const unsigned char*>(&probe) == 1 ? 1 : 2;
+}
+
+/// Stores `value` little endian in `out[0, n)`.
+inline void put_le(unsigned char* out, std::uint64_t value, std::size_t n) {
+  for (std::size_t i{0}; i < n; ++i) out[i] = static_cast<unsigned char>(value >> (8 * i));
+}
+inline std::uint64_t get_le(const unsigned char* in, std::size_t n) {
+  std::uint64_t value{0};
+  for (std::size_t i{0}; i < n; ++i) value |= std::uint64_t{in[i]} << (8 * i);
+  return value;
+}
+
+/// Writes the header of a vector of `count` elements laid out as `layout`.
+inline void write_binary_header(std::ostream& os, binary_layout layout, std::size_t unit_size, std::size_t count) {
+  unsigned char header[binary_header_size];
+  for (std::size_t i{0}; i < 4; ++i) header[i] = static_cast<unsigned char>(binary_magic[i]);
+  put_le(header + 4, binary_version, 2);
+  header[6] = native_byte_order();
+  header[7] = static_cast<unsigned char>(layout);
+  put_le(header + 8, unit_size, 4);
+  put_le(header + 12, count, 8);
+  os.write(reinterpret_cast<const char*>(header), binary_header_size);
+}
+
+/// Reads and checks a header; returns the element count.
+inline std::size_t read_binary_header(std::istream& is, binary_layout layout, std::size_t unit_size) {
+  unsigned char header[binary_header_size];
+  if (!is.read(reinterpret_cast<char*>(header), binary_header_size))
+    throw serialization_error{"sc::vector::read_from: truncated header"};
+  for (std::size_t i{0}; i < 4; ++i)
+    if (header[i] != static_cast<unsigned char>(binary_magic[i]))
+      throw serialization_error{"sc::vector::read_from: not a serialized sc::vector"};
+  if (get_le(header + 4, 2) != binary_version)
+    throw serialization_error{"sc::vector::read_from: unsupported format version"};
+  if (header[7] != static_cast<unsigned char>(layout) || get_le(header + 8, 4) != unit_size)
+    throw serialization_error{"sc::vector::read_from: the stream holds another element type"};
+  // Single bytes read the same in any byte order.
+  if (header[6] != native_byte_order() && unit_size > 1)
+    throw serialization_error{"sc::vector::read_from: the stream was written with another byte order"};
+  return static_cast<std::size_t>(get_le(header + 12, 8));
+}
+
+/// A stream being read, and (when it can seek) how many bytes are left in it.
+class binary_source {
+ public:
+  /// The most memory a read makes room for ahead of the data, from a stream that cannot seek.
+  static constexpr std::size_t chunk_bytes{std::size_t{1} << 20};
+
+  explicit binary_source(std::istream& is) : m_is{is} {
+    std::istream::pos_type here = is.tellg();
+    if (here == std::istream::pos_type(-1)) return;
+    std::istream::pos_type end = is.seekg(0, std::ios::end).tellg();
+    is.clear();
+    is.seekg(here);
+    if (end != std::istream::pos_type(-1) && is) {
+      m_known = true;
+      m_left = static_cast<std::uint64_t>(end - here);
+    }
+  }
+
+  /// How many of `count` items, of at least `unit_size` bytes each, to make room for at once.
+  /*!
+   * All of them if the stream can seek, once they are known to fit in what is left of it
+   * (throws `serialization_error` if they cannot); at most `chunk_bytes` worth otherwise.
+   */
+  std::size_t batch(std::uint64_t count, std::size_t unit_size) const {
+    if (m_known) {
+      if (count > m_left / unit_size)
+        throw serialization_error{"sc::vector::read_from: a count is larger than the data left"};
+      return static_cast<std::size_t>(count);
+    }
+    return static_cast<std::size_t>(std::min<std::uint64_t>(count, std::max<std::size_t>(1, chunk_bytes / unit_size)));
+  }
+
+  /// Reads `bytes` bytes into `dest`; throws `serialization_error` (with `what`) if the stream ends first.
+  void read(void* dest, std::size_t bytes, const char* what) {
+    if (!m_is.read(static_cast<char*>(dest), static_cast<std::streamsize>(bytes))) throw serialization_error{what};
+    if (m_known) m_left -= bytes;
+  }
+
+ private:
+  std::istream& m_is;
+  bool m_known{false};     //!< Whether the stream could tell its length.
+  std::uint64_t m_left{0}; //!< The bytes left to read (when known).
+};
+
+/// Writes one length-prefixed string.
+template <typename String>
+void write_binary_string(std::ostream& os, const String& s) {
+  unsigned char length[8];
+  put_le(length, s.size(), 8);
+  os.write(reinterpret_cast<const char*>(length), 8);
+  os.write(reinterpret_cast<const char*>(s.data()), s.size() * sizeof(typename String::value_type));
+}
+
+/// Reads one length-prefixed string into `s`.
+template <typename String>
+void read_binary_string(binary_source& in, String& s) {
+  using char_type = typename String::value_type;
+  unsigned char length[8];
+  in.read(length, 8, "sc::vector::read_from: truncated string");
+  std::uint64_t size = get_le(length, 8);
+  std::size_t batch = in.batch(size, sizeof(char_type));
+  s.clear();
+  for (std::size_t done{0}; done < size; ) {
+    std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(batch, size - done));
+    s.resize(done + n);
+    in.read(s.data() + done, n * sizeof(char_type), "sc::vector::read_from: truncated string");
+    done += n;
+  }
+}
+
+} // namespace detail.
+
+} // namespace sc.
+
+#endif
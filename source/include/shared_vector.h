@@ -0,0 +1,191 @@
+#ifndef _SHARED_VECTOR_H_
+#define _SHARED_VECTOR_H_
+
+#include <atomic>       // std::atomic
+#include <cstddef>      // std::size_t
+#include <initializer_list> // std::initializer_list
+#include <stdexcept>    // std::out_of_range
+#include <utility>      // std::forward, std::move, std::swap, std::exchange
+
+#include "vector.h"     // sc::vector, sc::MyForwardIterator
+
+/// Sequence container namespace.
+namespace sc {
+
+/// A vector whose copies share one buffer until one of them is modified (copy-on-write).
+/*!
+ * Copying or assigning a `shared_vector` only bumps an atomic reference count, so passing a
+ * big read-mostly table by value costs O(1). The first modification through a copy whose buffer
+ * is shared makes it a private copy first (O(n), once); a copy that owns its buffer alone is
+ * modified in place, as a plain vector would be.
+ *
+ *     sc::shared_vector<rule> table{ load_rules() };   // Adopts the sc::vector.
+ *     std::thread worker{ [table] { use(table[0]); } }; // No element is copied.
+ *
+ * Different `shared_vector` objects may be used from different threads at once, even when they
+ * share a buffer; a single object needs the same synchronization as a vector.
+ *
+ * Only `const` access hands out references to the elements. Changes go through the modifiers,
+ * `set`, or `edit()`, which returns the private vector; references obtained from that one must
+ * not be kept past the next copy of this object.
+ */
+template <typename T>
+class shared_vector {
+ public:
+  using size_type = typename vector<T>::size_type;
+  using value_type = T;
+  using const_reference = const T&;
+  using const_iterator = MyForwardIterator<const T>;
+  using iterator = const_iterator;  //!< Elements are only read through iterators.
+
+  // [I] Special members
+  shared_vector(void) = default;
+
+  //Adopts the elements of `items` without copying them.
+  explicit shared_vector(vector<T> items) : m_block{new block{std::move(items)}} { /* empty */ }
+
+  shared_vector(std::initializer_list<T> il) : shared_vector(vector<T>(il)) { /* empty */ }
+
+  template <typename InputItr, typename = require_input_iterator<InputItr>>
+  shared_vector(InputItr first, InputItr last) : shared_vector(vector<T>(first, last)) { /* empty */ }
+
+  //Shares the buffer of `other`: O(1).
+  shared_vector(const shared_vector& other) noexcept : m_block{acquire(other.m_block)} { /* empty */ }
+
+  shared_vector(shared_vector&& other) noexcept : m_block{std::exchange(other.m_block, nullptr)} { /* empty */ }
+
+  shared_vector& operator=(shared_vector other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~shared_vector(void) { release(m_block); }
+
+  void swap(shared_vector& other) noexcept { std::swap(m_block, other.m_block); }
+  friend void swap(shared_vector& a, shared_vector& b) noexcept { a.swap(b); }
+
+  // [II] Iterators
+  const_iterator begin(void) const { return const_iterator{data()}; }
+  const_iterator end(void) const { return const_iterator{data() + size()}; }
+  const_iterator cbegin(void) const { return begin(); }
+  const_iterator cend(void) const { return end(); }
+
+  // [III] Capacity
+  size_type size(void) const { return m_block == nullptr ? 0 : m_block->items.size(); }
+  size_type capacity(void) const { return m_block == nullptr ? 0 : m_block->items.capacity(); }
+  bool empty(void) const { return size() == 0; }
+
+  //How many shared_vector objects use this buffer (0 for an empty vector that never had one).
+  size_type use_count(void) const {
+    return m_block == nullptr ? 0 : m_block->refs.load(std::memory_order_acquire);
+  }
+
+  //Whether this vector and `other` share a buffer.
+  bool shares_with(const shared_vector& other) const { return m_block != nullptr && m_block == other.m_block; }
+
+  // [IV] Element access (read-only)
+  const_reference operator[](size_type idx) const { return m_block->items[idx]; }
+  const_reference at(size_type idx) const {
+    if (idx >= size()) throw std::out_of_range{"The method 'at' cannot access this index"};
+    return m_block->items[idx];
+  }
+  const_reference front(void) const { return at(0); }
+  const_reference back(void) const { return at(size() - 1); }
+  const T* data(void) const { return m_block == nullptr ? nullptr : m_block->items.data(); }
+
+  //The elements as a plain vector (a copy).
+  vector<T> to_vector(void) const { return m_block == nullptr ? vector<T>{} : m_block->items; }
+
+  // [V] Modifiers: each one first makes the buffer private, if it is shared.
+  //The private vector, for changes the other modifiers do not cover.
+  vector<T>& edit(void) {
+    retired old{detach()};
+    return m_block->items;
+  }
+
+  void set(size_type idx, const T& value) {
+    if (idx >= size()) throw std::out_of_range{"The method 'set' cannot access this index"};
+    retired old{detach()}; // Keeps `value` alive, should it live in the old buffer.
+    m_block->items[idx] = value;
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  void emplace_back(Args&&... args) {
+    retired old{detach()};
+    m_block->items.emplace_back(std::forward<Args>(args)...);
+  }
+
+  void pop_back(void) {
+    if (empty()) return;
+    retired old{detach()};
+    m_block->items.pop_back();
+  }
+
+  void resize(size_type count) {
+    retired old{detach()};
+    m_block->items.resize(count);
+  }
+
+  void reserve(size_type new_cap) {
+    retired old{detach()};
+    m_block->items.reserve(new_cap);
+  }
+
+  //Empties this vector; a shared buffer is left to the other copies, not copied.
+  void clear(void) {
+    if (use_count() > 1) release(std::exchange(m_block, nullptr));
+    else if (m_block != nullptr) m_block->items.clear();
+  }
+
+  friend bool operator==(const shared_vector& a, const shared_vector& b) {
+    if (a.m_block == b.m_block) return true;
+    if (a.size() != b.size()) return false;
+    return a.size() == 0 || a.m_block->items == b.m_block->items;
+  }
+  friend bool operator!=(const shared_vector& a, const shared_vector& b) { return !(a == b); }
+
+ private:
+  /// The shared buffer: the elements and the number of shared_vector objects that use them.
+  struct block {
+    explicit block(vector<T>&& v) : items{std::move(v)} { /* empty */ }
+    std::atomic<size_type> refs{1};
+    vector<T> items;
+  };
+
+  /// Releases a block when it goes out of scope: the old buffer stays alive while an operation
+  /// may still read from it (e.g. `v.push_back(v[0])` on a shared buffer).
+  struct retired {
+    block* m_block;
+    ~retired(void) { release(m_block); }
+  };
+
+  static block* acquire(block* b) noexcept {
+    if (b != nullptr) b->refs.fetch_add(1, std::memory_order_relaxed);
+    return b;
+  }
+
+  static void release(block* b) noexcept {
+    // The last owner must see every write made through the others before destroying the block.
+    if (b != nullptr && b->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete b;
+  }
+
+  /// Makes `m_block` a buffer that only this object uses; returns the block given up (or nullptr).
+  block* detach(void) {
+    if (m_block == nullptr) {
+      m_block = new block{vector<T>{}};
+      return nullptr;
+    }
+    if (m_block->refs.load(std::memory_order_acquire) == 1) return nullptr;
+    block* copy = new block{vector<T>(m_block->items)};
+    return std::exchange(m_block, copy);
+  }
+
+  block* m_block{nullptr}; //!< The (possibly shared) buffer; nullptr until the first element.
+};
+
+} // namespace sc.
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef _SMALL_VECTOR_H_
+#define _SMALL_VECTOR_H_
+
+#include <cstddef>      // std::size_t
+#include <memory>       // std::allocator
+
+#include "vector.h"
+
+/// Sequence container namespace.
+namespace sc {
+
+/// A vector that keeps up to `N` elements inside the object itself.
+/*!
+ * `sc::small_vector<T, N>` has exactly the interface of `sc::vector<T>` (it *is* an `sc::vector`
+ * with an inline buffer): iterators, `insert`/`erase`/`assign`, `==`/`!=`, and so on.
+ * While `size() <= N` no memory is requested from the allocator, not even by the default
+ * constructor, and `capacity()` is `N`. Beyond that the elements spill to the heap and the vector
+ * grows as usual; `shrink_to_fit()` brings them back inline once they fit again.
+ *
+ * Moving or swapping a small_vector whose elements are inline moves the elements themselves
+ * (O(N)), since they cannot change hands like a heap buffer does.
+ *
+ * \tparam T The type of the elements.
+ * \tparam N How many elements fit inline.
+ * \tparam Allocator Provides the storage once the inline buffer is exceeded.
+ * \tparam GrowthPolicy How the heap buffer grows (see growth_policy.h).
+ */
+template <typename T, std::size_t N, typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = doubling_growth>
+using small_vector = vector<T, Allocator, N, GrowthPolicy>;
+
+} // namespace sc.
+
+#endif
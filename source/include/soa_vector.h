@@ -0,0 +1,400 @@
+#ifndef _SOA_VECTOR_H_
+#define _SOA_VECTOR_H_
+
+#include <algorithm>    // std::max
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <cstring>      // std::memcpy
+#include <initializer_list> // std::initializer_list
+#include <iterator>     // std::input_iterator_tag
+#include <memory>       // std::uninitialized_move_n, std::destroy_n
+#include <new>          // ::operator new(std::align_val_t)
+#include <stdexcept>    // std::out_of_range
+#include <tuple>        // std::tuple, std::get, std::apply
+#include <type_traits>  // std::conditional_t
+#include <utility>      // std::index_sequence, std::forward, std::move
+
+#include "vector.h"         // sc::vector_view, sc::is_trivially_relocatable
+#include "growth_policy.h"  // sc::doubling_growth
+
+/// Sequence container namespace.
+namespace sc {
+
+/// A view of one column of an `soa_vector`.
+template <typename T>
+using column_view = vector_view<T>;
+
+/// A sequence of records stored as a structure of arrays: one contiguous column per field.
+/*!
+ * `soa_vector<float, float, int>` holds what a `vector<std::tuple<float, float, int>>` would,
+ * but a loop over one field streams one dense array instead of striding over whole records.
+ * The columns share a single allocation; each one starts on a `column_alignment` boundary so
+ * it can be loaded with aligned SIMD instructions.
+ *
+ *     sc::soa_vector<float, float, int> particles;
+ *     particles.emplace_back(1.0f, 2.0f, 7);
+ *     for (float& x : particles.column<0>()) x += 1.0f;
+ *     for (auto [x, y, id] : particles) ...
+ */
+template <typename... Ts>
+class soa_vector {
+  static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+  using columns = std::index_sequence_for<Ts...>;
+
+ public:
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using value_type = std::tuple<Ts...>;           //!< A record, by value.
+  using reference = std::tuple<Ts&...>;           //!< A record, as references into the columns.
+  using const_reference = std::tuple<const Ts&...>;
+  template <std::size_t I>
+  using column_type = std::tuple_element_t<I, value_type>;
+
+  static constexpr std::size_t column_alignment = 64;  //!< Every column starts on a cache line.
+
+  /// Walks the rows, yielding a tuple of references (a proxy, so it is only an input iterator
+  /// to the standard library; it still supports the random access operations of MyForwardIterator).
+  template <bool Const>
+  class zip_iterator {
+    using owner = std::conditional_t<Const, const soa_vector, soa_vector>;
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+#if __cplusplus >= 202002L
+    using iterator_concept = std::random_access_iterator_tag;
+#endif
+    using value_type = soa_vector::value_type;
+    using reference = std::conditional_t<Const, soa_vector::const_reference, soa_vector::reference>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+
+    zip_iterator(owner* o = nullptr, size_type idx = 0) : m_owner{o}, m_idx{idx} { /* empty */ }
+    zip_iterator(const zip_iterator<false>& other) : m_owner{other.m_owner}, m_idx{other.m_idx} { /* empty */ }
+
+    reference operator*(void) const { return (*m_owner)[m_idx]; }
+    reference operator[](difference_type offset) const { return (*m_owner)[m_idx + offset]; }
+
+    zip_iterator& operator++(void) { ++m_idx; return *this; }
+    zip_iterator operator++(int) { zip_iterator temp{*this}; ++m_idx; return temp; }
+    zip_iterator& operator--(void) { --m_idx; return *this; }
+    zip_iterator operator--(int) { zip_iterator temp{*this}; --m_idx; return temp; }
+    zip_iterator& operator+=(difference_type offset) { m_idx += offset; return *this; }
+    zip_iterator& operator-=(difference_type offset) { m_idx -= offset; return *this; }
+    friend zip_iterator operator+(zip_iterator it, difference_type offset) { return it += offset; }
+    friend zip_iterator operator+(difference_type offset, zip_iterator it) { return it += offset; }
+    friend zip_iterator operator-(zip_iterator it, difference_type offset) { return it -= offset; }
+    friend difference_type operator-(const zip_iterator& a, const zip_iterator& b) {
+      return static_cast<difference_type>(a.m_idx) - static_cast<difference_type>(b.m_idx);
+    }
+
+    friend bool operator==(const zip_iterator& a, const zip_iterator& b) { return a.m_idx == b.m_idx; }
+    friend bool operator!=(const zip_iterator& a, const zip_iterator& b) { return a.m_idx != b.m_idx; }
+    friend bool operator<(const zip_iterator& a, const zip_iterator& b) { return a.m_idx < b.m_idx; }
+    friend bool operator>(const zip_iterator& a, const zip_iterator& b) { return a.m_idx > b.m_idx; }
+    friend bool operator<=(const zip_iterator& a, const zip_iterator& b) { return a.m_idx <= b.m_idx; }
+    friend bool operator>=(const zip_iterator& a, const zip_iterator& b) { return a.m_idx >= b.m_idx; }
+
+   private:
+    template <bool> friend class zip_iterator;
+    owner* m_owner;
+    size_type m_idx;
+  };
+
+  using iterator = zip_iterator<false>;
+  using const_iterator = zip_iterator<true>;
+
+  // [I] Special members
+  soa_vector(void) = default;
+
+  soa_vector(std::initializer_list<value_type> il) {
+    append_or_release(il.size(), [&](size_type i) { push_back(il.begin()[i]); });
+  }
+
+  soa_vector(const soa_vector& other) {
+    append_or_release(other.m_end, [&](size_type i) { push_back(other.row_copy(i)); });
+  }
+
+  soa_vector(soa_vector&& other) noexcept { swap(other); }
+
+  soa_vector& operator=(soa_vector other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~soa_vector(void) {
+    clear();
+    release(m_block, m_capacity);
+  }
+
+  void swap(soa_vector& other) noexcept {
+    std::swap(m_block, other.m_block);
+    std::swap(m_columns, other.m_columns);
+    std::swap(m_end, other.m_end);
+    std::swap(m_capacity, other.m_capacity);
+  }
+  friend void swap(soa_vector& a, soa_vector& b) noexcept { a.swap(b); }
+
+  // [II] Iterators
+  iterator begin(void) { return iterator{this, 0}; }
+  iterator end(void) { return iterator{this, m_end}; }
+  const_iterator begin(void) const { return cbegin(); }
+  const_iterator end(void) const { return cend(); }
+  const_iterator cbegin(void) const { return const_iterator{this, 0}; }
+  const_iterator cend(void) const { return const_iterator{this, m_end}; }
+
+  // [III] Capacity
+  size_type size(void) const { return m_end; }
+  size_type capacity(void) const { return m_capacity; }
+  bool empty(void) const { return m_end == 0; }
+
+  void reserve(size_type new_cap) {
+    if (new_cap > m_capacity) reallocate(new_cap);
+  }
+
+  void shrink_to_fit(void) {
+    if (m_capacity > m_end) reallocate(m_end);
+  }
+
+  // [IV] Modifiers
+  void clear(void) {
+    destroy_rows(m_columns, 0, m_end, columns{});
+    m_end = 0;
+  }
+
+  void push_back(const value_type& row) {
+    std::apply([this](const Ts&... fields) { emplace_back(fields...); }, row);
+  }
+  void push_back(value_type&& row) {
+    std::apply([this](Ts&... fields) { emplace_back(std::move(fields)...); }, row);
+  }
+
+  //Appends a row whose fields are built from `args`, one argument per column.
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    static_assert(sizeof...(Args) == sizeof...(Ts), "emplace_back takes one argument per column");
+    if (m_end == m_capacity) {
+      // Build the row aside first: the arguments may refer to the current columns.
+      value_type row(std::forward<Args>(args)...);
+      reallocate(doubling_growth::next_capacity(m_capacity, m_end + 1, row_size));
+      std::apply([this](Ts&... fields) { construct_row<0>(m_end, std::move(fields)...); }, row);
+    }
+    else
+      construct_row<0>(m_end, std::forward<Args>(args)...);
+    return (*this)[m_end++];
+  }
+
+  void pop_back(void) {
+    if (m_end > 0) {
+      --m_end;
+      destroy_rows(m_columns, m_end, 1, columns{});
+    }
+  }
+
+  //Resizes to `count` rows; new fields are value-initialized.
+  void resize(size_type count) {
+    if (count > m_capacity) reallocate(std::max(count, doubling_growth::next_capacity(m_capacity, count, row_size)));
+    while (m_end < count) emplace_back(Ts{}...);
+    if (count < m_end) {
+      destroy_rows(m_columns, count, m_end - count, columns{});
+      m_end = count;
+    }
+  }
+
+  //Removes row `idx` in O(1) by moving the last row into its place.
+  void erase_unordered(size_type idx) {
+    if (idx >= m_end) throw std::out_of_range{"The method 'erase_unordered' cannot access this row"};
+    if (idx != m_end - 1) move_row(idx, m_end - 1, columns{});
+    pop_back();
+  }
+
+  // [V] Element access
+  reference operator[](size_type idx) { return row(idx, columns{}); }
+  const_reference operator[](size_type idx) const { return row(idx, columns{}); }
+
+  reference at(size_type idx) {
+    if (idx >= m_end) throw std::out_of_range{"The method 'at' cannot access this row"};
+    return (*this)[idx];
+  }
+  const_reference at(size_type idx) const {
+    if (idx >= m_end) throw std::out_of_range{"The method 'at' cannot access this row"};
+    return (*this)[idx];
+  }
+
+  reference front(void) { return at(0); }
+  const_reference front(void) const { return at(0); }
+  reference back(void) { return at(m_end - 1); }
+  const_reference back(void) const { return at(m_end - 1); }
+
+  //The I-th column: one contiguous, `column_alignment`-aligned array of `size()` fields.
+  template <std::size_t I>
+  column_view<column_type<I>> column(void) { return {std::get<I>(m_columns), m_end}; }
+  template <std::size_t I>
+  column_view<const column_type<I>> column(void) const { return {std::get<I>(m_columns), m_end}; }
+
+  template <std::size_t I>
+  column_type<I>* data(void) { return std::get<I>(m_columns); }
+  template <std::size_t I>
+  const column_type<I>* data(void) const { return std::get<I>(m_columns); }
+
+  friend bool operator==(const soa_vector& a, const soa_vector& b) {
+    if (a.m_end != b.m_end) return false;
+    for (size_type i{0}; i < a.m_end; ++i)
+      if (!(a[i] == b[i])) return false;
+    return true;
+  }
+  friend bool operator!=(const soa_vector& a, const soa_vector& b) { return !(a == b); }
+
+ private:
+  using column_pointers = std::tuple<Ts*...>;
+
+  static constexpr std::size_t row_size = (sizeof(Ts) + ...);
+
+  static constexpr std::size_t align_up(std::size_t n, std::size_t a) { return (n + a - 1) / a * a; }
+
+  /// Bytes of a block holding `cap` rows, each column starting on an aligned offset.
+  static std::size_t block_size(size_type cap) {
+    std::size_t bytes{0};
+    ((bytes = align_up(bytes, std::max(column_alignment, alignof(Ts))) + cap * sizeof(Ts)), ...);
+    return bytes;
+  }
+
+  /// The column pointers into a block of `cap` rows.
+  template <std::size_t... I>
+  static column_pointers carve(unsigned char* block, size_type cap, std::index_sequence<I...>) {
+    column_pointers cols{};
+    std::size_t offset{0};
+    ((offset = align_up(offset, std::max(column_alignment, alignof(Ts))),
+      std::get<I>(cols) = reinterpret_cast<Ts*>(block + offset),
+      offset += cap * sizeof(Ts)), ...);
+    return cols;
+  }
+
+  static unsigned char* acquire(size_type cap) {
+    if (cap == 0) return nullptr;
+    return static_cast<unsigned char*>(::operator new(block_size(cap), std::align_val_t{column_alignment}));
+  }
+  static void release(unsigned char* block, size_type cap) {
+    if (block != nullptr) ::operator delete(block, block_size(cap), std::align_val_t{column_alignment});
+  }
+
+  template <std::size_t... I>
+  reference row(size_type idx, std::index_sequence<I...>) { return reference{std::get<I>(m_columns)[idx]...}; }
+  template <std::size_t... I>
+  const_reference row(size_type idx, std::index_sequence<I...>) const {
+    return const_reference{std::get<I>(m_columns)[idx]...};
+  }
+  value_type row_copy(size_type idx) const { return value_type{(*this)[idx]}; }
+
+  /// Constructor helper: appends `count` rows with `append(i)`, cleaning up if one throws
+  /// (the destructor does not run for an object whose constructor failed).
+  template <typename Append>
+  void append_or_release(size_type count, Append append) {
+    try {
+      reserve(count);
+      for (size_type i{0}; i < count; ++i) append(i);
+    }
+    catch (...) {
+      clear();
+      release(m_block, m_capacity);
+      throw;
+    }
+  }
+
+  /// Builds the fields I, I+1, ... of row `idx`; if one throws, the ones already built are destroyed.
+  template <std::size_t I, typename Arg, typename... Rest>
+  void construct_row(size_type idx, Arg&& arg, Rest&&... rest) {
+    using T = column_type<I>;
+    T* slot = std::get<I>(m_columns) + idx;
+    ::new (static_cast<void*>(slot)) T(std::forward<Arg>(arg));
+    if constexpr (sizeof...(Rest) > 0) {
+      try { construct_row<I + 1>(idx, std::forward<Rest>(rest)...); }
+      catch (...) { std::destroy_at(slot); throw; }
+    }
+  }
+
+  template <std::size_t... I>
+  static void destroy_rows(const column_pointers& cols, size_type first, size_type count, std::index_sequence<I...>) {
+    (std::destroy_n(std::get<I>(cols) + first, count), ...);
+  }
+
+  template <std::size_t... I>
+  void move_row(size_type to, size_type from, std::index_sequence<I...>) {
+    ((std::get<I>(m_columns)[to] = std::move(std::get<I>(m_columns)[from])), ...);
+  }
+
+  /// Moves (or copies, if moving may throw) the first `m_end` fields of column I into `to`.
+  template <std::size_t I>
+  void relocate_column(const column_pointers& to) {
+    using T = column_type<I>;
+    T* src = std::get<I>(m_columns);
+    T* dst = std::get<I>(to);
+    if constexpr (is_trivially_relocatable_v<T>) {
+      if (m_end > 0) std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), m_end * sizeof(T));
+    }
+    else if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+      std::uninitialized_move_n(src, m_end, dst);
+    else
+      std::uninitialized_copy_n(src, m_end, dst);
+  }
+
+  /// Relocates columns I, I+1, ...; if one throws, the columns already relocated are put back.
+  template <std::size_t I>
+  void relocate_columns(const column_pointers& to) {
+    if constexpr (I < sizeof...(Ts)) {
+      relocate_column<I>(to);
+      try { relocate_columns<I + 1>(to); }
+      catch (...) { restore_column<I>(to); throw; }
+    }
+  }
+
+  /// Undoes `relocate_column<I>`, so the old column holds its fields again.
+  /*!
+   * Bitwise-relocated fields are still owned by the old column: the new bytes are just dropped
+   * with the new block. Copied ones are destroyed. Moved ones are moved back first (moving
+   * cannot throw there), since the old column only holds what they were moved from.
+   */
+  template <std::size_t I>
+  void restore_column(const column_pointers& to) noexcept {
+    using T = column_type<I>;
+    T* src = std::get<I>(m_columns);
+    T* dst = std::get<I>(to);
+    if constexpr (is_trivially_relocatable_v<T>) return;
+    else {
+      if constexpr (std::is_nothrow_move_constructible_v<T>) {
+        std::destroy_n(src, m_end);
+        std::uninitialized_move_n(dst, m_end, src);
+      }
+      std::destroy_n(dst, m_end);
+    }
+  }
+
+  /// Drops the old columns after `relocate_columns` (bitwise-relocated fields need no destructor).
+  template <std::size_t... I>
+  void drop_old_columns(std::index_sequence<I...>) {
+    (drop_old_column<I>(), ...);
+  }
+  template <std::size_t I>
+  void drop_old_column(void) {
+    if constexpr (!is_trivially_relocatable_v<column_type<I>>) std::destroy_n(std::get<I>(m_columns), m_end);
+  }
+
+  void reallocate(size_type new_cap) {
+    unsigned char* block = acquire(new_cap);
+    column_pointers cols = carve(block, new_cap, columns{});
+    try { relocate_columns<0>(cols); }
+    catch (...) { release(block, new_cap); throw; }
+    drop_old_columns(columns{});
+    release(m_block, m_capacity);
+    m_block = block;
+    m_columns = cols;
+    m_capacity = new_cap;
+  }
+
+  unsigned char* m_block{nullptr};  //!< The single allocation holding every column.
+  column_pointers m_columns{};      //!< Where each column starts in `m_block`.
+  size_type m_end{0};               //!< The number of rows.
+  size_type m_capacity{0};          //!< How many rows fit in `m_block`.
+};
+
+} // namespace sc.
+
+#endif
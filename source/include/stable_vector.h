@@ -0,0 +1,236 @@
+#ifndef _STABLE_VECTOR_H_
+#define _STABLE_VECTOR_H_
+
+#include <algorithm>    // std::move, std::rotate, std::equal
+#include <cstddef>      // std::size_t
+#include <initializer_list> // std::initializer_list
+#include <iterator>     // std::distance
+#include <memory>       // std::allocator, std::destroy_at
+#include <new>          // placement new
+#include <stdexcept>    // std::out_of_range
+#include <string>       // std::string
+#include <utility>      // std::forward, std::move, std::swap
+
+#include "vector.h"         // sc::vector, sc::require_input_iterator
+#include "index_iterator.h" // sc::index_iterator
+
+/// Sequence container namespace.
+namespace sc {
+
+/// Elements per chunk of a `stable_vector<T>` by default: a power of two near 4 KiB of elements (at least 16).
+template <typename T>
+constexpr std::size_t stable_vector_chunk(void) {
+  std::size_t n{16};
+  while (n * 2 * sizeof(T) <= 4096) n *= 2;
+  return n;
+}
+
+/// A vector made of fixed-size chunks: growing adds a chunk and never moves an element.
+/*!
+ * A `push_back` on a full `sc::vector` copies the whole buffer and holds the old and the new
+ * one at once, so a single call may take time (and memory) proportional to the size. Here the
+ * elements live in chunks of `ChunkSize` slots, found through a table of chunk pointers: growth
+ * allocates one chunk (and, rarely, reallocates the small table), so every append costs about
+ * the same and references to elements stay valid until the element is erased.
+ *
+ * The interface is the vector's, without `data()`: indexing is a shift and a mask away, and the
+ * iterators are random access but not contiguous. `insert` and `erase` shift the elements after
+ * the position, as in a vector, and only invalidate references from there on.
+ *
+ * \tparam ChunkSize Slots per chunk; a power of two.
+ */
+template <typename T, std::size_t ChunkSize = stable_vector_chunk<T>()>
+class stable_vector {
+  static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize must be a power of two");
+
+ public:
+  using size_type = std::size_t;
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = index_iterator<stable_vector, T>;
+  using const_iterator = index_iterator<const stable_vector, const T>;
+
+  static constexpr size_type chunk_size = ChunkSize;
+
+  // [I] Special members
+  stable_vector(void) = default;
+
+  stable_vector(std::initializer_list<T> il) : stable_vector(il.begin(), il.end()) { /* empty */ }
+
+  template <typename InputItr, typename = require_input_iterator<InputItr>>
+  stable_vector(InputItr first, InputItr last) {
+    try {
+      if constexpr (is_forward_iterator_v<InputItr>) reserve(std::distance(first, last));
+      for (; first != last; ++first) emplace_back(*first);
+    }
+    catch (...) { release(); throw; }
+  }
+
+  stable_vector(const stable_vector& other) : stable_vector(other.begin(), other.end()) { /* empty */ }
+
+  stable_vector(stable_vector&& other) noexcept { swap(other); }
+
+  stable_vector& operator=(stable_vector other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~stable_vector(void) { release(); }
+
+  void swap(stable_vector& other) noexcept {
+    std::swap(m_chunks, other.m_chunks);
+    std::swap(m_end, other.m_end);
+  }
+  friend void swap(stable_vector& a, stable_vector& b) noexcept { a.swap(b); }
+
+  // [II] Iterators
+  iterator begin(void) { return iterator{this, 0}; }
+  iterator end(void) { return iterator{this, m_end}; }
+  const_iterator begin(void) const { return cbegin(); }
+  const_iterator end(void) const { return cend(); }
+  const_iterator cbegin(void) const { return const_iterator{this, 0}; }
+  const_iterator cend(void) const { return const_iterator{this, m_end}; }
+
+  // [III] Capacity
+  size_type size(void) const { return m_end; }
+  size_type capacity(void) const { return m_chunks.size() * ChunkSize; }
+  bool empty(void) const { return m_end == 0; }
+
+  //Adds chunks until `new_cap` elements fit. Existing elements stay where they are.
+  void reserve(size_type new_cap) {
+    m_chunks.reserve((new_cap + ChunkSize - 1) / ChunkSize);
+    while (capacity() < new_cap) add_chunk();
+  }
+
+  //Frees the chunks no element uses.
+  void shrink_to_fit(void) {
+    size_type needed = (m_end + ChunkSize - 1) / ChunkSize;
+    while (m_chunks.size() > needed) {
+      free_chunk(m_chunks.back());
+      m_chunks.pop_back();
+    }
+    m_chunks.shrink_to_fit();
+  }
+
+  // [IV] Modifiers
+  //Destroys every element, keeping the chunks.
+  void clear(void) {
+    while (m_end > 0) pop_back();
+  }
+
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  //Constructs an element at the end; `args` may refer to an element, which does not move.
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    if (m_end == capacity()) add_chunk();
+    T* elem = ::new (static_cast<void*>(slot(m_end))) T(std::forward<Args>(args)...);
+    ++m_end;
+    return *elem;
+  }
+
+  void pop_back(void) {
+    if (m_end > 0) std::destroy_at(slot(--m_end));
+  }
+
+  //Resizes to `count` elements; new elements are value-initialized.
+  void resize(size_type count) {
+    reserve(count);
+    while (m_end < count) emplace_back();
+    while (m_end > count) pop_back();
+  }
+
+  //Resizes to `count` elements; new elements are copies of `value` (which may be an element).
+  void resize(size_type count, const_reference value) {
+    reserve(count);
+    while (m_end < count) emplace_back(value);
+    while (m_end > count) pop_back();
+  }
+
+  void assign(size_type count, const_reference value) {
+    T copy{value}; // `value` may be an element.
+    clear();
+    resize(count, copy);
+  }
+
+  //Inserts `value` before `pos`; the elements from `pos` on shift one place.
+  iterator insert(const_iterator pos, const_reference value) { return emplace(pos, value); }
+  iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    size_type idx = checked_index(pos, "insert");
+    emplace_back(std::forward<Args>(args)...);
+    std::rotate(begin() + idx, end() - 1, end());
+    return begin() + idx;
+  }
+
+  //Removes the element at `pos`; the ones after it shift one place.
+  iterator erase(const_iterator pos) {
+    size_type idx = checked_index(pos, "erase");
+    if (idx == m_end) throw std::out_of_range{"stable_vector::erase"};
+    return erase(pos, pos + 1);
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    size_type from = checked_index(first, "erase");
+    size_type to = checked_index(last, "erase");
+    if (from > to) throw std::out_of_range{"stable_vector::erase"};
+    std::move(begin() + to, end(), begin() + from);
+    for (size_type n{to - from}; n > 0; --n) pop_back();
+    return begin() + from;
+  }
+
+  // [V] Element access
+  reference operator[](size_type idx) { return *slot(idx); }
+  const_reference operator[](size_type idx) const { return *slot(idx); }
+
+  reference at(size_type idx) {
+    if (idx >= m_end) throw std::out_of_range{"The method 'at' cannot access this index"};
+    return *slot(idx);
+  }
+  const_reference at(size_type idx) const {
+    if (idx >= m_end) throw std::out_of_range{"The method 'at' cannot access this index"};
+    return *slot(idx);
+  }
+
+  reference front(void) { return at(0); }
+  const_reference front(void) const { return at(0); }
+  reference back(void) { return at(m_end - 1); }
+  const_reference back(void) const { return at(m_end - 1); }
+
+  friend bool operator==(const stable_vector& a, const stable_vector& b) {
+    return a.m_end == b.m_end && std::equal(a.begin(), a.end(), b.begin());
+  }
+  friend bool operator!=(const stable_vector& a, const stable_vector& b) { return !(a == b); }
+
+ private:
+  T* slot(size_type idx) const { return m_chunks[idx / ChunkSize] + idx % ChunkSize; }
+
+  size_type checked_index(const_iterator pos, const char* method) const {
+    if (pos.index() > m_end) throw std::out_of_range{std::string{"stable_vector::"} + method};
+    return pos.index();
+  }
+
+  void add_chunk(void) {
+    T* chunk = std::allocator<T>{}.allocate(ChunkSize);
+    try { m_chunks.push_back(chunk); }
+    catch (...) { free_chunk(chunk); throw; }
+  }
+  static void free_chunk(T* chunk) { std::allocator<T>{}.deallocate(chunk, ChunkSize); }
+
+  void release(void) {
+    clear();
+    for (size_type i{0}; i < m_chunks.size(); ++i) free_chunk(m_chunks[i]);
+    m_chunks.clear();
+  }
+
+  vector<T*> m_chunks;  //!< The chunks, in order; each holds `ChunkSize` slots.
+  size_type m_end{0};   //!< The number of elements.
+};
+
+} // namespace sc.
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef _STATIC_VECTOR_H_
+#define _STATIC_VECTOR_H_
+
+#include <cstddef>      // std::size_t
+#include <new>          // std::bad_alloc
+#include <type_traits>  // std::true_type
+
+#include "vector.h"
+
+/// Sequence container namespace.
+namespace sc {
+
+/// An allocator that has no memory to give: a vector using it only has its inline buffer.
+/*!
+ * `sc::vector` never calls it (it tests `never_allocates` first); `allocate` exists only to
+ * satisfy `std::allocator_traits`.
+ */
+template <typename T>
+struct null_allocator {
+  using value_type = T;
+  using never_allocates = std::true_type;  //!< Read by `sc::vector` (see `sc::never_allocates`).
+  using is_always_equal = std::true_type;
+
+  null_allocator(void) noexcept = default;
+  template <typename U>
+  null_allocator(const null_allocator<U>&) noexcept { /* empty */ }
+
+  [[noreturn]] T* allocate(std::size_t) { throw std::bad_alloc{}; }
+  void deallocate(T*, std::size_t) noexcept { /* empty */ }
+
+  friend bool operator==(const null_allocator&, const null_allocator&) noexcept { return true; }
+  friend bool operator!=(const null_allocator&, const null_allocator&) noexcept { return false; }
+};
+
+/// A vector of at most `N` elements, stored inside the object, that never touches the heap.
+/*!
+ * `sc::static_vector<T, N>` has exactly the interface of `sc::vector<T>` (iterators,
+ * `insert`/`erase`/`assign`, `swap`, `==`, ...) and `capacity()` is always `N`, so the same
+ * algorithms may run on threads where allocating is forbidden. An operation that would need more
+ * than `N` elements (a `push_back` on a full vector, `reserve(N + 1)`, inserting a range that does
+ * not fit, ...) throws `std::length_error` and leaves the vector as it was.
+ * `try_push_back`/`try_emplace_back` report a full vector with `nullptr` instead.
+ *
+ *     sc::static_vector<order, 64> pending;      // No allocation, ever.
+ *     if (pending.try_push_back(o) == nullptr) reject(o);
+ *
+ * Moves and swaps move the elements themselves (O(N)), as for a small_vector kept inline.
+ *
+ * \tparam T The type of the elements.
+ * \tparam N The capacity.
+ */
+template <typename T, std::size_t N>
+using static_vector = vector<T, null_allocator<T>, N>;
+
+} // namespace sc.
+
+#endif
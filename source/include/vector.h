@@ -3,18 +3,130 @@
 
 #include <exception>    // std::out_of_range
 #include <iostream>     // std::cout, std::endl
-#include <memory>       // std::unique_ptr
+#include <memory>       // std::uninitialized_copy, std::destroy
+#include <new>          // placement new, ::operator new
 #include <iterator>     // std::advance, std::begin(), std::end(), std::ostream_iterator
 #include <algorithm>    // std::copy, std::equal, std::fill
+#include <functional>   // std::less
 #include <initializer_list> // std::initializer_list
 #include <cassert>      // assert()
 #include <limits>       // std::numeric_limits<T>
 #include <cstddef>      // std::size_t
+#include <cstring>      // std::memcpy, std::memmove
+#include <stdexcept>    // std::length_error
+#include <type_traits>  // std::is_nothrow_move_constructible_v
+#include <utility>      // std::move, std::forward
+
+#include "checks.h"
+#include "growth_policy.h"
+#include "vector_stats.h"
+#include "vector_simd.h"
+#include "parallel.h"
+#include "serialization.h"
+
+// Lets an empty allocator member take no room (an extension GCC/Clang also accept in C++17).
+#if defined(__has_cpp_attribute) && __has_cpp_attribute(no_unique_address)
+#define SC_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#else
+#define SC_NO_UNIQUE_ADDRESS
+#endif
+
+// Keeps a function out of line: its callers' optimizer then cannot follow it along paths they rule out.
+#if defined(__GNUC__)
+#define SC_NOINLINE __attribute__((noinline))
+#else
+#define SC_NOINLINE
+#endif
+
+// In C++20, where std::allocator and std::construct_at are constexpr, the core of sc::vector may run
+// in constant expressions (SC_VECTOR_CONSTEXPR is then defined); before that, SC_CONSTEXPR20 is empty.
+#if defined(__cpp_constexpr_dynamic_alloc) && defined(__cpp_lib_constexpr_dynamic_alloc) && \
+    defined(__cpp_lib_is_constant_evaluated)
+#define SC_VECTOR_CONSTEXPR 1
+#define SC_CONSTEXPR20 constexpr
+#else
+#define SC_CONSTEXPR20
+#endif
 
 /// Sequence container namespace.
 namespace sc {
+
+/// Tells whether moving a T to a new address and dropping the original may be done with `memcpy`.
+/*!
+ * True for every trivially copyable type. Types that own resources but do not depend on their
+ * own address (e.g. a class holding a `std::unique_ptr`) may opt in with a specialization:
+ *
+ *     template <> struct sc::is_trivially_relocatable<MyType> : std::true_type {};
+ *
+ * The containers then relocate such objects bitwise and skip the destructor of the source.
+ */
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+/// Whether `Alloc` has an `allocate_at_least(n)` (as in C++23) that may hand out more than `n` slots.
+template <typename Alloc, typename = void>
+struct has_allocate_at_least : std::false_type {};
+template <typename Alloc>
+struct has_allocate_at_least<Alloc, std::void_t<decltype(std::declval<Alloc&>().allocate_at_least(std::size_t{}))>>
+  : std::true_type {};
+
+/// Whether `Alloc` never hands out memory (`Alloc::never_allocates` is true, see static_vector.h).
+/*!
+ * A vector with such an allocator keeps its elements in the inline buffer only: needing more room
+ * than that throws `std::length_error` instead of growing.
+ */
+template <typename Alloc, typename = void>
+struct never_allocates : std::false_type {};
+template <typename Alloc>
+struct never_allocates<Alloc, std::void_t<typename Alloc::never_allocates>> : Alloc::never_allocates {};
+
+namespace detail {
+/// Whether the call happens inside a constant expression (always false before C++20).
+constexpr bool is_constant_evaluated(void) noexcept {
+#ifdef SC_VECTOR_CONSTEXPR
+  return std::is_constant_evaluated();
+#else
+  return false;
+#endif
+}
+
+/// Placement new, in the form constant expressions accept (`std::construct_at`) when there is one.
+template <typename T, typename... Args>
+SC_CONSTEXPR20 T* construct_at(T* p, Args&&... args) {
+#ifdef SC_VECTOR_CONSTEXPR
+  return std::construct_at(p, std::forward<Args>(args)...);
+#else
+  return ::new (static_cast<void*>(p)) T(std::forward<Args>(args)...);
+#endif
+}
+
+/// `std::memmove`, out of line. Inlined into `insert_n`, GCC would check the shift against
+/// buffers of paths that never get there and warn (-Wstringop-overflow); the call is free next
+/// to the copy itself.
+SC_NOINLINE inline void move_bytes(void* dest, const void* src, std::size_t bytes) noexcept {
+  std::memmove(dest, src, bytes);
+}
+} // namespace detail.
+
+/// Enables a template only when `Itr` is (at least) an input iterator.
+template <typename Itr>
+using require_input_iterator = std::enable_if_t<
+    std::is_convertible_v<typename std::iterator_traits<Itr>::iterator_category, std::input_iterator_tag>>;
+
+/// Whether `Itr` may be traversed more than once (forward, bidirectional or random access).
+template <typename Itr>
+inline constexpr bool is_forward_iterator_v =
+    std::is_convertible_v<typename std::iterator_traits<Itr>::iterator_category, std::forward_iterator_tag>;
   
-/// Implements tha infrastrcture to support a bidirectional iterator.
+/// Implements tha infrastrcture to support a random access (contiguous) iterator.
+/*!
+ * The iterator is a thin wrapper around a pointer to the elements, which are stored contiguously,
+ * so every operation is O(1) and standard algorithms may take their pointer-based fast paths.
+ * `MyForwardIterator<T>` converts implicitly to `MyForwardIterator<const T>`.
+ */
 template <class T>
 class MyForwardIterator {
  public:
@@ -22,105 +134,123 @@ class MyForwardIterator {
   // Below we have the iterator_traits common interface
   typedef std::ptrdiff_t difference_type;  //!< Difference type used to calculated distance between
                         //!< iterators.
-  typedef T value_type;              //!< Value type the iterator points to.
+  typedef std::remove_cv_t<T> value_type; //!< Value type the iterator points to.
+  typedef T element_type;            //!< Type of the pointed-to elements (as with `std::to_address`).
   typedef T* pointer;                //!< Pointer to the value type.
   typedef T& reference;              //!< Reference to the value type.
   typedef const T& const_reference;  //!< Reference to the value type.
-  typedef std::bidirectional_iterator_tag
+  typedef std::random_access_iterator_tag
       iterator_category;  //!< Iterator category.
+#if __cplusplus >= 202002L
+  typedef std::contiguous_iterator_tag
+      iterator_concept;   //!< The elements are contiguous in memory (C++20 `std::contiguous_iterator`).
+#endif
 
   /*! Create an iterator around a raw pointer.
    * \param pt_ raw pointer to the container.
    */
-  MyForwardIterator(pointer pt = nullptr) : m_ptr(pt) { /* empty */ }
+  constexpr MyForwardIterator(pointer pt = nullptr) : m_ptr(pt) { /* empty */ }
+
+  /*! Create an iterator into a vector's buffer.
+   * \param generation the vector's count of buffers given up, with which hardened builds
+   *        (SC_VECTOR_CHECKS=hardened) detect a stale iterator; ignored otherwise.
+   */
+  constexpr MyForwardIterator(pointer pt, [[maybe_unused]] const std::size_t* generation)
+    : m_ptr(pt)
+#if SC_VECTOR_CHECK_LEVEL == SC_VECTOR_CHECKS_hardened
+    , m_source(generation), m_generation(generation == nullptr ? 0 : *generation)
+#endif
+  { /* empty */ }
+
+  /// Converts an iterator into a const_iterator.
+  template <typename U, typename = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+  constexpr MyForwardIterator(const MyForwardIterator<U>& other)
+    : m_ptr(other.m_ptr)
+#if SC_VECTOR_CHECK_LEVEL == SC_VECTOR_CHECKS_hardened
+    , m_source(other.m_source), m_generation(other.m_generation)
+#endif
+  { /* empty */ }
 
   /// Access the content the iterator points to.
-  reference operator*(void) const {
-    assert(m_ptr != nullptr);
+  constexpr reference operator*(void) const {
+    check_usable();
     return *m_ptr;
   }
 
   /// Overloaded `->` operator.
-  pointer operator->(void) const {
-    assert(m_ptr != nullptr);
+  constexpr pointer operator->(void) const {
+    check_usable();
     return m_ptr;
   }
 
-  /// Assignment operator.
-  iterator& operator=(const iterator& it){
-    m_ptr = it.m_ptr;
-    return *this;
+  /// Access the element `offset` positions away.
+  constexpr reference operator[](difference_type offset) const {
+    check_usable();
+    return m_ptr[offset];
   }
 
+  /// Assignment operator.
+  iterator& operator=(const iterator& it) = default;
+
   /// Copy constructor.
   MyForwardIterator(const iterator&) = default;
 
   /// Pre-increment operator.
-  iterator operator++(void) {
+  constexpr iterator& operator++(void) {
     m_ptr++;
     return *this;
   }
 
   /// Post-increment operator.
-  iterator operator++(int) {
+  constexpr iterator operator++(int) {
     iterator dummy = *this;
     m_ptr++;
     return dummy;
   }
 
   /// Pre-decrement operator.
-  iterator operator--(void) {
+  constexpr iterator& operator--(void) {
     m_ptr--;
     return *this;
   }
 
   /// Post-decrement operator.
-  iterator operator--(int) {
+  constexpr iterator operator--(int) {
     iterator dummy = *this;
     m_ptr--;
     return dummy;
   }
 
-  iterator& operator+=(difference_type offset) {
-    iterator& it{*this};
+  constexpr iterator& operator+=(difference_type offset) {
     m_ptr += offset;
-    return it;
+    return *this;
   }
-  iterator& operator-=(difference_type offset) {
-    iterator& it{*this};
+  constexpr iterator& operator-=(difference_type offset) {
     m_ptr -= offset;
-    return it;
+    return *this;
   }
 
-  friend bool operator<(const iterator& ita, const iterator& itb) { return ita.m_ptr < itb.m_ptr; }
+  // The comparisons are friends, so an iterator and a const_iterator can be compared as well.
+  friend constexpr bool operator<(const iterator& ita, const iterator& itb) { return ita.m_ptr < itb.m_ptr; }
   
-  friend bool operator>(const iterator& ita, const iterator& itb) { return ita.m_ptr > itb.m_ptr; }
+  friend constexpr bool operator>(const iterator& ita, const iterator& itb) { return ita.m_ptr > itb.m_ptr; }
 	
-  friend bool operator>=(const iterator& ita, const iterator& itb) { return ita.m_ptr >= itb.m_ptr; }
+  friend constexpr bool operator>=(const iterator& ita, const iterator& itb) { return ita.m_ptr >= itb.m_ptr; }
 	
-  friend bool operator<=(const iterator& ita, const iterator& itb) { return ita.m_ptr <= itb.m_ptr; }
+  friend constexpr bool operator<=(const iterator& ita, const iterator& itb) { return ita.m_ptr <= itb.m_ptr; }
 
-  friend iterator operator+(difference_type offset, iterator it) {
-    iterator dummy = it += offset;
-    return dummy;
-  }
-  friend iterator operator+(iterator it, difference_type offset) {
-    iterator dummy = it += offset;
-    return dummy;
-  }
-  friend iterator operator-(iterator it, difference_type offset) {
-    iterator dummy = it -= offset;
-    return dummy;
-  }
+  friend constexpr iterator operator+(difference_type offset, iterator it) { return it += offset; }
+  friend constexpr iterator operator+(iterator it, difference_type offset) { return it += offset; }
+  friend constexpr iterator operator-(iterator it, difference_type offset) { return it -= offset; }
 
-  /// Equality operator.
-  bool operator==(const iterator& rhs_) const { return *m_ptr == *rhs_.m_ptr; }
+  /// Equality operator (two iterators are equal when they point to the same slot).
+  friend constexpr bool operator==(const iterator& ita, const iterator& itb) { return ita.m_ptr == itb.m_ptr; }
 
   /// Not equality operator.
-  bool operator!=(const iterator& rhs_) const { return *m_ptr != *rhs_.m_ptr; }
+  friend constexpr bool operator!=(const iterator& ita, const iterator& itb) { return ita.m_ptr != itb.m_ptr; }
 
   /// Returns the difference between two iterators.
-  difference_type operator-(const iterator& rhs_) const { return m_ptr - rhs_.m_ptr; }
+  friend constexpr difference_type operator-(const iterator& ita, const iterator& itb) { return ita.m_ptr - itb.m_ptr; }
 
   /// Stream extractor operator.
   friend std::ostream& operator<<(std::ostream& os_, const MyForwardIterator& p_){
@@ -129,9 +259,27 @@ class MyForwardIterator {
   }
 
  private:
+  template <class> friend class MyForwardIterator;
+
+  /// Dereferencing needs a non-null iterator, into a buffer its vector still uses (see checks.h).
+  constexpr void check_usable(void) const {
+    detail::check_iterator(m_ptr != nullptr, "sc::vector: dereferencing a null iterator");
+#if SC_VECTOR_CHECK_LEVEL == SC_VECTOR_CHECKS_hardened
+    detail::check_iterator(m_source == nullptr || *m_source == m_generation,
+                           "sc::vector: iterator used after its vector reallocated");
+#endif
+  }
+
   pointer m_ptr; //!< The raw pointer.
+#if SC_VECTOR_CHECK_LEVEL == SC_VECTOR_CHECKS_hardened
+  const std::size_t* m_source{nullptr}; //!< The generation counter of the vector, if any.
+  std::size_t m_generation{0};          //!< Its value when the iterator was made.
+#endif
 };
 
+template <typename T>
+class vector_view; // vector_view.h, included at the end of this file.
+
 /// This class implements the ADT list with dynamic array.
 /*!
  * sc::vector is a sequence container that encapsulates dynamic size arrays.
@@ -143,540 +291,1483 @@ class MyForwardIterator {
  * any function that expects a pointer to an element of an array.
  *
  * \tparam T The type of the elements.
+ * \tparam Allocator Provides the storage, through `std::allocator_traits`.
+ * \tparam InlineCapacity Number of elements stored inside the object itself before the
+ *         allocator is used at all (see `sc::small_vector`). Zero for a plain vector.
+ * \tparam GrowthPolicy Picks the new capacity whenever an insertion runs out of room
+ *         (see growth_policy.h).
  */
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>, std::size_t InlineCapacity = 0,
+          typename GrowthPolicy = doubling_growth>
 class vector {
   //=== Aliases
  public:
   using size_type = unsigned long;  //!< The size type.
   using value_type = T;             //!< The value type.
+  using allocator_type = Allocator; //!< The allocator type.
+  using growth_policy = GrowthPolicy; //!< The growth policy type.
   using pointer = value_type*;  //!< Pointer to a value stored in the container.
   using reference = value_type&;  //!< Reference to a value stored in the container.
   using const_reference = const value_type&; //!< Const reference to a value stored in the container.
   using iterator = MyForwardIterator<value_type>; //!< The iterator, instantiated from a template class.
   using const_iterator = MyForwardIterator<const value_type>; //!< The const_iterator, instantiated from a template class.
+
+ private:
+  using alloc_traits = std::allocator_traits<Allocator>;
+  static_assert(std::is_same_v<typename alloc_traits::value_type, T>, "Allocator::value_type must be T");
+  static_assert(std::is_same_v<typename alloc_traits::pointer, T*>, "fancy pointers are not supported");
+
+  /// The inline buffer is all the room there is (sc::static_vector): growing past it is an error.
+  static constexpr bool fixed_capacity = never_allocates<Allocator>::value;
+  static_assert(!fixed_capacity || InlineCapacity > 0, "a vector that never allocates needs an inline buffer");
+
+  /// Raw, suitably aligned room for `N` elements inside the vector object.
+  template <std::size_t N, typename Dummy = void>
+  struct inline_buffer {
+    alignas(T) unsigned char m_bytes[N * sizeof(T)];
+    inline_buffer(void) { /* empty: the bytes stay uninitialized */ }
+    inline_buffer(const inline_buffer&) { /* empty: elements are copied by the vector */ }
+    T* data(void) const { return reinterpret_cast<T*>(const_cast<unsigned char*>(m_bytes)); }
+  };
+  /// A plain vector has no inline room at all (and, being empty, takes no space).
+  template <typename Dummy>
+  struct inline_buffer<0, Dummy> {
+    constexpr T* data(void) const { return nullptr; }
+  };
   
   public:
     //Default constructor
-    explicit vector(size_type cp = 0) {
-      m_storage = new T[cp];
+    SC_CONSTEXPR20 explicit vector(const Allocator& alloc) noexcept : m_alloc{alloc} {
+      reset_storage();
+    }
+
+    //Size constructor: `cp` value-initialized elements.
+    SC_CONSTEXPR20 explicit vector(size_type cp = 0, const Allocator& alloc = Allocator()) : m_alloc{alloc} {
       m_capacity = cp;
+      m_storage = allocate(m_capacity);
+      // Only the `cp` requested elements are constructed, in place.
+      try {
+        if (detail::is_constant_evaluated())
+          for (size_type i{0}; i < cp; ++i) detail::construct_at(m_storage + i);
+        else std::uninitialized_value_construct_n(m_storage, cp);
+      }
+      catch (...) { deallocate(m_storage, m_capacity); throw; }
       m_end = cp;
     }
 
    //Destructor
-   virtual ~vector(void) {
-     if (m_storage) delete[] m_storage;
+   SC_CONSTEXPR20 virtual ~vector(void) {
+     std::destroy(m_storage, m_storage + m_end);
+     deallocate(m_storage, m_capacity);
    }
    //Copy constructor
-   vector(const vector& vec){
-     m_storage = new T[vec.m_capacity];
-     m_capacity = vec.m_capacity;
+   SC_CONSTEXPR20 vector(const vector& vec)
+     : m_alloc{alloc_traits::select_on_container_copy_construction(vec.m_alloc)} {
+     m_capacity = vec.m_end;
+     m_storage = allocate(m_capacity);
+     try { uninitialized_copy_count(vec.m_storage, vec.m_end, m_storage); }
+     catch (...) { deallocate(m_storage, m_capacity); throw; }
      m_end = vec.m_end;
+     note_copies(m_end);
+   }
 
-     for (int i = 0; i < vec.m_end; i++){ 
-       m_storage[i] = vec.m_storage[i];
+   //Move constructor: steals the storage (and the allocator) of `vec`, leaving it empty.
+   SC_CONSTEXPR20 vector(vector&& vec) noexcept(InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>)
+     : m_alloc{std::move(vec.m_alloc)} {
+     if (vec.is_inline()) {
+       // Elements kept inside `vec` cannot change hands: relocate them into our own buffer.
+       reset_storage();
+       uninitialized_relocate(vec.m_storage, vec.m_storage + vec.m_end, m_storage);
+       destroy_relocated(vec.m_storage, vec.m_storage + vec.m_end);
+       m_end = vec.m_end;
+       vec.m_end = 0;
+       return;
      }
+     m_storage = vec.m_storage;
+     m_capacity = vec.m_capacity;
+     m_end = vec.m_end;
+     vec.reset_storage();
    }
 
    //Initializer list constructor 
-   vector(const std::initializer_list<T> &il){
+   SC_CONSTEXPR20 vector(const std::initializer_list<T> &il, const Allocator& alloc = Allocator()) : m_alloc{alloc} {
      m_capacity = il.size();
-     m_storage = new T[m_capacity];
-     m_end = m_capacity;
-     // Copy the elements from the il into the array.
-     std::copy(il.begin(), il.end(), m_storage);
+     m_storage = allocate(m_capacity);
+     // Copy the elements from the il into the raw array.
+     try { uninitialized_copy_count(il.begin(), il.size(), m_storage); }
+     catch (...) { deallocate(m_storage, m_capacity); throw; }
+     m_end = il.size();
+     note_copies(m_end);
    }
 
    //Range constructor
-   template <typename InputItr>
-   vector(InputItr first, InputItr last){
-     auto dif = last - first;
-     m_capacity = dif;
-     m_storage = new T[m_capacity];
-     m_end = m_capacity;
-
-    size_type i = 0;
-    for (auto it = first; it < last; it++, i++){
-      m_storage[i] = *it;
-    }
+   /*!
+    * Forward ranges are measured first, so they take a single allocation; single-pass input
+    * ranges (e.g. `std::istream_iterator`) are appended one by one, growing geometrically.
+    */
+   template <typename InputItr, typename = require_input_iterator<InputItr>>
+   SC_CONSTEXPR20 vector(InputItr first, InputItr last, const Allocator& alloc = Allocator()) : m_alloc{alloc} {
+     if constexpr (is_forward_iterator_v<InputItr>) {
+       size_type count = std::distance(first, last);
+       m_capacity = count;
+       m_storage = allocate(m_capacity);
+       try { uninitialized_copy_count(first, count, m_storage); }
+       catch (...) { deallocate(m_storage, m_capacity); throw; }
+       m_end = count;
+       note_transfer<InputItr>(m_end);
+     }
+     else {
+       reset_storage();
+       try { append_input(first, last); }
+       catch (...) { release(); throw; }
+     }
   }
 
+  //View constructor: copies the elements a `vector_view` looks at (e.g. a slice of another vector).
+  template <typename U, typename = std::enable_if_t<std::is_same_v<std::remove_const_t<U>, T>>>
+  explicit vector(vector_view<U> view, const Allocator& alloc = Allocator())
+    : vector(view.data(), view.data() + view.size(), alloc) { /* empty */ }
+
   //Assignment operator
   vector& operator=(const vector& vec){
     if (this == &vec){
       return *this;
     }
-    if (vec.m_end <= m_capacity){
-      for (int ii = 0; ii < vec.m_end; ii++){
-        m_storage[ii] = vec.m_storage[ii];
-      }
-      m_end = vec.m_end;
-      return *this;
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+      // Our buffer must go back to the allocator that provided it before we adopt `vec`'s.
+      if (m_alloc != vec.m_alloc) release();
+      m_alloc = vec.m_alloc;
     }
+    assign_range(vec.m_storage, vec.m_end);
+    return *this;
+  }
 
-    T* m_storage_maior = new T[vec.m_end];
-
-    for(int i = 0; i < vec.m_end; i++){
-      m_storage_maior[i] = vec.m_storage[i];
+  //Move assignment operator
+  vector& operator=(vector&& vec)
+    noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value){
+    if (this == &vec){
+      return *this;
+    }
+    bool by_element = vec.is_inline();
+    if constexpr (!alloc_traits::propagate_on_container_move_assignment::value) {
+      // Storage cannot change hands between unequal allocators.
+      by_element = by_element || m_alloc != vec.m_alloc;
     }
-	  
-    delete[] m_storage;
+    if (by_element) {
+      assign_range(std::make_move_iterator(vec.m_storage), vec.m_end);
+      vec.clear();
+      return *this;
+    }
+    release();
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+      m_alloc = std::move(vec.m_alloc);
 
+    m_storage = vec.m_storage;
+    m_capacity = vec.m_capacity;
     m_end = vec.m_end;
-    m_capacity = vec.m_end;
-    m_storage = m_storage_maior;
 
+    vec.reset_storage();
     return *this;
   }
 
+  /// Returns a copy of the allocator associated with the container.
+  allocator_type get_allocator(void) const { return m_alloc; }
+
+#ifdef SC_VECTOR_STATS
+  /// How many times this vector moved its elements to a new buffer (see vector_stats.h).
+  size_type reallocations(void) const { return m_reallocations; }
+#endif
+
   //=== [II] ITERATORS
     
   //Returns the first position of the vector
-  iterator begin(void){ return iterator(&m_storage[0]); }
+  SC_CONSTEXPR20 iterator begin(void){ return iterator(m_storage, generation()); }
   
   //Returns the last position of the vector
-  iterator end(void){ return iterator(&m_storage[m_end]); }
+  SC_CONSTEXPR20 iterator end(void){ return iterator(m_storage + m_end, generation()); }
   
+  //Const overloads, so const vectors can be traversed (e.g. by range-based for).
+  SC_CONSTEXPR20 const_iterator begin(void) const { return cbegin(); }
+  SC_CONSTEXPR20 const_iterator end(void) const { return cend(); }
+
   //Returns a constant reference of the first position of the vector
-  const_iterator cbegin( void ) const { return const_iterator(&m_storage[0]); }
+  SC_CONSTEXPR20 const_iterator cbegin( void ) const { return const_iterator(m_storage, generation()); }
   
   //Returns a constant reference of the last position of the vector
-  const_iterator cend( void ) const { return const_iterator(&m_storage[m_end]); }
+  SC_CONSTEXPR20 const_iterator cend( void ) const { return const_iterator(m_storage + m_end, generation()); }
 
   // [III] Capacity
-  size_type size(void) const { return m_end; }
-  size_type capacity(void) const { return m_capacity; }
-  bool empty(void) const { return m_end == 0; }
+  SC_CONSTEXPR20 size_type size(void) const { return m_end; }
+  SC_CONSTEXPR20 size_type capacity(void) const { return m_capacity; }
+  SC_CONSTEXPR20 bool empty(void) const { return m_end == 0; }
 
   // [IV] Modifiers
-  void clear(void){
-    for(size_type i{0}; i < m_end; i++)
-      m_storage[i].~T();
+  SC_CONSTEXPR20 void clear(void){
+    std::destroy(m_storage, m_storage + m_end);
     m_end = 0;
+    note_slack();
   }
 
-  void push_front(const_reference st){
-    if(m_capacity == 0){
-      reserve(10);
-    }
-    else if(full()){
-      reserve(2 * m_capacity);
-    }
-    for(auto i{m_end}; i>0; i--){
-      m_storage[i] = m_storage[i-1];
-    }
-  
-    m_storage[0] = st;
-    m_end++;
+  SC_CONSTEXPR20 void push_front(const_reference st){
+    emplace_at(0, st);
   }
 
-  void push_back(const_reference st){
-    if(m_capacity == 0){
-      reserve(10);
-    }else if(m_end == m_capacity){
-      reserve(2 * m_capacity);
-    }
+  SC_CONSTEXPR20 void push_front(value_type&& st){
+    emplace_at(0, std::move(st));
+  }
 
-    m_storage[m_end] = st;
-    m_end++;
+  SC_CONSTEXPR20 void push_back(const_reference st){
+    emplace_at(m_end, st);
+  }
+
+  SC_CONSTEXPR20 void push_back(value_type&& st){
+    emplace_at(m_end, std::move(st));
+  }
+  //Constructs an element in place at the front, forwarding `args` to its constructor.
+  template <typename... Args>
+  SC_CONSTEXPR20 reference emplace_front(Args&&... args){
+    return *emplace_at(0, std::forward<Args>(args)...);
   }
-  void pop_back(void){
-    if(m_end > 0) m_storage[--m_end].~T();
+
+  //Constructs an element in place at the end, forwarding `args` to its constructor.
+  template <typename... Args>
+  SC_CONSTEXPR20 reference emplace_back(Args&&... args){
+    return *emplace_at(m_end, std::forward<Args>(args)...);
+  }
+
+  //Like emplace_back, but only when there is room already: nullptr when the vector is full (it never reallocates).
+  template <typename... Args>
+  SC_CONSTEXPR20 pointer try_emplace_back(Args&&... args){
+    if (full()) return nullptr;
+    emplace_at(m_end, std::forward<Args>(args)...);
+    return m_storage + m_end - 1;
+  }
+
+  SC_CONSTEXPR20 pointer try_push_back(const_reference st){ return try_emplace_back(st); }
+  SC_CONSTEXPR20 pointer try_push_back(value_type&& st){ return try_emplace_back(std::move(st)); }
+
+  SC_CONSTEXPR20 void pop_back(void){
+    if(m_end > 0) std::destroy_at(m_storage + --m_end);
+    note_slack();
   }
 
   void pop_front(void){
-    if(m_end > 0){
-      for(auto i{0u}; i<m_end; i++){
-        m_storage[i] = m_storage[i+1];
-      }
-      m_end--;
-    }
+    if(m_end > 0) erase_n(0, 1);
   }
 
   //Iterator insert
-  iterator insert(iterator pos_, const_reference value_){
-    if(pos_ < begin() || pos_ > end() )  throw std::out_of_range{ "The method 'insert' cannot access this position" };
+  SC_CONSTEXPR20 iterator insert(iterator pos_, const_reference value_){
+    detail::check(pos_ >= begin() && pos_ <= end(), "The method 'insert' cannot access this position");
+    return emplace_at(pos_ - begin(), value_);
+  }
 
-    auto dif = pos_ - begin();
-    
-    if(full()){
-      reserve(m_capacity * 2);
-    }
-    m_end++;
+  //Iterator insert (moves `value_` into the vector)
+  SC_CONSTEXPR20 iterator insert(iterator pos_, value_type&& value_){
+    detail::check(pos_ >= begin() && pos_ <= end(), "The method 'insert' cannot access this position");
+    return emplace_at(pos_ - begin(), std::move(value_));
+  }
+	
+  //Constant iterator insert
+  SC_CONSTEXPR20 iterator insert(const_iterator pos_, const_reference value_){
+    detail::check(pos_ >= cbegin() && pos_ <= cend(), "The method 'insert' cannot access this position");
+    return emplace_at(pos_ - cbegin(), value_);
+  }
 
-    pos_ = begin()+dif;
+  //Constant iterator insert (moves `value_` into the vector)
+  SC_CONSTEXPR20 iterator insert(const_iterator pos_, value_type&& value_){
+    detail::check(pos_ >= cbegin() && pos_ <= cend(), "The method 'insert' cannot access this position");
+    return emplace_at(pos_ - cbegin(), std::move(value_));
+  }
 
-    for(iterator it = end()-1; it > pos_; it--){
-      *it= *(it-1);
-    }
+  //Iterator emplace: constructs an element in place before `pos_`.
+  template <typename... Args>
+  SC_CONSTEXPR20 iterator emplace(iterator pos_, Args&&... args){
+    detail::check(pos_ >= begin() && pos_ <= end(), "The method 'emplace' cannot access this position");
+    return emplace_at(pos_ - begin(), std::forward<Args>(args)...);
+  }
 
-    *pos_ = value_;
+  //Constant iterator emplace: constructs an element in place before `pos_`.
+  template <typename... Args>
+  SC_CONSTEXPR20 iterator emplace(const_iterator pos_, Args&&... args){
+    detail::check(pos_ >= cbegin() && pos_ <= cend(), "The method 'emplace' cannot access this position");
+    return emplace_at(pos_ - cbegin(), std::forward<Args>(args)...);
+  }
 
-    return pos_;
+  template <typename InputItr, typename = require_input_iterator<InputItr>>
+  iterator insert(iterator pos_, InputItr first_, InputItr last_){
+    detail::check(pos_ >= begin() && pos_ <= end(), "The method 'insert' cannot access this range of positions");
+    return insert_range(pos_ - begin(), first_, last_);
+  }
+ 
+  template <typename InputItr, typename = require_input_iterator<InputItr>>
+  iterator insert(const_iterator pos_, InputItr first_, InputItr last_){
+    detail::check(pos_ >= cbegin() && pos_ <= cend(), "The method 'insert' cannot access this range of positions");
+    return insert_range(pos_ - cbegin(), first_, last_);
+  }
+ 
+  iterator insert(iterator pos_, const std::initializer_list<value_type>& ilist_){
+    detail::check(pos_ >= begin() && pos_ <= end(), "vector::insert");
+    return insert_n(pos_ - begin(), ilist_.begin(), ilist_.size());
   }
 	
-  //Constant iterator insert
-  iterator insert(const_iterator pos_, const_reference value_){
-    if(pos_ < begin() || pos_ > end() )  throw std::out_of_range{ "The method 'insert' cannot access this position" };
+  iterator insert(const_iterator pos_, const std::initializer_list<value_type>& ilist_){
+    detail::check(pos_ >= cbegin() && pos_ <= cend(), "vector::insert");
+    return insert_n(pos_ - cbegin(), ilist_.begin(), ilist_.size());
+  }
 
-    auto distancia = pos_ - begin();
+  SC_CONSTEXPR20 void reserve(size_type alocar){
+    if(alocar <= m_capacity)
+      return;
 
-    if(full()){
-      reserve(m_capacity * 2);
+    reallocate(alocar);
+  }
+	
+  //Requests the removal of unused capacity.
+  void shrink_to_fit(void){
+    // An inline buffer cannot get any smaller.
+    if(m_capacity > m_end && !is_inline()){
+      reallocate(m_end);
     }
-    m_end++;
+  }
 
-    pos_ = begin()+distancia;
+  void assign(size_type count_, const_reference value_){
+    if constexpr (simd::is_vectorizable_v<T>) {
+      // No constructors to run: raw and live slots are filled alike, with SIMD stores.
+      T value{value_}; // `value_` may live in the old buffer.
+      if(count_ > m_capacity){
+        size_type new_cap = count_;
+        pointer newStorage = allocate(new_cap);
+        deallocate(m_storage, m_capacity);
+        m_storage = newStorage;
+        m_capacity = new_cap;
+      }
+      simd::fill(m_storage, count_, value);
+    }
+    else if(count_ > m_capacity){
+      size_type new_cap = count_;
+      pointer newStorage = allocate(new_cap);
+      try { std::uninitialized_fill_n(newStorage, count_, value_); }
+      catch (...) { deallocate(newStorage, new_cap); throw; }
+      std::destroy(m_storage, m_storage + m_end);
+      deallocate(m_storage, m_capacity);
+      m_storage = newStorage;
+      m_capacity = new_cap;
+    }
+    else if(count_ > m_end){
+      std::fill_n(m_storage, m_end, value_);
+      std::uninitialized_fill_n(m_storage + m_end, count_ - m_end, value_);
+    }
+    else{
+      std::fill_n(m_storage, count_, value_);
+      std::destroy(m_storage + count_, m_storage + m_end);
+    }
+    m_end = count_;
+    note_copies(count_);
+    note_slack();
+  }
 
-    for(iterator it = end()-1; it > pos_; it--){
-      *it= *(it-1);
+  void assign(const std::initializer_list<T>& ilist){
+    assign_range(ilist.begin(), ilist.size());
+  }
+
+  template <typename InputItr, typename = require_input_iterator<InputItr>>
+  void assign(InputItr first, InputItr last){
+    if constexpr (is_forward_iterator_v<InputItr>) {
+      assign_range(first, std::distance(first, last));
+    }
+    else {
+      // Single pass: overwrite the live elements, then drop the leftovers or append the rest.
+      size_type idx{0};
+      for (; idx < m_end && first != last; ++idx, ++first)
+        m_storage[idx] = *first;
+      if (first == last) erase_n(idx, m_end - idx);
+      else append_input(first, last);
     }
+  }
 
-    *pos_ = value_;
+  //Appends the elements of [first, last).
+  /*!
+   * A forward range takes a single capacity check (and at most one reallocation); an input
+   * range grows geometrically as it is read.
+   */
+  template <typename InputItr, typename = require_input_iterator<InputItr>>
+  void append_range(InputItr first, InputItr last){
+    insert_range(m_end, first, last);
+  }
 
-    return pos_;
+  //Appends the elements of a container (anything with begin()/end()).
+  template <typename Range>
+  void append_range(const Range& range){
+    append_range(std::begin(range), std::end(range));
   }
 
-  template <typename InputItr>
-  iterator insert(iterator pos_, InputItr first_, InputItr last_){
-    if(pos_ < begin() || pos_ > end() ) throw std::out_of_range{ "The method 'insert' cannot access this range of positions" };
-    
-    auto dif = last_ - first_;
-    auto distancia = pos_ - begin();
+  //Resizes to `count` elements; new elements are value-initialized (zeroed for trivial T).
+  void resize(size_type count){
+    resize_with(count, [&](pointer slot, size_type n){ std::uninitialized_value_construct_n(slot, n); });
+  }
 
-    if(full() || (m_end+dif) > m_capacity) reserve(m_capacity + dif);
-    
-    m_end+=dif;
-    pos_ = begin()+distancia;
-    size_type i{m_end-1};
+  //Resizes to `count` elements; new elements are copies of `value` (which may be an element).
+  void resize(size_type count, const_reference value){
+    resize_with(count, [&](pointer slot, size_type n){ std::uninitialized_fill_n(slot, n, value); note_copies(n); });
+  }
 
-    for(auto it{end()-1}; it>pos_; it--, i--){
-      m_storage[i] = *(it-dif);
-    }
+  //Resizes to `count` elements, default-initializing the new ones.
+  /*!
+   * For trivial T the new elements are left uninitialized (nothing is written), so the vector
+   * can be sized once and filled directly through `data()`, e.g. by `read()` or `recv()`.
+   * They must be written before they are read.
+   */
+  void resize_for_overwrite(size_type count){
+    resize_with(count, [&](pointer slot, size_type n){ std::uninitialized_default_construct_n(slot, n); });
+  }
 
-    for(auto i{0u}; i<dif; i++){
-      *(pos_+i) = *(first_+i);
-    } 
-    return pos_;
+  iterator erase(iterator first, iterator last){
+    detail::check(begin() <= first && first <= last && last <= end(), "The method 'erase' cannot access this range of positions");
+    return erase_n(first - begin(), last - first);
   }
- 
-  template <typename InputItr>
-  iterator insert(const_iterator pos_, InputItr first_, InputItr last_){
-    if(pos_ < begin() || pos_ > end() )  throw std::out_of_range{ "The method 'insert' cannot access this range of positions" };
-    
-    auto dif = last_ - first_;
-    auto distancia = pos_ - begin();
 
-    if(full() || (m_end+dif) > m_capacity){ 
-      reserve(m_capacity + dif);
-    }
+  iterator erase(const_iterator first, const_iterator last){
+    detail::check(cbegin() <= first && first <= last && last <= cend(), "The method 'erase' cannot access this range of positions");
+    return erase_n(first - cbegin(), last - first);
+  }
 
-    m_end+=dif;                                 
-    pos_ = begin()+distancia;
-    size_type i{m_end-1};
-       
-    for(auto it{end()-1}; it>pos_; it--, i--){    
-      m_storage[i] = *(it-dif);                   
-    }
+  iterator erase(const_iterator pos){
+    detail::check(pos >= cbegin() && pos < cend(), "The method 'erase' cannot access this position");
+    return erase_n(pos - cbegin(), 1);
+  }
 
-    for(auto i{0u}; i<dif; i++){
-      *(pos_+i) = *(first_+i);    
-    } 
-    return pos_;
+  iterator erase(iterator pos){
+    detail::check(pos >= begin() && pos < end(), "The method 'erase' cannot access this position");
+    return erase_n(pos - begin(), 1);
   }
- 
-  iterator insert(iterator pos_, const std::initializer_list<value_type>& ilist_){
-    auto distancia = pos_ - begin();
-    auto n_elem = ilist_.end() - ilist_.begin();
-    if(pos_ < begin() || pos_ > end() )  throw std::out_of_range{ "vector::insert" };
 
-    if(full()){
-      reserve(m_capacity + n_elem);
+  //Removes the element at `pos` in O(1) by moving the last element into its place.
+  /*!
+   * The order of the remaining elements is not preserved. Returns an iterator to the element
+   * that took the place of the erased one (or `end()` if the last element was erased).
+   */
+  iterator erase_unordered(const_iterator pos){
+    detail::check(pos >= cbegin() && pos < cend(), "The method 'erase_unordered' cannot access this position");
+    size_type idx = pos - cbegin();
+    pointer slot = m_storage + idx;
+    pointer back = m_storage + m_end - 1;
+    if constexpr (is_trivially_relocatable_v<T>) {
+      std::destroy_at(slot);
+      if (slot != back) {
+        std::memcpy(static_cast<void*>(slot), static_cast<const void*>(back), sizeof(T));
+        note_bitwise(1);
+      }
     }
-    m_end += n_elem;
-
-    pos_ = begin()+distancia;
-    
-    for(iterator it = end()-1; it >= pos_; it--){
-      *it= *(it-n_elem);
+    else {
+      if (slot != back) {
+        *slot = std::move(*back);
+        note_moves(1);
+      }
+      std::destroy_at(back);
     }
+    --m_end;
+    note_slack();
+    return begin() + idx;
+  }
 
-    auto i = 0;
-    for(iterator iter = pos_; iter < (pos_+n_elem); iter++, i++){
-      *iter= *(ilist_.begin()+i);
-      
+  //Removes every element for which `pred` is true, in a single pass; returns how many were removed.
+  /*!
+   * The kept elements keep their order. Trivially relocatable elements slide down one run at a
+   * time with `memmove`; the others are move-assigned, as `std::remove_if` would.
+   */
+  template <typename Pred>
+  size_type remove_if(Pred pred){
+    pointer last = m_storage + m_end;
+    pointer write = std::find_if(m_storage, last, [&](reference e){ return bool(pred(e)); });
+    if (write == last) return 0;
+    if constexpr (is_trivially_relocatable_v<T>) {
+      std::destroy_at(write);
+      pointer keep = write + 1; // First kept element that has not slid down yet.
+      pointer read = keep;
+      try {
+        for (; read != last; ++read) {
+          if (pred(*read)) {
+            shift_relocate(keep, read, write);
+            note_bitwise(read - keep);
+            write += read - keep;
+            std::destroy_at(read);
+            keep = read + 1;
+          }
+        }
+      }
+      catch (...) {
+        // Close the gap left so far, so [0, m_end) stays all live elements.
+        shift_relocate(keep, last, write);
+        m_end = (write - m_storage) + (last - keep);
+        throw;
+      }
+      shift_relocate(keep, last, write);
+      note_bitwise(last - keep);
+      write += last - keep;
     }
-    
-    return pos_;
+    else {
+      pointer first_kept = write;
+      for (pointer read = write + 1; read != last; ++read)
+        if (!pred(*read)) *write++ = std::move(*read);
+      note_moves(write - first_kept);
+      std::destroy(write, last);
+    }
+    size_type removed = m_end - (write - m_storage);
+    m_end = write - m_storage;
+    note_slack();
+    return removed;
   }
-	
-  iterator insert(const_iterator pos_, const std::initializer_list<value_type>& ilist_){
-    auto distancia = pos_ - begin();
-    auto n_elem = ilist_.end() - ilist_.begin();
-    if(pos_ < begin() || pos_ > end() )  throw std::out_of_range{ "vector::insert" };
 
-    if(full()){
-      reserve(m_capacity + n_elem);
-    }
-    m_end += n_elem;
+  // Batch modifiers: k insertions or removals at scattered positions take one pass over the vector,
+  // O(size() + k), where k calls to insert/erase would shift the tail k times, O(size() * k).
+  // The position ranges must be random access (an sc::vector, an array, ...).
+
+  //Inserts `values[j]` before the element now at index `positions[j]`, for every j.
+  /*!
+   * `positions` must be sorted, with indices in [0, size()] (values given the same position keep
+   * their order), and hold one position per value. Each old element is moved once, straight to
+   * its final slot; when the buffer grows, a value that fails to be built leaves the vector as it
+   * was. A `values` container passed as an rvalue is moved from.
+   *
+   *     book.insert_sorted_batch(slots, std::move(new_orders)); // Hundreds per tick, one pass.
+   */
+  template <typename Positions, typename Values>
+  void insert_sorted_batch(const Positions& positions, Values&& values){
+    auto pos = std::begin(positions);
+    size_type count = std::distance(pos, std::end(positions));
+    detail::check(size_type(std::distance(std::begin(values), std::end(values))) == count,
+                  "insert_sorted_batch: there must be one position per value");
+    for (size_type j{0}; j < count; ++j)
+      detail::check(size_type(pos[j]) <= m_end && (j == 0 || pos[j - 1] <= pos[j]),
+                    "insert_sorted_batch: the positions must be sorted indices up to size()");
+    if constexpr (std::is_lvalue_reference_v<Values>) insert_batch(pos, std::begin(values), count);
+    else insert_batch(pos, std::make_move_iterator(std::begin(values)), count);
+  }
 
-    pos_ = begin()+distancia;
-    
-    for(iterator it = end()-1; it >= pos_; it--){
-      *it= *(it-n_elem);
+  //Removes the elements at `indices`, which must be sorted, distinct and below size().
+  /*!
+   * Each remaining element after the first removed one is moved once; trivially relocatable
+   * elements slide with one `memmove` per run between two removed ones.
+   */
+  template <typename Indices>
+  void erase_indices(const Indices& indices){
+    auto idx = std::begin(indices);
+    size_type count = std::distance(idx, std::end(indices));
+    for (size_type j{0}; j < count; ++j)
+      detail::check(size_type(idx[j]) < m_end && (j == 0 || idx[j - 1] < idx[j]),
+                    "erase_indices: the indices must be sorted, distinct and below size()");
+    if (count == 0) return;
+    pointer write = m_storage + idx[0];
+    // The run of survivors after the j-th removed element.
+    auto run_end = [&](size_type j){ return j + 1 < count ? m_storage + idx[j + 1] : m_storage + m_end; };
+    if constexpr (is_trivially_relocatable_v<T>) {
+      for (size_type j{0}; j < count; ++j) {
+        pointer gap = m_storage + idx[j];
+        std::destroy_at(gap);
+        shift_relocate(gap + 1, run_end(j), write);
+        note_bitwise(run_end(j) - gap - 1);
+        write += run_end(j) - gap - 1;
+      }
+    }
+    else {
+      pointer first_kept = write;
+      for (size_type j{0}; j < count; ++j)
+        write = std::move(m_storage + idx[j] + 1, run_end(j), write);
+      note_moves(write - first_kept);
+      std::destroy(write, m_storage + m_end);
     }
+    m_end -= count;
+    note_slack();
+  }
 
-    auto i = 0;
-    for(iterator iter = pos_; iter < (pos_+n_elem); iter++, i++){
-      *iter= *(ilist_.begin()+i);
+  //Merges the sorted `range` into this (sorted) vector in O(size() + k) (see insert_sorted_batch).
+  /*!
+   * Both must be sorted by `comp`; an element of the range goes after the equal ones of the
+   * vector, as with `std::merge`. A range that is not random access is copied first; a container
+   * passed as an rvalue is moved from.
+   */
+  template <typename Range, typename Compare = std::less<>>
+  void merge_sorted(Range&& range, Compare comp = Compare{}){
+    auto first = std::begin(range);
+    auto last = std::end(range);
+    using Itr = decltype(first);
+    if constexpr (std::is_convertible_v<typename std::iterator_traits<Itr>::iterator_category,
+                                        std::random_access_iterator_tag>) {
+      if constexpr (std::is_lvalue_reference_v<Range>) merge_sorted_n(first, std::distance(first, last), comp);
+      else merge_sorted_n(std::make_move_iterator(first), std::distance(first, last), comp);
+    }
+    else {
+      vector sorted(first, last, m_alloc);
+      merge_sorted_n(std::make_move_iterator(sorted.begin()), sorted.size(), comp);
     }
-    
-    return pos_;
   }
 
-  void reserve(size_type alocar){
-    if(alocar <= m_capacity)
-      return;
+  // [V] Element access
+  SC_CONSTEXPR20 const_reference back(void) const {
+    detail::check(m_end > 0, "The method 'back' cannot access the index of last position");
+    return m_storage[m_end - 1];
+  }
 
-    T* newstorage = new T[alocar];
+  SC_CONSTEXPR20 const_reference front(void) const {
+    detail::check(m_end > 0, "The method 'front' cannot access the index of first position");
+    return m_storage[0];
+  }
 
-    for (int i = 0; i < m_end; i++){
-      newstorage[i] = m_storage[i];
-    }
+  SC_CONSTEXPR20 reference back(void) {
+    detail::check(m_end > 0, "The method 'back' cannot access the index of last position");
+    return m_storage[m_end - 1];
+  }
 
-    delete[] m_storage;
+  SC_CONSTEXPR20 reference front(void) {
+    detail::check(m_end > 0, "The method 'front' cannot access the index of first position");
+    return m_storage[0];
+  }
 
-    m_capacity = alocar;
-    m_storage = newstorage;
+  SC_CONSTEXPR20 const_reference operator[](size_type idx) const{
+    if constexpr (vector_checks == check_level::hardened) detail::check(idx < m_end, "vector::operator[]");
+    return m_storage[idx];
+  }
+  SC_CONSTEXPR20 reference operator[](size_type idx){
+    if constexpr (vector_checks == check_level::hardened) detail::check(idx < m_end, "vector::operator[]");
+    return m_storage[idx];
+  }
 
+  SC_CONSTEXPR20 const_reference at(size_type idx) const{
+    if (idx >= m_end) detail::throw_out_of_range("The method 'at' cannot access this index");
+    return m_storage[idx];
+  }
+
+  SC_CONSTEXPR20 reference at(size_type idx){
+    if (idx >= m_end) detail::throw_out_of_range("The method 'at' cannot access this index");
+    return m_storage[idx];
   }
 	
-  //Requests the removal of unused capacity.
-  void shrink_to_fit(void){
-    if(m_capacity > m_end){
-      T* newstorage = new T[m_end];
+  //A view of the elements [offset, offset + count) (fewer if the vector ends first), with no copy.
+  vector_view<T> subview(size_type offset, size_type count = static_cast<size_type>(-1)){
+    return view().subview(offset, count);
+  }
+  vector_view<const T> subview(size_type offset, size_type count = static_cast<size_type>(-1)) const{
+    return view().subview(offset, count);
+  }
+  vector_view<T> view(void){ return vector_view<T>{m_storage, m_end}; }
+  vector_view<const T> view(void) const{ return vector_view<const T>{m_storage, m_end}; }
 
-      for(int i = 0; i < m_end; i++){
-        newstorage[i] = m_storage[i];
-      }
+  SC_CONSTEXPR20 pointer data(void){ return m_storage; }
+
+  SC_CONSTEXPR20 const T* data(void) const{ return m_storage; }
+
+  // Lookup. Integer and floating point elements are scanned with SIMD (see vector_simd.h).
 
-      delete[] m_storage;
+  //Returns an iterator to the first element equal to `value_`, or end().
+  iterator find(const_reference value_){
+    return begin() + simd::find(m_storage, m_end, value_);
+  }
+  const_iterator find(const_reference value_) const{
+    return cbegin() + simd::find(static_cast<const T*>(m_storage), m_end, value_);
+  }
 
-      m_capacity = m_end;
-      m_storage = newstorage;
+  //Returns how many elements are equal to `value_`.
+  size_type count(const_reference value_) const{
+    return simd::count(static_cast<const T*>(m_storage), m_end, value_);
+  }
+
+  bool contains(const_reference value_) const{
+    return simd::find(static_cast<const T*>(m_storage), m_end, value_) != m_end;
+  }
+
+  //Replaces every element with a copy of `value_`; the size does not change.
+  void fill(const_reference value_){
+    if constexpr (simd::is_vectorizable_v<T>) simd::fill(m_storage, m_end, T{value_});
+    else std::fill_n(m_storage, m_end, value_);
+    note_copies(m_end);
+  }
+
+  // Parallel bulk operations. [0, size) is split into one chunk per thread (see parallel.h);
+  // below `policy.threshold` elements they run serially, like their plain counterparts.
+
+  //Replaces the content with a copy of `other`, built by several threads.
+  void parallel_copy_from(const vector& other, const parallel_policy& policy = par){
+    if (&other != this) assign(policy, other.m_storage, other.m_storage + other.m_end);
+  }
+
+  //Replaces the content with copies of [first, last), built by several threads.
+  /*!
+   * The range must not be part of this vector. If a copy throws while the content is rebuilt
+   * in the current buffer, the vector is left empty.
+   */
+  template <typename RandomItr, typename = require_input_iterator<RandomItr>>
+  void assign(const parallel_policy& policy, RandomItr first, RandomItr last){
+    static_assert(std::is_convertible_v<typename std::iterator_traits<RandomItr>::iterator_category,
+                                        std::random_access_iterator_tag>,
+                  "parallel assign needs random access iterators");
+    size_type count = last - first;
+    std::size_t chunks = detail::parallel_chunks(count, policy);
+    if (chunks <= 1) {
+      assign(first, last);
+      return;
     }
+    parallel_rebuild(count, chunks, [&](pointer dest, size_type lo, size_type hi){
+      uninitialized_copy_count(first + lo, hi - lo, dest + lo);
+    });
+    note_transfer<RandomItr>(count);
   }
 
-  void assign(size_type count_, const_reference value_){
-    if(count_ <= size()){
-      m_end = count_;
-      
-      for(auto i{0u}; i<count_; i++){
-        m_storage[i] = value_;
-      }
+  //Replaces the content with `count_` copies of `value_`, written by several threads.
+  void assign(const parallel_policy& policy, size_type count_, const_reference value_){
+    std::size_t chunks = detail::parallel_chunks(count_, policy);
+    if (chunks <= 1) {
+      assign(count_, value_);
+      return;
     }
-    else{
-      T* newStorage = new T[count_];
-      m_capacity = count_;
-      m_end = count_;
+    T value{value_}; // `value_` may be one of the elements about to go away.
+    parallel_rebuild(count_, chunks, [&](pointer dest, size_type lo, size_type hi){
+      if constexpr (simd::is_vectorizable_v<T>) simd::fill(dest + lo, hi - lo, value);
+      else std::uninitialized_fill_n(dest + lo, hi - lo, value);
+    });
+    note_copies(count_);
+  }
 
-      delete [] m_storage;
+  //Calls `f(element)` on every element, from several threads.
+  template <typename F>
+  void for_each(const parallel_policy& policy, F f){
+    detail::parallel_for_chunks(m_end, detail::parallel_chunks(m_end, policy), [&](std::size_t, std::size_t lo, std::size_t hi){
+      for (std::size_t i{lo}; i < hi; ++i) f(m_storage[i]);
+    });
+  }
+  template <typename F>
+  void for_each(const parallel_policy& policy, F f) const{
+    detail::parallel_for_chunks(m_end, detail::parallel_chunks(m_end, policy), [&](std::size_t, std::size_t lo, std::size_t hi){
+      for (std::size_t i{lo}; i < hi; ++i) f(static_cast<const T&>(m_storage[i]));
+    });
+  }
 
-      m_storage = newStorage;
+  //Replaces every element `e` with `f(e)`, from several threads.
+  template <typename F>
+  void transform(const parallel_policy& policy, F f){
+    detail::parallel_for_chunks(m_end, detail::parallel_chunks(m_end, policy), [&](std::size_t, std::size_t lo, std::size_t hi){
+      for (std::size_t i{lo}; i < hi; ++i) m_storage[i] = f(static_cast<const T&>(m_storage[i]));
+    });
+  }
+
+  // Binary serialization, in the format described in serialization.h. Trivially copyable
+  // elements go through a single write/read of the whole buffer; strings are length-prefixed.
+
+  //Writes a header and the elements to `os`.
+  void write_to(std::ostream& os) const{
+    using traits = detail::binary_traits<T>;
+    static_assert(traits::supported, "write_to needs trivially copyable elements or strings of them");
+    detail::write_binary_header(os, traits::layout, traits::unit_size, m_end);
+    if constexpr (traits::layout == detail::binary_layout::raw)
+      os.write(reinterpret_cast<const char*>(m_storage), m_end * sizeof(T));
+    else
+      for (size_type i{0}; i < m_end; ++i) detail::write_binary_string(os, m_storage[i]);
+    if (!os) throw serialization_error{"sc::vector::write_to: the stream failed"};
+  }
 
-      for(auto i{0u}; i<count_; i++){
-        m_storage[i] = value_;
+  //Replaces the content with the elements written by `write_to()`.
+  /*!
+   * Throws `sc::serialization_error` if the stream holds something else (another element type,
+   * byte order or format version), leaving the vector unchanged, or if it ends too soon, leaving
+   * the vector empty. A count or string length is never trusted beyond the data that follows
+   * it (see serialization.h), so a corrupt one throws instead of allocating without bound.
+   */
+  void read_from(std::istream& is){
+    using traits = detail::binary_traits<T>;
+    static_assert(traits::supported, "read_from needs trivially copyable elements or strings of them");
+    size_type count = detail::read_binary_header(is, traits::layout, traits::unit_size);
+    detail::binary_source in{is};
+    clear();
+    try {
+      // Room is made one batch at a time: all of it once the stream shows it holds that much.
+      if constexpr (traits::layout == detail::binary_layout::raw) {
+        size_type batch = in.batch(count, sizeof(T));
+        for (size_type done{0}; done < count; done = m_end) {
+          resize_for_overwrite(done + std::min(batch, count - done));
+          in.read(m_storage + done, (m_end - done) * sizeof(T), "sc::vector::read_from: truncated elements");
+        }
+      }
+      else {
+        size_type batch = in.batch(count, 8); // Every string has at least its length.
+        for (size_type done{0}; done < count; done = m_end) {
+          resize(done + std::min(batch, count - done));
+          for (size_type i{done}; i < m_end; ++i) detail::read_binary_string(in, m_storage[i]);
+        }
       }
     }
+    catch (...) { clear(); throw; }
   }
 
-  void assign(const std::initializer_list<T>& ilist){
-    if(ilist.size() <= size()){
-      m_end = ilist.size();
-      std::copy(ilist.begin(), ilist.end(), m_storage);
-    }
-    else{
-      T* newStorage = new T[ilist.size()];
-      m_capacity = ilist.size();
-      m_end = ilist.size();
+  //The bytes of the elements (not of the spare capacity), e.g. to hash or send them as they are.
+  byte_view as_bytes(void) const{
+    static_assert(std::is_trivially_copyable_v<T>, "as_bytes needs trivially copyable elements");
+    return { reinterpret_cast<const std::byte*>(m_storage), m_end * sizeof(T) };
+  }
 
-      delete [] m_storage;
+  // [VII] Friend functions.
+  friend std::ostream& operator<<(std::ostream& os_, const vector& v_) {
+    // Only [0, m_end) holds constructed objects; the spare capacity is raw memory.
+    os_ << "{ ";
+    for (auto i{0u}; i < v_.m_end; ++i) {
+      os_ << v_.m_storage[i] << " ";
+    }
+    os_ << "| }, m_end=" << v_.m_end << ", m_capacity=" << v_.m_capacity;
 
-      m_storage = newStorage;
+    return os_;
+  }
+  friend void swap(vector& first_, vector& second_)
+    noexcept(InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>) {
+    // enable ADL
+    using std::swap;
 
-      std::copy(ilist.begin(), ilist.end(), m_storage);
+    if constexpr (InlineCapacity > 0) {
+      if (first_.is_inline() || second_.is_inline()) {
+        // Inline elements are tied to their object: exchange the contents by moving them.
+        vector tmp(std::move(first_));
+        first_ = std::move(second_);
+        second_ = std::move(tmp);
+        return;
+      }
     }
+
+    // Allocators are exchanged only if they ask for it; otherwise they must compare equal.
+    if constexpr (alloc_traits::propagate_on_container_swap::value)
+      swap(first_.m_alloc, second_.m_alloc);
+    else
+      assert(first_.m_alloc == second_.m_alloc);
+
+    // Swap each member of the class.
+    swap(first_.m_end, second_.m_end);
+    swap(first_.m_capacity, second_.m_capacity);
+    swap(first_.m_storage, second_.m_storage);
   }
 
-  template <typename InputItr>
-  void assign(InputItr first, InputItr last){
-    size_type dif = last - first;
-
-    if(dif <= size()){
-      m_end = dif;
-      
-      size_type i = 0;
-      for (auto it = first; it < last; it++, i++){
-        m_storage[i] = *it;
+ private:
+  SC_CONSTEXPR20 bool full(void) const{ return m_capacity == m_end; }
+
+  //=== Instrumentation hooks (see vector_stats.h): they compile to nothing without SC_VECTOR_STATS.
+  /// Whether the hooks record anything: never in a constant expression, which has no counters to bump.
+  static constexpr bool counting(void) { return vector_stats_enabled && !detail::is_constant_evaluated(); }
+  static SC_CONSTEXPR20 void note_copies(size_type n) {
+    if (counting()) detail::local_vector_counters().copies.add(n);
+  }
+  static SC_CONSTEXPR20 void note_moves(size_type n) {
+    if (counting()) detail::local_vector_counters().moves.add(n);
+  }
+  static SC_CONSTEXPR20 void note_bitwise(size_type n) {
+    if (counting()) detail::local_vector_counters().bitwise.add(n);
+  }
+  /// Counts `n` elements built from a range read through `Itr`.
+  template <typename Itr>
+  static SC_CONSTEXPR20 void note_transfer(size_type n) {
+    if constexpr (detail::is_move_iterator<Itr>::value) note_moves(n);
+    else note_copies(n);
+  }
+  /// Counts an element built from `Args`: a copy or a move when it is built from another T.
+  template <typename... Args>
+  static SC_CONSTEXPR20 void note_construct(void) {
+    if constexpr (sizeof...(Args) == 1) {
+      if constexpr ((std::is_same_v<std::decay_t<Args>, T> && ...)) {
+        if constexpr ((std::is_lvalue_reference_v<Args> && ...)) note_copies(1);
+        else note_moves(1);
       }
     }
-    else{
-      T* newStorage = new T[dif];
-      m_capacity = dif;
-      m_end = dif;
+  }
+  /// Counts a reallocation of this vector.
+  SC_CONSTEXPR20 void note_reallocation(void) {
+#ifdef SC_VECTOR_STATS
+    if (!counting()) return;
+    auto& counters = detail::local_vector_counters();
+    counters.reallocations.add(1);
+    counters.max_reallocations.raise(++m_reallocations);
+#endif
+  }
+  /// Records the current unused capacity, if it is the biggest seen so far.
+  SC_CONSTEXPR20 void note_slack(void) const {
+    if (counting())
+      detail::local_vector_counters().peak_slack_bytes.raise((m_capacity - m_end) * sizeof(T));
+  }
 
-      delete [] m_storage;
+  /// What the iterators compare to tell whether they are stale: only hardened builds have it.
+  SC_CONSTEXPR20 const std::size_t* generation(void) const {
+#if SC_VECTOR_CHECK_LEVEL == SC_VECTOR_CHECKS_hardened
+    return &m_generation;
+#else
+    return nullptr;
+#endif
+  }
 
-      m_storage = newStorage;
+  /// Tells whether the elements currently live in the inline buffer.
+  SC_CONSTEXPR20 bool is_inline(void) const {
+    if constexpr (InlineCapacity == 0) return false;
+    else return m_storage == m_inline.data();
+  }
 
-      size_type i = 0;
-      for (auto it = first; it < last; it++, i++){
-        m_storage[i] = *it;
+  /// Returns raw, uninitialized storage for at least `n` elements (no constructor is called).
+  /*!
+   * The inline buffer is used when `n` fits and it is not already holding the current elements;
+   * otherwise the memory comes from the allocator (through `allocate_at_least`, when it has one,
+   * so padding it adds becomes capacity). `n` is updated to the slots actually obtained.
+   * Without an allocator (`fixed_capacity`) asking for more than the inline buffer throws, before
+   * the operation that asked has changed anything.
+   */
+  SC_CONSTEXPR20 pointer allocate(size_type& n) {
+    if constexpr (InlineCapacity > 0) {
+      if (n <= InlineCapacity && !is_inline()) {
+        n = InlineCapacity;
+        return m_inline.data();
       }
     }
+    if constexpr (fixed_capacity) throw std::length_error{"sc::static_vector: capacity exceeded"};
+    if (n == 0) return nullptr;
+    pointer p;
+    if constexpr (has_allocate_at_least<Allocator>::value) {
+      auto result = m_alloc.allocate_at_least(n);
+      p = result.ptr;
+      n = result.count;
+    }
+    else
+      p = alloc_traits::allocate(m_alloc, n);
+    if (counting()) {
+      auto& counters = detail::local_vector_counters();
+      counters.allocations.add(1);
+      counters.bytes_allocated.add(n * sizeof(T));
+    }
+    return p;
   }
 
-  iterator erase(iterator first, iterator last){
-    auto dif = last - first;
+  /// Releases `n` slots obtained from `allocate()`. Live elements must be destroyed beforehand.
+  SC_CONSTEXPR20 void deallocate(pointer p, size_type n) {
+#if SC_VECTOR_CHECK_LEVEL == SC_VECTOR_CHECKS_hardened
+    if (p == m_storage) ++m_generation; // The current buffer goes: iterators into it become stale.
+#endif
+    if (p != nullptr && p != m_inline.data()) {
+      alloc_traits::deallocate(m_alloc, p, n);
+      if (counting()) {
+        auto& counters = detail::local_vector_counters();
+        counters.deallocations.add(1);
+        counters.bytes_deallocated.add(n * sizeof(T));
+      }
+    }
+  }
 
-    if((first > last) || (first < begin() || last > end()))  throw std::out_of_range{ "The method 'erase' cannot access this range of positions" };
+  /// Points the (empty) vector back to its initial storage: the inline buffer, or nothing.
+  SC_CONSTEXPR20 void reset_storage(void) {
+    m_storage = m_inline.data();
+    m_capacity = InlineCapacity;
+    m_end = 0;
+  }
 
-    for (iterator it = first; it < end()-dif; it++){
-      *it = *(it+dif);
+  /// Gives up the current buffer (destroying its elements) and leaves the vector empty.
+  SC_CONSTEXPR20 void release(void) {
+    std::destroy(m_storage, m_storage + m_end);
+    deallocate(m_storage, m_capacity);
+    reset_storage();
+  }
+
+  /// Builds copies of [first, last) in raw memory at `dest`, as `std::move_if_noexcept` would.
+  /*!
+   * Trivially relocatable elements are copied bitwise with one `memcpy`. Otherwise elements
+   * are moved when T's move constructor cannot throw (or T cannot be copied), and copied
+   * otherwise, so a throwing relocation always leaves the source intact.
+   * The source range must then be released with `destroy_relocated()`.
+   */
+  static SC_CONSTEXPR20 void uninitialized_relocate(pointer first, pointer last, pointer dest) {
+    if (detail::is_constant_evaluated()) {
+      // Neither memcpy nor the uninitialized_* algorithms may run in a constant expression.
+      for (; first != last; ++first, ++dest) detail::construct_at(dest, std::move_if_noexcept(*first));
+    }
+    else if constexpr (is_trivially_relocatable_v<T>) {
+      if (first != last)
+        std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), (last - first) * sizeof(T));
+      note_bitwise(last - first);
+    }
+    else if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+      std::uninitialized_move(first, last, dest);
+      note_moves(last - first);
+    }
+    else {
+      std::uninitialized_copy(first, last, dest);
+      note_copies(last - first);
     }
+  }
 
-    m_end -= dif;
-    return first;
+  /// Ends the lifetime of a range that `uninitialized_relocate()` has just copied from.
+  static SC_CONSTEXPR20 void destroy_relocated(pointer first, pointer last) {
+    // A bitwise relocation transfers ownership: the source must not be destroyed.
+    if (!is_trivially_relocatable_v<T> || detail::is_constant_evaluated())
+      std::destroy(first, last);
   }
 
-  iterator erase(const_iterator first, const_iterator last){
-    auto dif = last - first;
+  /// Slides the (trivially relocatable) elements of [first, last) to `dest` with one `memmove`.
+  static SC_CONSTEXPR20 void shift_relocate(pointer first, pointer last, pointer dest) {
+    if (detail::is_constant_evaluated()) {
+      // One element at a time, in the direction that reads each slot before overwriting it.
+      if (dest < first)
+        for (; first != last; ++first, ++dest) detail::construct_at(dest, std::move(*first));
+      else
+        for (pointer out = dest + (last - first); last != first;) detail::construct_at(--out, std::move(*--last));
+    }
+    else if (first != last)
+      detail::move_bytes(static_cast<void*>(dest), static_cast<const void*>(first), (last - first) * sizeof(T));
+  }
+
+  /// Relocates the live range into a fresh buffer of `new_cap` slots (`new_cap >= m_end`).
+  SC_CONSTEXPR20 void reallocate(size_type new_cap) {
+    pointer newstorage = allocate(new_cap); // May round `new_cap` up to the inline capacity.
+    try { uninitialized_relocate(m_storage, m_storage + m_end, newstorage); }
+    catch (...) { deallocate(newstorage, new_cap); throw; }
 
-    if((first > last) || (first < begin() || last > end()))  throw std::out_of_range{ "The method 'erase' cannot access this range of positions" };
+    destroy_relocated(m_storage, m_storage + m_end);
+    deallocate(m_storage, m_capacity);
+    if (m_capacity > 0) note_reallocation();
 
+    m_capacity = new_cap;
+    m_storage = newstorage;
+    note_slack();
+  }
 
-    for (iterator it = first; it < end()-dif; it++){
-      *it = *(it+dif);
+  /// Replaces the content with `count` elements that `build(dest, lo, hi)` constructs in [dest + lo, dest + hi).
+  /*!
+   * The chunks are built concurrently. A buffer that is big enough is reused (its elements are
+   * destroyed first), otherwise the new buffer replaces the old one only once every chunk is built.
+   * If a chunk throws, the chunks that were built are destroyed again.
+   */
+  template <typename Build>
+  void parallel_rebuild(size_type count, std::size_t chunks, Build build) {
+    bool reuse = count <= m_capacity;
+    if (reuse) clear();
+    size_type new_cap = count;
+    pointer dest = reuse ? m_storage : allocate(new_cap);
+    std::unique_ptr<bool[]> built{new bool[chunks]()};
+    try {
+      detail::parallel_for_chunks(count, chunks, [&](std::size_t chunk, std::size_t lo, std::size_t hi){
+        build(dest, lo, hi);
+        built[chunk] = true;
+      });
+    }
+    catch (...) {
+      for (std::size_t i{0}; i < chunks; ++i)
+        if (built[i])
+          std::destroy(dest + detail::chunk_begin(count, chunks, i), dest + detail::chunk_begin(count, chunks, i + 1));
+      if (!reuse) deallocate(dest, new_cap);
+      throw;
     }
+    if (!reuse) {
+      std::destroy(m_storage, m_storage + m_end);
+      deallocate(m_storage, m_capacity);
+      m_storage = dest;
+      m_capacity = new_cap;
+    }
+    m_end = count;
+    note_slack();
+  }
 
-    m_end -= dif;
-    return first;
+  /// Whether the elements of `Itr` are contiguous Ts that can be copied with `memcpy`.
+  template <typename Itr>
+  static constexpr bool is_memcpy_source(void) {
+    using source_type = typename std::iterator_traits<Itr>::value_type;
+    if constexpr (!std::is_trivially_copyable_v<T> || !std::is_same_v<std::remove_cv_t<source_type>, T>)
+      return false;
+#if __cplusplus >= 202002L
+    else if constexpr (std::contiguous_iterator<Itr>)
+      return true;
+#endif
+    else
+      return std::is_pointer_v<Itr> || std::is_same_v<Itr, iterator> || std::is_same_v<Itr, const_iterator>;
   }
 
-  iterator erase(const_iterator pos){
-    if (pos >= begin() && pos < end()){
-      for (iterator it = pos; it < end()-1; ++it){
-        *it = *(it+1);
-      }
-      m_end--; 
-	    
-      return pos;
+  /// Builds copies of the `count` elements starting at `first` in raw memory at `dest`.
+  template <typename FwdItr>
+  static SC_CONSTEXPR20 void uninitialized_copy_count(FwdItr first, size_type count, pointer dest) {
+    if (detail::is_constant_evaluated()) {
+      for (; count > 0; --count, ++first, ++dest) detail::construct_at(dest, *first);
+    }
+    else if constexpr (is_memcpy_source<FwdItr>()) {
+      if (count > 0) std::memcpy(static_cast<void*>(dest), static_cast<const void*>(&*first), count * sizeof(T));
     }
-    else throw std::out_of_range{ "The method 'erase' cannot access this position" }; 
+    else
+      std::uninitialized_copy_n(first, count, dest);
   }
 
-  iterator erase(iterator pos){
-    if (pos >= begin() && pos < end()){
-      for (iterator it = pos; it < end()-1; ++it){
-        *it = *(it+1);
-      }
-      m_end--; 
-      return pos;
-   }
-   else throw std::out_of_range{ "The method 'erase' cannot access this position" }; 
+  /// Appends the elements of a single-pass range, one by one.
+  template <typename InputItr>
+  SC_CONSTEXPR20 void append_input(InputItr first, InputItr last) {
+    for (; first != last; ++first)
+      emplace_at(m_end, *first);
   }
 
-  // [V] Element access
-  const_reference back(void) const { 
-    if(m_end > 0)
-      return m_storage[m_end - 1];
-    else throw std::out_of_range { "The method 'back' cannot access the index of last position" };
+  /// Inserts [first, last) before index `idx`.
+  template <typename InputItr>
+  iterator insert_range(size_type idx, InputItr first, InputItr last) {
+    if constexpr (is_forward_iterator_v<InputItr>) {
+      return insert_n(idx, first, std::distance(first, last));
+    }
+    else {
+      // The length is unknown until the range is read: append it, then rotate it into place.
+      size_type old_end = m_end;
+      append_input(first, last);
+      std::rotate(m_storage + idx, m_storage + old_end, m_storage + m_end);
+      return begin() + idx;
+    }
   }
 
-  const_reference front(void) const {
-    if(m_end > 0)
-      return m_storage[0];
-    else throw std::out_of_range { "The method 'front' cannot access the index of first position" };
+  /// Replaces the content with the `count` elements starting at `first`.
+  template <typename FwdItr>
+  void assign_range(FwdItr first, size_type count) {
+    if constexpr (is_memcpy_source<FwdItr>()) {
+      // Trivially copyable: overwriting and constructing are the same bitwise copy.
+      if (count > m_capacity) {
+        size_type new_cap = count;
+        pointer newStorage = allocate(new_cap);
+        uninitialized_copy_count(first, count, newStorage);
+        deallocate(m_storage, m_capacity);
+        m_storage = newStorage;
+        m_capacity = new_cap;
+      }
+      else if (count > 0) {
+        // memmove: the source may be a part of this very vector.
+        std::memmove(static_cast<void*>(m_storage), static_cast<const void*>(&*first), count * sizeof(T));
+      }
+    }
+    else if (count > m_capacity) {
+      size_type new_cap = count;
+      pointer newStorage = allocate(new_cap);
+      try { uninitialized_copy_count(first, count, newStorage); }
+      catch (...) { deallocate(newStorage, new_cap); throw; }
+      std::destroy(m_storage, m_storage + m_end);
+      deallocate(m_storage, m_capacity);
+      m_storage = newStorage;
+      m_capacity = new_cap;
+    }
+    else if (count > m_end) {
+      // Overwrite the live prefix, then construct the remainder in raw memory.
+      FwdItr mid = std::next(first, m_end);
+      std::copy(first, mid, m_storage);
+      std::uninitialized_copy_n(mid, count - m_end, m_storage + m_end);
+    }
+    else {
+      std::copy_n(first, count, m_storage);
+      std::destroy(m_storage + count, m_storage + m_end);
+    }
+    m_end = count;
+    note_transfer<FwdItr>(count);
+    note_slack();
   }
 
-  reference back(void){
-    if(m_end > 0)
-      return m_storage[m_end - 1];
-    else throw std::out_of_range { "The method 'back' cannot access the index of last position" };
+  /// Shrinks to `count` elements, or grows by building `count - size()` elements with `construct(slot, n)`.
+  /*!
+   * Growing past the capacity follows the growth policy; the new elements are built in the new
+   * buffer before the old one is released, so `construct` may read from the current elements.
+   */
+  template <typename Construct>
+  void resize_with(size_type count, Construct construct) {
+    if (count <= m_end) {
+      std::destroy(m_storage + count, m_storage + m_end);
+      m_end = count;
+      note_slack();
+    }
+    else if (count > m_capacity) {
+      size_type n = count - m_end;
+      grow_and_insert(m_end, n, grow_capacity(count), [&](pointer slot){ construct(slot, n); });
+    }
+    else {
+      construct(m_storage + m_end, count - m_end);
+      m_end = count;
+    }
   }
 
-  reference front(void){
-    if(m_end > 0)
-      return m_storage[0];
-    else throw std::out_of_range { "The method 'front' cannot access the index of first position" };
+  /// Capacity to grow to when at least `required` slots are needed, as the growth policy says.
+  SC_CONSTEXPR20 size_type grow_capacity(size_type required) const {
+    size_type new_cap = GrowthPolicy::next_capacity(m_capacity, required, sizeof(T));
+    return new_cap < required ? required : new_cap;
   }
 
-  const_reference operator[](size_type idx) const{ return m_storage[idx];}
-  reference operator[](size_type idx){ return m_storage[idx];}
-
-  const_reference at(size_type idx) const{
-    if (idx < size() && idx >= 0)
-      return m_storage[idx]; 
-    else throw std::out_of_range { "The method 'at' cannot access this index" };
+  /// Reallocates to `new_cap` slots leaving a gap of `count` slots at `idx`.
+  /*!
+   * `construct(slot)` must build exactly `count` elements starting at `slot`. It is
+   * called before the old elements are relocated, so it may safely read from them, and if
+   * it throws the vector is left untouched.
+   */
+  template <typename Construct>
+  SC_CONSTEXPR20 void grow_and_insert(size_type idx, size_type count, size_type new_cap, Construct construct) {
+    pointer newstorage = allocate(new_cap);
+    size_type built{0};
+    try {
+      construct(newstorage + idx);
+      built = count;
+      uninitialized_relocate(m_storage, m_storage + idx, newstorage);
+      built += idx;
+      uninitialized_relocate(m_storage + idx, m_storage + m_end, newstorage + idx + count);
+    }
+    catch (...) {
+      if (built > 0) std::destroy(newstorage + idx, newstorage + idx + count);
+      if (built > count) std::destroy(newstorage, newstorage + idx);
+      deallocate(newstorage, new_cap);
+      throw;
+    }
+    destroy_relocated(m_storage, m_storage + m_end);
+    deallocate(m_storage, m_capacity);
+    if (m_capacity > 0) note_reallocation();
+    m_storage = newstorage;
+    m_capacity = new_cap;
+    m_end += count;
+    note_slack();
   }
 
-  reference at(size_type idx){
-    if (idx < size() && idx >= 0)
-        return m_storage[idx]; 
-    else throw std::out_of_range { "The method 'at' cannot access this index" };
+  /// Constructs an element from `args` before index `idx`.
+  /*!
+   * At the end of the live range (or in a fresh buffer) the element is built directly in its
+   * slot; in the middle it is built aside first, since `args` may refer to elements that
+   * are about to be shifted.
+   */
+  template <typename... Args>
+  SC_CONSTEXPR20 iterator emplace_at(size_type idx, Args&&... args) {
+    note_construct<Args...>();
+    if (full()) {
+      // Build the new element in the new buffer first: `args` may live in the old one.
+      grow_and_insert(idx, 1, grow_capacity(m_end + 1),
+                      [&](pointer slot){ detail::construct_at(slot, std::forward<Args>(args)...); });
+    }
+    else if (idx == m_end) {
+      detail::construct_at(m_storage + m_end, std::forward<Args>(args)...);
+      m_end++;
+    }
+    else if constexpr (is_trivially_relocatable_v<T>) {
+      value_type tmp(std::forward<Args>(args)...);
+      // Open a one-slot hole with a single memmove and build the element in it.
+      shift_relocate(m_storage + idx, m_storage + m_end, m_storage + idx + 1);
+      try { detail::construct_at(m_storage + idx, std::move(tmp)); }
+      catch (...) { shift_relocate(m_storage + idx + 1, m_storage + m_end + 1, m_storage + idx); throw; }
+      note_bitwise(m_end - idx);
+      note_moves(1);
+      m_end++;
+    }
+    else {
+      value_type tmp(std::forward<Args>(args)...);
+      note_moves(m_end - idx + 1); // The shifted elements, and `tmp` into its slot.
+      detail::construct_at(m_storage + m_end, std::move(m_storage[m_end - 1]));
+      m_end++;
+      std::move_backward(m_storage + idx, m_storage + m_end - 2, m_storage + m_end - 1);
+      m_storage[idx] = std::move(tmp);
+    }
+    return begin() + idx;
   }
-	
-  pointer data(void){ return m_storage; }
 
-  const_reference data(void) const{return m_storage;}
+  /// Inserts the `count` elements starting at `first` before index `idx`.
+  template <typename FwdItr>
+  iterator insert_n(size_type idx, FwdItr first, size_type count) {
+    if (count == 0) return begin() + idx;
+    note_transfer<FwdItr>(count);
+
+    // Compared as the room left, not as `m_end + count`, so the in-place path provably fits.
+    if (count > m_capacity - m_end) {
+      grow_and_insert(idx, count, grow_capacity(m_end + count),
+                      [&](pointer slot){ uninitialized_copy_count(first, count, slot); });
+      return begin() + idx;
+    }
 
-  // [VII] Friend functions.
-  friend std::ostream& operator<<(std::ostream& os_, const vector<T>& v_) {
-    os_ << "{ ";
-    for (auto i{0u}; i < v_.m_capacity; ++i) {
-      if (i == v_.m_end) os_ << "| ";
-      os_ << v_.m_storage[i] << " ";
+    pointer pos = m_storage + idx;
+    pointer old_end = m_storage + m_end;
+    size_type n_after = m_end - idx;
+    if constexpr (is_trivially_relocatable_v<T>) {
+      // Slide the tail with a single memmove, then build the new elements in the hole.
+      shift_relocate(pos, old_end, pos + count);
+      try { uninitialized_copy_count(first, count, pos); }
+      catch (...) { shift_relocate(pos + count, old_end + count, pos); throw; }
+      m_end += count;
+      note_bitwise(n_after);
+    }
+    else if (n_after > count) {
+      // The last `count` elements slide into raw memory; the rest shift inside the live range.
+      std::uninitialized_move(old_end - count, old_end, old_end);
+      m_end += count;
+      std::move_backward(pos, pos + (n_after - count), old_end);
+      std::copy_n(first, count, pos);
+      note_moves(n_after);
     }
-    os_ << "}, m_end=" << v_.m_end << ", m_capacity=" << v_.m_capacity;
+    else {
+      // The tail (and part of the new elements) lands entirely in raw memory.
+      FwdItr mid = std::next(first, n_after);
+      std::uninitialized_copy_n(mid, count - n_after, old_end);
+      m_end += count - n_after;
+      std::uninitialized_move(pos, old_end, m_storage + m_end);
+      m_end += n_after;
+      std::copy(first, mid, pos);
+      note_moves(n_after);
+    }
+    return begin() + idx;
+  }
 
-    return os_;
+  /// Moves or builds `value` into slot `idx`: the slots below `live_end` hold an element, the others are raw.
+  template <typename U>
+  void put(size_type idx, size_type live_end, U&& value) {
+    if (idx < live_end) m_storage[idx] = std::forward<U>(value);
+    else detail::construct_at(m_storage + idx, std::forward<U>(value));
   }
-  friend void swap(vector<T>& first_, vector<T>& second_) {
-    // enable ADL
-    using std::swap;
 
-    // Swap each member of the class.
-    swap(first_.m_end, second_.m_end);
-    swap(first_.m_capacity, second_.m_capacity);
-    swap(first_.m_storage, second_.m_storage);
+  /// Inserts `values[j]` before the old index `positions[j]`, for every j < count (see insert_sorted_batch).
+  template <typename PosItr, typename ValItr>
+  void insert_batch(PosItr positions, ValItr values, size_type count) {
+    if (count == 0) return;
+    note_transfer<ValItr>(count);
+    size_type old_end = m_end;
+    size_type new_end = m_end + count;
+    // The old elements in front of positions[j] and after positions[j - 1]: they end up j slots further.
+    auto run_begin = [&](size_type j){ return j == 0 ? size_type{0} : size_type(positions[j - 1]); };
+    auto run_end = [&](size_type j){ return j < count ? size_type(positions[j]) : old_end; };
+
+    if (new_end > m_capacity) {
+      size_type new_cap = grow_capacity(new_end);
+      pointer fresh = allocate(new_cap);
+      // The values are built first, in their final slots, so a throwing one leaves us untouched.
+      size_type built{0};
+      try {
+        for (; built < count; ++built)
+          detail::construct_at(fresh + positions[built] + built, values[built]);
+      }
+      catch (...) {
+        for (size_type j{0}; j < built; ++j) std::destroy_at(fresh + positions[j] + j);
+        deallocate(fresh, new_cap);
+        throw;
+      }
+      // Then each run of old elements, once, into the gaps between them.
+      size_type j{0};
+      try {
+        for (; j <= count; ++j)
+          uninitialized_relocate(m_storage + run_begin(j), m_storage + run_end(j), fresh + run_begin(j) + j);
+      }
+      catch (...) {
+        // Only a copying relocation throws, and the old elements are still intact.
+        for (size_type r{0}; r < j; ++r) std::destroy(fresh + run_begin(r) + r, fresh + run_end(r) + r);
+        for (size_type r{0}; r < count; ++r) std::destroy_at(fresh + positions[r] + r);
+        deallocate(fresh, new_cap);
+        throw;
+      }
+      destroy_relocated(m_storage, m_storage + m_end);
+      deallocate(m_storage, m_capacity);
+      if (m_capacity > 0) note_reallocation();
+      m_storage = fresh;
+      m_capacity = new_cap;
+    }
+    else if constexpr (is_trivially_relocatable_v<T> &&
+                       std::is_nothrow_constructible_v<T, decltype(values[0])>) {
+      // From the last run down, each run slides with one memmove and the value fills the hole.
+      for (size_type j{count}; j-- > 0;) {
+        shift_relocate(m_storage + run_begin(j + 1), m_storage + run_end(j + 1), m_storage + run_begin(j + 1) + j + 1);
+        note_bitwise(run_end(j + 1) - run_begin(j + 1));
+        detail::construct_at(m_storage + positions[j] + j, values[j]);
+      }
+    }
+    else {
+      // From the back: every old element moves once, to its final slot; those past old_end are raw.
+      size_type dest = new_end;
+      size_type src = old_end;
+      try {
+        for (size_type j{count}; j-- > 0;) {
+          for (; src > size_type(positions[j]); dest--, src--) put(dest - 1, old_end, std::move(m_storage[src - 1]));
+          put(dest - 1, old_end, values[j]);
+          dest--;
+        }
+      }
+      catch (...) {
+        // The old slots stay live (some moved-from); the raw ones built so far are destroyed.
+        std::destroy(m_storage + std::max(dest, old_end), m_storage + new_end);
+        throw;
+      }
+      note_moves(old_end - positions[0]);
+    }
+    m_end = new_end;
+    note_slack();
   }
 
- private:
-  bool full(void) const{ return m_capacity == m_end; }
+  /// Merges the `count` sorted elements at `values` into the vector (see merge_sorted).
+  template <typename ValItr, typename Compare>
+  void merge_sorted_n(ValItr values, size_type count, Compare& comp) {
+    for (size_type j{1}; j < count; ++j)
+      detail::check(!comp(values[j], values[j - 1]), "merge_sorted: the range must be sorted");
+    // Where each value goes: after every element of the vector that is not greater than it.
+    using index_allocator = typename alloc_traits::template rebind_alloc<size_type>;
+    vector<size_type, index_allocator, InlineCapacity, GrowthPolicy> positions(count, index_allocator(m_alloc));
+    size_type i{0};
+    for (size_type j{0}; j < count; ++j) {
+      while (i < m_end && !comp(values[j], m_storage[i])) ++i;
+      positions[j] = i;
+    }
+    insert_batch(positions.begin(), values, count);
+  }
+
+  /// Removes the `count` elements starting at index `idx`.
+  iterator erase_n(size_type idx, size_type count) {
+    pointer pos = m_storage + idx;
+    if constexpr (is_trivially_relocatable_v<T>) {
+      std::destroy(pos, pos + count);
+      shift_relocate(pos + count, m_storage + m_end, pos);
+      note_bitwise(m_end - idx - count);
+    }
+    else {
+      std::move(pos + count, m_storage + m_end, pos);
+      std::destroy(m_storage + m_end - count, m_storage + m_end);
+      note_moves(m_end - idx - count);
+    }
+    m_end -= count;
+    note_slack();
+    return begin() + idx;
+  }
   
-  size_type m_end;        //!< The list's current size (or index past-last valid element).
-  size_type m_capacity;   //!< The list's storage capacity.
-  T* m_storage;           //!< The list's data storage area.
+  SC_NO_UNIQUE_ADDRESS allocator_type m_alloc; //!< Provides the list's storage.
+  size_type m_end{0};          //!< The list's current size (or index past-last valid element).
+  size_type m_capacity{0};     //!< The list's storage capacity.
+  T* m_storage{nullptr};       //!< The list's data storage area (only [0, m_end) is constructed).
+  SC_NO_UNIQUE_ADDRESS inline_buffer<InlineCapacity> m_inline; //!< Room for the first elements (small_vector).
+#if SC_VECTOR_CHECK_LEVEL == SC_VECTOR_CHECKS_hardened
+  std::size_t m_generation{0}; //!< How many buffers this vector has given up (see checks.h).
+#endif
+#ifdef SC_VECTOR_STATS
+  size_type m_reallocations{0}; //!< How many times this vector reallocated (see vector_stats.h).
+#endif
 };
 
 // [VI] Operators
-template <typename T>
-bool operator==(const vector<T>& a, const vector<T>& b){
-  if (a.size() == b.size()) {
-        for (auto i = 0; i < b.size(); i++)
-        {
-          if (a.at(i) != b.at(i)) 
-            return false;
-        }         
-        return true;
-    } else return false;
+template <typename T, typename Alloc, std::size_t N, typename G>
+SC_CONSTEXPR20 bool operator==(const vector<T, Alloc, N, G>& a, const vector<T, Alloc, N, G>& b){
+  if (a.size() != b.size()) return false;
+  if (detail::is_constant_evaluated()) return std::equal(a.begin(), a.end(), b.begin());
+  // One pass over both buffers, vectorized for integer and floating point elements.
+  return a.empty() || simd::equal(&a[0], &b[0], a.size());
 }
-template <typename T>
-bool operator!=(const vector<T>& a, const vector<T>& b){
+template <typename T, typename Alloc, std::size_t N, typename G>
+SC_CONSTEXPR20 bool operator!=(const vector<T, Alloc, N, G>& a, const vector<T, Alloc, N, G>& b){
   return a == b ? false : true;
 }
 
+/// Removes the elements equal to `value`; returns how many were removed (see `vector::remove_if`).
+template <typename T, typename Alloc, std::size_t N, typename G, typename U>
+typename vector<T, Alloc, N, G>::size_type erase(vector<T, Alloc, N, G>& vec, const U& value){
+  return vec.remove_if([&](const T& e){ return e == value; });
+}
+
+/// Removes the elements for which `pred` is true, in one compaction pass; returns how many were removed.
+template <typename T, typename Alloc, std::size_t N, typename G, typename Pred>
+typename vector<T, Alloc, N, G>::size_type erase_if(vector<T, Alloc, N, G>& vec, Pred pred){
+  return vec.remove_if(pred);
+}
+
+/// `a == b`, with the comparison split across several threads (see parallel.h).
+template <typename T, typename Alloc, std::size_t N, typename G>
+bool equal(const parallel_policy& policy, const vector<T, Alloc, N, G>& a, const vector<T, Alloc, N, G>& b){
+  if (a.size() != b.size()) return false;
+  std::size_t chunks = detail::parallel_chunks(a.size(), policy);
+  if (chunks <= 1) return a == b;
+  std::unique_ptr<bool[]> same{new bool[chunks]()};
+  detail::parallel_for_chunks(a.size(), chunks, [&](std::size_t chunk, std::size_t lo, std::size_t hi){
+    same[chunk] = simd::equal(&a[lo], &b[lo], hi - lo);
+  });
+  return std::all_of(same.get(), same.get() + chunks, [](bool s){ return s; });
+}
+
 } // namespace sc.
 
+// vector_view needs the complete MyForwardIterator, and vector::subview() needs vector_view.
+#include "vector_view.h"
+
 #endif
@@ -0,0 +1,243 @@
+#ifndef _VECTOR_SIMD_H_
+#define _VECTOR_SIMD_H_
+
+#include <algorithm>    // std::equal, std::find, std::count, std::fill_n
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t
+#include <cstring>      // std::memcpy, std::memcmp
+#include <type_traits>  // std::is_integral_v, std::is_same_v
+
+// Vectorized scanning/filling kernels used by sc::vector for arithmetic element types.
+// They rely on the GCC/Clang vector extensions: on x86 the 16-byte (SSE2) version is the
+// baseline and a 32-byte (AVX2) version is picked at run time when the CPU has it; on ARM the
+// 16-byte version maps to NEON. Anything else, or a build with -DSC_VECTOR_NO_SIMD, gets the
+// scalar <algorithm> fallbacks.
+#if !defined(SC_VECTOR_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#define SC_SIMD_X86 1
+#elif !defined(SC_VECTOR_NO_SIMD) && defined(__GNUC__) && defined(__ARM_NEON)
+#define SC_SIMD_NEON 1
+#endif
+
+/// Sequence container namespace.
+namespace sc {
+namespace simd {
+
+/// Whether the kernels handle T: integers (but not bool), `float` and `double`.
+template <typename T>
+inline constexpr bool is_vectorizable_v =
+#if defined(SC_SIMD_X86) || defined(SC_SIMD_NEON)
+    (std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_same_v<T, float> || std::is_same_v<T, double>;
+#else
+    false;
+#endif
+
+namespace detail {
+
+#if defined(SC_SIMD_X86) || defined(SC_SIMD_NEON)
+
+#define SC_SIMD_INLINE [[gnu::always_inline]] inline
+
+/// A native vector of `Bytes / sizeof(T)` lanes of T.
+template <typename T, std::size_t Bytes>
+struct lanes {
+  typedef T type __attribute__((vector_size(Bytes)));
+  static constexpr std::size_t count = Bytes / sizeof(T);
+};
+
+// Vectors are passed by reference only: a 32-byte vector by value would change the ABI of
+// the functions compiled without AVX.
+template <typename T, std::size_t Bytes>
+SC_SIMD_INLINE void load(typename lanes<T, Bytes>::type& v, const T* p) {
+  std::memcpy(&v, p, Bytes);
+}
+
+/// Whether any lane of a comparison mask is set.
+template <std::size_t Bytes, typename Mask>
+SC_SIMD_INLINE bool any_lane(const Mask& m) {
+  auto w = reinterpret_cast<typename lanes<std::uint64_t, Bytes>::type>(m);
+  std::uint64_t any{w[0] | w[1]};
+  if constexpr (Bytes == 32) any |= w[2] | w[3];
+  return any != 0;
+}
+
+template <typename T, std::size_t Bytes>
+SC_SIMD_INLINE bool equal_body(const T* a, const T* b, std::size_t n) {
+  constexpr std::size_t L = lanes<T, Bytes>::count;
+  typename lanes<T, Bytes>::type a0, a1, a2, a3, b0, b1, b2, b3;
+  std::size_t i{0};
+  // Four vectors per check keeps the branch off the critical path.
+  for (; i + 4 * L <= n; i += 4 * L) {
+    load<T, Bytes>(a0, a + i);         load<T, Bytes>(b0, b + i);
+    load<T, Bytes>(a1, a + i + L);     load<T, Bytes>(b1, b + i + L);
+    load<T, Bytes>(a2, a + i + 2 * L); load<T, Bytes>(b2, b + i + 2 * L);
+    load<T, Bytes>(a3, a + i + 3 * L); load<T, Bytes>(b3, b + i + 3 * L);
+    auto diff = (a0 != b0) | (a1 != b1) | (a2 != b2) | (a3 != b3);
+    if (any_lane<Bytes>(diff)) return false;
+  }
+  for (; i + L <= n; i += L) {
+    load<T, Bytes>(a0, a + i);
+    load<T, Bytes>(b0, b + i);
+    if (any_lane<Bytes>(a0 != b0)) return false;
+  }
+  for (; i < n; ++i)
+    if (!(a[i] == b[i])) return false;
+  return true;
+}
+
+template <typename T, std::size_t Bytes>
+SC_SIMD_INLINE std::size_t find_body(const T* p, std::size_t n, T value) {
+  constexpr std::size_t L = lanes<T, Bytes>::count;
+  const typename lanes<T, Bytes>::type needle = typename lanes<T, Bytes>::type{} + value;
+  typename lanes<T, Bytes>::type v;
+  std::size_t i{0};
+  for (; i + L <= n; i += L) {
+    load<T, Bytes>(v, p + i);
+    if (any_lane<Bytes>(v == needle)) break;
+  }
+  for (; i < n; ++i)
+    if (p[i] == value) return i;
+  return n;
+}
+
+template <typename T, std::size_t Bytes>
+SC_SIMD_INLINE std::size_t count_body(const T* p, std::size_t n, T value) {
+  constexpr std::size_t L = lanes<T, Bytes>::count;
+  const typename lanes<T, Bytes>::type needle = typename lanes<T, Bytes>::type{} + value;
+  using mask = decltype(needle == needle);
+  using lane = std::remove_cv_t<std::remove_reference_t<decltype(mask{}[0])>>;
+  // Each lane of `acc` counts its matches; narrow lanes are emptied before they can overflow.
+  constexpr std::size_t flush_every = sizeof(lane) >= 4 ? std::size_t(-1) : (std::size_t(1) << (8 * sizeof(lane) - 1)) - 1;
+  typename lanes<T, Bytes>::type v;
+  std::size_t total{0}, i{0};
+  while (i + L <= n) {
+    mask acc{};
+    for (std::size_t blocks{0}; blocks < flush_every && i + L <= n; ++blocks, i += L) {
+      load<T, Bytes>(v, p + i);
+      acc -= (v == needle);  // A match is -1.
+    }
+    lane counts[L];
+    std::memcpy(counts, &acc, Bytes);
+    for (auto c : counts) total += static_cast<std::size_t>(c);
+  }
+  for (; i < n; ++i)
+    if (p[i] == value) ++total;
+  return total;
+}
+
+template <typename T, std::size_t Bytes>
+SC_SIMD_INLINE void fill_body(T* p, std::size_t n, T value) {
+  constexpr std::size_t L = lanes<T, Bytes>::count;
+  const typename lanes<T, Bytes>::type v = typename lanes<T, Bytes>::type{} + value;
+  // The trip count up front: the tail loop then provably runs fewer than L times.
+  const std::size_t body = n - n % L;
+  std::size_t i{0};
+  for (; i < body; i += L)
+    std::memcpy(p + i, &v, Bytes);
+  for (; i < n; ++i)
+    p[i] = value;
+}
+
+#if defined(SC_SIMD_X86)
+/// Whether the CPU running the program has AVX2 (checked once).
+inline bool has_avx2(void) {
+  static const bool has = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+  }();
+  return has;
+}
+
+template <typename T>
+__attribute__((target("avx2"))) bool equal_avx2(const T* a, const T* b, std::size_t n) { return equal_body<T, 32>(a, b, n); }
+template <typename T>
+__attribute__((target("avx2"))) std::size_t find_avx2(const T* p, std::size_t n, T value) { return find_body<T, 32>(p, n, value); }
+template <typename T>
+__attribute__((target("avx2"))) std::size_t count_avx2(const T* p, std::size_t n, T value) { return count_body<T, 32>(p, n, value); }
+template <typename T>
+__attribute__((target("avx2"))) void fill_avx2(T* p, std::size_t n, T value) { fill_body<T, 32>(p, n, value); }
+#endif
+
+#undef SC_SIMD_INLINE
+
+#endif // SC_SIMD_X86 || SC_SIMD_NEON
+
+} // namespace detail.
+
+/// The instruction set the kernels run with on this machine: "avx2", "sse2", "neon" or "scalar".
+inline const char* active_isa(void) {
+#if defined(SC_SIMD_X86)
+  return detail::has_avx2() ? "avx2" : "sse2";
+#elif defined(SC_SIMD_NEON)
+  return "neon";
+#else
+  return "scalar";
+#endif
+}
+
+// Each kernel takes the vectorized path when T qualifies and falls back to <algorithm> otherwise.
+
+/// Whether the `n` elements at `a` and `b` compare equal with `==` (so NaN != NaN, -0.0 == 0.0).
+template <typename T>
+bool equal(const T* a, const T* b, std::size_t n) {
+  if constexpr (is_vectorizable_v<T> && std::is_integral_v<T>) {
+    // Integers are equal exactly when their bytes are: libc's memcmp is already vectorized
+    // (and dispatched at run time), and beats the lane-by-lane compare here.
+    return n == 0 || std::memcmp(a, b, n * sizeof(T)) == 0;
+  }
+  else if constexpr (is_vectorizable_v<T>) {
+#if defined(SC_SIMD_X86)
+    if (detail::has_avx2()) return detail::equal_avx2(a, b, n);
+#endif
+#if defined(SC_SIMD_X86) || defined(SC_SIMD_NEON)
+    return detail::equal_body<T, 16>(a, b, n);
+#endif
+  }
+  return std::equal(a, a + n, b);
+}
+
+/// Index of the first of the `n` elements at `p` equal to `value`, or `n`.
+template <typename T>
+std::size_t find(const T* p, std::size_t n, const T& value) {
+  if constexpr (is_vectorizable_v<T>) {
+#if defined(SC_SIMD_X86)
+    if (detail::has_avx2()) return detail::find_avx2(p, n, value);
+#endif
+#if defined(SC_SIMD_X86) || defined(SC_SIMD_NEON)
+    return detail::find_body<T, 16>(p, n, value);
+#endif
+  }
+  return std::find(p, p + n, value) - p;
+}
+
+/// How many of the `n` elements at `p` are equal to `value`.
+template <typename T>
+std::size_t count(const T* p, std::size_t n, const T& value) {
+  if constexpr (is_vectorizable_v<T>) {
+#if defined(SC_SIMD_X86)
+    if (detail::has_avx2()) return detail::count_avx2(p, n, value);
+#endif
+#if defined(SC_SIMD_X86) || defined(SC_SIMD_NEON)
+    return detail::count_body<T, 16>(p, n, value);
+#endif
+  }
+  return std::count(p, p + n, value);
+}
+
+/// Writes `value` to the `n` slots at `p` (which, T being arithmetic, may be raw storage).
+template <typename T>
+void fill(T* p, std::size_t n, const T& value) {
+  if constexpr (is_vectorizable_v<T>) {
+#if defined(SC_SIMD_X86)
+    if (detail::has_avx2()) return detail::fill_avx2(p, n, value);
+#endif
+#if defined(SC_SIMD_X86) || defined(SC_SIMD_NEON)
+    return detail::fill_body<T, 16>(p, n, value);
+#endif
+  }
+  std::fill_n(p, n, value);
+}
+
+} // namespace simd.
+} // namespace sc.
+
+#endif
@@ -0,0 +1,178 @@
+#ifndef _VECTOR_STATS_H_
+#define _VECTOR_STATS_H_
+
+#include <atomic>       // std::atomic
+#include <cstddef>      // std::size_t
+#include <iostream>     // std::ostream
+#include <mutex>        // std::mutex, std::lock_guard
+#include <vector>       // std::vector (the registry of threads)
+#include <algorithm>    // std::find, std::max
+#include <iterator>     // std::move_iterator
+#include <type_traits>  // std::true_type, std::false_type
+
+// Instrumentation of sc::vector is opt-in: compile with -DSC_VECTOR_STATS to turn it on.
+// It must be defined (or not) the same way in every translation unit of a program.
+
+/// Sequence container namespace.
+namespace sc {
+
+#ifdef SC_VECTOR_STATS
+inline constexpr bool vector_stats_enabled = true;   //!< The hooks in sc::vector record events.
+#else
+inline constexpr bool vector_stats_enabled = false;  //!< The hooks in sc::vector compile to nothing.
+#endif
+
+/// A snapshot of what the vectors did.
+/*!
+ * `copies` and `moves` count element copy/move constructions and assignments performed by the
+ * container itself (when inserting, assigning, shifting or reallocating); `bitwise` counts the
+ * elements relocated with `memcpy`/`memmove` instead (see `sc::is_trivially_relocatable`).
+ * A reallocation is any move of the live elements to a new buffer.
+ */
+struct vector_stats {
+  std::size_t allocations{0};        //!< Calls to the allocator's `allocate`.
+  std::size_t deallocations{0};      //!< Calls to the allocator's `deallocate`.
+  std::size_t bytes_allocated{0};    //!< Total bytes requested from the allocator.
+  std::size_t bytes_deallocated{0};  //!< Total bytes given back to the allocator.
+  std::size_t reallocations{0};      //!< Times the live elements moved to a new buffer.
+  std::size_t copies{0};             //!< Elements copied.
+  std::size_t moves{0};              //!< Elements moved.
+  std::size_t bitwise{0};            //!< Elements relocated bitwise.
+  std::size_t max_reallocations{0};  //!< Most reallocations undergone by a single vector.
+  std::size_t peak_slack_bytes{0};   //!< Biggest `(capacity() - size()) * sizeof(T)` seen.
+
+  /// Adds the counters of `other` (and keeps the biggest peaks).
+  vector_stats& operator+=(const vector_stats& other) {
+    allocations += other.allocations;
+    deallocations += other.deallocations;
+    bytes_allocated += other.bytes_allocated;
+    bytes_deallocated += other.bytes_deallocated;
+    reallocations += other.reallocations;
+    copies += other.copies;
+    moves += other.moves;
+    bitwise += other.bitwise;
+    max_reallocations = std::max(max_reallocations, other.max_reallocations);
+    peak_slack_bytes = std::max(peak_slack_bytes, other.peak_slack_bytes);
+    return *this;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const vector_stats& s) {
+    os << "allocations:         " << s.allocations << " (" << s.bytes_allocated << " bytes)\n"
+       << "deallocations:       " << s.deallocations << " (" << s.bytes_deallocated << " bytes)\n"
+       << "reallocations:       " << s.reallocations << " (at most " << s.max_reallocations
+       << " for a single vector)\n"
+       << "element copies:      " << s.copies << "\n"
+       << "element moves:       " << s.moves << "\n"
+       << "bitwise relocations: " << s.bitwise << "\n"
+       << "peak slack:          " << s.peak_slack_bytes << " bytes\n";
+    return os;
+  }
+};
+
+namespace detail {
+
+/// Whether reading through `Itr` moves the elements (a `std::move_iterator`).
+template <typename Itr>
+struct is_move_iterator : std::false_type {};
+template <typename Itr>
+struct is_move_iterator<std::move_iterator<Itr>> : std::true_type {};
+
+/// The live counters of one thread.
+/*!
+ * Only the owning thread writes them, so plain load + store (no read-modify-write) is enough;
+ * the atomics just let another thread read a consistent value while dumping.
+ */
+class vector_counters {
+ public:
+  struct counter {
+    std::atomic<std::size_t> value{0};
+    void add(std::size_t n) { value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed); }
+    void raise(std::size_t n) {
+      if (n > value.load(std::memory_order_relaxed)) value.store(n, std::memory_order_relaxed);
+    }
+    std::size_t get(void) const { return value.load(std::memory_order_relaxed); }
+    void reset(void) { value.store(0, std::memory_order_relaxed); }
+  };
+
+  counter allocations, deallocations, bytes_allocated, bytes_deallocated, reallocations;
+  counter copies, moves, bitwise, max_reallocations, peak_slack_bytes;
+
+  vector_stats snapshot(void) const {
+    return { allocations.get(), deallocations.get(), bytes_allocated.get(), bytes_deallocated.get(),
+             reallocations.get(), copies.get(), moves.get(), bitwise.get(), max_reallocations.get(),
+             peak_slack_bytes.get() };
+  }
+
+  void reset(void) {
+    for (counter* c : { &allocations, &deallocations, &bytes_allocated, &bytes_deallocated, &reallocations,
+                        &copies, &moves, &bitwise, &max_reallocations, &peak_slack_bytes })
+      c->reset();
+  }
+};
+
+/// Every thread's counters, plus what the threads that exited left behind.
+struct vector_stats_registry {
+  std::mutex mutex;
+  std::vector<vector_counters*> threads;
+  vector_stats retired;
+
+  static vector_stats_registry& instance(void) {
+    static vector_stats_registry registry;
+    return registry;
+  }
+};
+
+/// Registers the counters of a thread on creation and hands them over when the thread exits.
+struct thread_vector_counters {
+  vector_counters counters;
+
+  thread_vector_counters(void) {
+    auto& reg = vector_stats_registry::instance();
+    std::lock_guard<std::mutex> lock{reg.mutex};
+    reg.threads.push_back(&counters);
+  }
+  ~thread_vector_counters(void) {
+    auto& reg = vector_stats_registry::instance();
+    std::lock_guard<std::mutex> lock{reg.mutex};
+    reg.retired += counters.snapshot();
+    reg.threads.erase(std::find(reg.threads.begin(), reg.threads.end(), &counters));
+  }
+};
+
+/// The counters of the calling thread.
+inline vector_counters& local_vector_counters(void) {
+  thread_local thread_vector_counters local;
+  return local.counters;
+}
+
+} // namespace detail.
+
+/// What the vectors of the calling thread did.
+inline vector_stats thread_vector_stats(void) { return detail::local_vector_counters().snapshot(); }
+
+/// What the vectors of every thread did, including threads that already exited.
+inline vector_stats global_vector_stats(void) {
+  auto& reg = detail::vector_stats_registry::instance();
+  std::lock_guard<std::mutex> lock{reg.mutex};
+  vector_stats total = reg.retired;
+  for (const auto* counters : reg.threads) total += counters->snapshot();
+  return total;
+}
+
+/// Zeroes every counter of every thread.
+inline void reset_vector_stats(void) {
+  auto& reg = detail::vector_stats_registry::instance();
+  std::lock_guard<std::mutex> lock{reg.mutex};
+  reg.retired = vector_stats{};
+  for (auto* counters : reg.threads) counters->reset();
+}
+
+/// Prints `global_vector_stats()`.
+inline void dump_vector_stats(std::ostream& os) {
+  os << "=== sc::vector stats" << (vector_stats_enabled ? "" : " (disabled: build with -DSC_VECTOR_STATS)")
+     << " ===\n" << global_vector_stats();
+}
+
+} // namespace sc.
+
+#endif
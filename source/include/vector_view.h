@@ -0,0 +1,129 @@
+#ifndef _VECTOR_VIEW_H_
+#define _VECTOR_VIEW_H_
+
+#include <algorithm>    // std::min, std::equal
+#include <cstddef>      // std::size_t
+#include <stdexcept>    // std::out_of_range
+#include <type_traits>  // std::remove_const_t, std::enable_if_t
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+#include <span>         // std::span
+#define SC_VECTOR_HAS_SPAN 1
+#endif
+
+#include "vector.h"     // sc::MyForwardIterator, sc::vector
+
+/// Sequence container namespace.
+namespace sc {
+
+/// A non-owning view of a contiguous run of elements: a pointer and a size.
+/*!
+ * It is cheap to copy and pass by value, and slicing it (`subview`, `remove_prefix`, ...) only
+ * moves the pointer, so a parser may hand pieces of a vector around without copying them.
+ * A view never outlives the storage it looks at: a reallocation of the vector invalidates it,
+ * as it does the vector's iterators.
+ *
+ *     sc::vector<token> tokens = lex(text);
+ *     parse(tokens.subview(1));               // Everything but the first token, no copy.
+ *     sc::vector<token> kept{ tokens.subview(0, 8) }; // An owning copy, when one is needed.
+ *
+ * \tparam T The element type; `const T` for a read-only view (what a const vector gives).
+ */
+template <typename T>
+class vector_view {
+ public:
+  using size_type = std::size_t;
+  using value_type = std::remove_const_t<T>;
+  using pointer = T*;
+  using reference = T&;
+  using iterator = MyForwardIterator<T>;
+  using const_iterator = iterator;  //!< A view does not own its elements: constness is in T.
+
+  static constexpr size_type npos = static_cast<size_type>(-1);  //!< "Up to the end", for subview().
+
+  // [I] Construction
+  vector_view(void) : m_data{nullptr}, m_size{0} { /* empty */ }
+  vector_view(T* first, size_type count) : m_data{first}, m_size{count} { /* empty */ }
+
+  template <std::size_t N>
+  vector_view(T (&array)[N]) : m_data{array}, m_size{N} { /* empty */ }
+
+  //Views every element of `vec`.
+  template <typename Alloc, std::size_t N, typename G, typename U = T,
+            typename = std::enable_if_t<!std::is_const_v<U>>>
+  vector_view(vector<value_type, Alloc, N, G>& vec) : vector_view(vec.view()) { /* empty */ }
+  template <typename Alloc, std::size_t N, typename G, typename U = T,
+            typename = std::enable_if_t<std::is_const_v<U>>>
+  vector_view(const vector<value_type, Alloc, N, G>& vec) : vector_view(vec.view()) { /* empty */ }
+
+  //A mutable view converts to a read-only one.
+  template <typename U, typename = std::enable_if_t<std::is_same_v<const U, T>>>
+  vector_view(const vector_view<U>& other) : m_data{other.data()}, m_size{other.size()} { /* empty */ }
+
+#ifdef SC_VECTOR_HAS_SPAN
+  template <typename U, std::size_t Extent, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+  vector_view(std::span<U, Extent> s) : m_data{s.data()}, m_size{s.size()} { /* empty */ }
+
+  operator std::span<T>(void) const { return std::span<T>{m_data, m_size}; }
+#endif
+
+  // [II] Iterators
+  iterator begin(void) const { return iterator{m_data}; }
+  iterator end(void) const { return iterator{m_data + m_size}; }
+  iterator cbegin(void) const { return begin(); }
+  iterator cend(void) const { return end(); }
+
+  // [III] Capacity
+  size_type size(void) const { return m_size; }
+  bool empty(void) const { return m_size == 0; }
+
+  // [IV] Element access
+  T* data(void) const { return m_data; }
+  reference operator[](size_type idx) const { return m_data[idx]; }
+  reference at(size_type idx) const {
+    if (idx >= m_size) throw std::out_of_range{"The method 'at' cannot access this index"};
+    return m_data[idx];
+  }
+  reference front(void) const { return at(0); }
+  reference back(void) const { return at(m_size - 1); }
+
+  // [V] Slicing: none of these copies an element.
+  //The `count` elements from `offset` on (fewer if the view ends first).
+  vector_view subview(size_type offset, size_type count = npos) const {
+    if (offset > m_size) throw std::out_of_range{"vector_view::subview"};
+    return vector_view{m_data + offset, std::min(count, m_size - offset)};
+  }
+  vector_view first(size_type count) const { return subview(0, count); }
+  vector_view last(size_type count) const { return subview(m_size - std::min(count, m_size)); }
+
+  void remove_prefix(size_type count) {
+    if (count > m_size) throw std::out_of_range{"vector_view::remove_prefix"};
+    m_data += count;
+    m_size -= count;
+  }
+  void remove_suffix(size_type count) {
+    if (count > m_size) throw std::out_of_range{"vector_view::remove_suffix"};
+    m_size -= count;
+  }
+
+  //Element-wise comparison (not identity: two views of different storage may be equal).
+  friend bool operator==(const vector_view& a, const vector_view& b) {
+    return a.m_size == b.m_size && std::equal(a.m_data, a.m_data + a.m_size, b.m_data);
+  }
+  friend bool operator!=(const vector_view& a, const vector_view& b) { return !(a == b); }
+
+ private:
+  T* m_data;       //!< The first element.
+  size_type m_size; //!< How many there are.
+};
+
+template <typename T, std::size_t N>
+vector_view(T (&)[N]) -> vector_view<T>;
+template <typename T, typename Alloc, std::size_t N, typename G>
+vector_view(vector<T, Alloc, N, G>&) -> vector_view<T>;
+template <typename T, typename Alloc, std::size_t N, typename G>
+vector_view(const vector<T, Alloc, N, G>&) -> vector_view<const T>;
+
+} // namespace sc.
+
+#endif
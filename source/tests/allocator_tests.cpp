@@ -0,0 +1,220 @@
+#include <cstddef>
+#include<iostream>
+#include<string>
+
+#include "include/tm/test_manager.h"
+#include "../include/vector.h"
+#include "../include/arena_allocator.h"
+#include "../include/pool_allocator.h"
+#include "../include/aligned_allocator.h"
+#include "main.h"
+
+// =============================================================
+// Allocator tests, focused on sc::vector's Allocator parameter
+// =============================================================
+
+// The vector takes all its memory from the allocator it was given.
+#define ARENA_VECTOR YES
+// Copies keep the allocator, moves between different arenas copy the elements.
+#define ALLOC_PROPAGATION YES
+// An allocator that propagates on swap is exchanged by swap().
+#define SWAP_PROPAGATION YES
+// The pool recycles freed chunks.
+#define POOL_REUSE YES
+// Resetting an arena makes its memory available again.
+#define ARENA_RESET YES
+// aligned_vector keeps data() aligned and turns the padded tail into capacity.
+#define ALIGNED_VECTOR YES
+
+/// Minimal allocator that counts live allocations and propagates on swap.
+template <typename T>
+struct counting_allocator {
+    using value_type = T;
+    using propagate_on_container_swap = std::true_type;
+    int id;               //!< Identifies the allocator instance.
+    int* live;            //!< Shared count of live allocations.
+
+    counting_allocator( int i, int* l ) : id{i}, live{l} {}
+    template <typename U>
+    counting_allocator( const counting_allocator<U>& o ) : id{o.id}, live{o.live} {}
+
+    T* allocate( std::size_t n ) { ++*live; return std::allocator<T>{}.allocate(n); }
+    void deallocate( T* p, std::size_t n ) { --*live; std::allocator<T>{}.deallocate(p, n); }
+
+    friend bool operator==( const counting_allocator& a, const counting_allocator& b ) { return a.id == b.id; }
+    friend bool operator!=( const counting_allocator& a, const counting_allocator& b ) { return a.id != b.id; }
+};
+
+void run_allocator_tests( void )
+{
+    TestManager tm{ "Allocator testing"};
+
+#if ARENA_VECTOR
+    {
+        BEGIN_TEST(tm, "ArenaVector", "vector<T, arena_allocator<T>>");
+        sc::arena a;
+        using alloc_t = sc::arena_allocator<std::string>;
+        sc::vector<std::string, alloc_t> vec{ alloc_t{a} };
+
+        EXPECT_EQ( a.bytes_used(), 0 );
+        for ( auto i{0} ; i < 100 ; ++i )
+            vec.push_back( std::to_string(i) );
+        EXPECT_GE( a.bytes_used(), vec.capacity() * sizeof(std::string) );
+        EXPECT_EQ( vec.size(), 100 );
+        EXPECT_EQ( vec[99], "99" );
+        EXPECT_TRUE( vec.get_allocator() == alloc_t{a} );
+
+        sc::vector<std::string, alloc_t> vec2( { "a", "b", "c" }, alloc_t{a} );
+        vec2.insert( vec2.begin()+1, vec.begin(), vec.begin()+3 );
+        EXPECT_EQ( vec2, ( sc::vector<std::string, alloc_t>( { "a", "0", "1", "2", "b", "c" }, alloc_t{a} ) ) );
+    }
+#endif
+
+#if ALLOC_PROPAGATION
+    {
+        BEGIN_TEST(tm, "AllocPropagation", "copy/move with non-propagating allocators");
+        sc::arena a1, a2;
+        using alloc_t = sc::arena_allocator<int>;
+        sc::vector<int, alloc_t> vec( { 1, 2, 3, 4, 5 }, alloc_t{a1} );
+
+        // The copy constructor keeps the same arena.
+        sc::vector<int, alloc_t> copy{ vec };
+        EXPECT_TRUE( copy.get_allocator() == alloc_t{a1} );
+
+        // Assignment keeps the destination's arena.
+        sc::vector<int, alloc_t> dest{ alloc_t{a2} };
+        dest = vec;
+        EXPECT_TRUE( dest.get_allocator() == alloc_t{a2} );
+        EXPECT_EQ( dest, vec );
+
+        // Moving across arenas cannot steal the buffer: elements are moved one by one.
+        auto used = a2.bytes_used();
+        sc::vector<int, alloc_t> other{ alloc_t{a2} };
+        other = std::move( copy );
+        EXPECT_TRUE( other.get_allocator() == alloc_t{a2} );
+        EXPECT_GT( a2.bytes_used(), used );
+        EXPECT_EQ( other, vec );
+        EXPECT_TRUE( copy.empty() );
+
+        // Moving within the same arena steals the buffer.
+        auto data = dest.data();
+        used = a2.bytes_used();
+        other = std::move( dest );
+        EXPECT_EQ( other.data(), data );
+        EXPECT_EQ( a2.bytes_used(), used );
+    }
+#endif
+
+#if SWAP_PROPAGATION
+    {
+        BEGIN_TEST(tm, "SwapPropagation", "swap() exchanges allocators that propagate on swap");
+        int live{0};
+        using alloc_t = counting_allocator<int>;
+        {
+            sc::vector<int, alloc_t> vec( { 1, 2, 3 }, alloc_t{1, &live} );
+            sc::vector<int, alloc_t> vec2( { 4, 5 }, alloc_t{2, &live} );
+            EXPECT_EQ( live, 2 );
+            swap( vec, vec2 );
+            EXPECT_EQ( vec.get_allocator().id, 2 );
+            EXPECT_EQ( vec2.get_allocator().id, 1 );
+            EXPECT_EQ( vec.size(), 2 );
+            EXPECT_EQ( vec2[2], 3 );
+            vec2.reserve( 100 );
+            EXPECT_EQ( live, 2 );
+        }
+        EXPECT_EQ( live, 0 );
+    }
+#endif
+
+#if POOL_REUSE
+    {
+        BEGIN_TEST(tm, "PoolReuse", "vector<T, pool_allocator<T>> recycles chunks");
+        sc::pool p;
+        using alloc_t = sc::pool_allocator<int>;
+        const int* first_data{nullptr};
+        {
+            sc::vector<int, alloc_t> vec( { 1, 2, 3 }, alloc_t{p} );
+            first_data = vec.data();
+        }
+        auto used = p.upstream().bytes_used();
+        for ( auto i{0} ; i < 1000 ; ++i )
+        {
+            // Same size class every time: the freed chunk comes straight back.
+            sc::vector<int, alloc_t> vec( { i, i, i }, alloc_t{p} );
+            EXPECT_EQ( vec.data(), first_data );
+        }
+        EXPECT_EQ( p.upstream().bytes_used(), used );
+
+        sc::vector<int, alloc_t> big{ alloc_t{p} };
+        for ( auto i{0} ; i < 10000 ; ++i )
+            big.push_back( i );
+        EXPECT_EQ( big.size(), 10000 );
+        EXPECT_EQ( big.back(), 9999 );
+    }
+#endif
+
+#if ARENA_RESET
+    {
+        BEGIN_TEST(tm, "ArenaReset", "arena.reset() releases everything at once");
+        sc::arena a{ 1024 };
+        using alloc_t = sc::arena_allocator<int>;
+        const int* first_data{nullptr};
+        {
+            sc::vector<int, alloc_t> vec( 2000, alloc_t{a} );
+            first_data = vec.data();
+            EXPECT_GE( a.bytes_used(), 2000 * sizeof(int) );
+        }
+        a.reset();
+        EXPECT_EQ( a.bytes_used(), 0 );
+        // The blocks are kept and handed out again.
+        sc::vector<int, alloc_t> vec( 2000, alloc_t{a} );
+        EXPECT_EQ( vec.data(), first_data );
+    }
+#endif
+
+#if ALIGNED_VECTOR
+    {
+        BEGIN_TEST(tm, "AlignedVector", "aligned_vector<T, Align> through reserve, copies, shrink_to_fit");
+        sc::aligned_vector<float> vec;
+        vec.push_back( 1.0f );
+        EXPECT_TRUE( sc::is_aligned<64>( vec.data() ) );
+        // The allocation spans whole 64-byte lines, and all of it is capacity.
+        EXPECT_EQ( vec.capacity(), 16 );
+        for ( auto i{0} ; i < 100 ; ++i )
+            vec.push_back( i );
+        EXPECT_TRUE( sc::is_aligned<64>( vec.data() ) );
+        EXPECT_EQ( vec.capacity() * sizeof(float) % 64, 0 );
+        vec.reserve( 1000 );
+        EXPECT_TRUE( sc::is_aligned<64>( vec.data() ) );
+        EXPECT_EQ( vec.capacity(), 1008 );
+        vec.shrink_to_fit();
+        EXPECT_EQ( vec.capacity(), 112 );
+        EXPECT_TRUE( sc::is_aligned<64>( vec.data() ) );
+
+        auto copy = vec;
+        EXPECT_TRUE( sc::is_aligned<64>( copy.data() ) );
+        EXPECT_EQ( copy, vec );
+        sc::aligned_vector<float> assigned{ 1.0f };
+        assigned = vec;
+        EXPECT_TRUE( sc::is_aligned<64>( assigned.data() ) );
+        float* aligned = sc::assume_aligned<64>( assigned.data() );
+        EXPECT_EQ( aligned[100], 99.0f );
+
+        // Another alignment, and elements that do not divide it.
+        struct alignas(16) wide { char bytes[48]; };
+        sc::aligned_vector<wide, 32> wides;
+        wides.reserve( 3 );
+        wides.resize( 3 );
+        EXPECT_TRUE( sc::is_aligned<32>( wides.data() ) );
+        EXPECT_EQ( wides.capacity(), 3 ); // 144 bytes take 160: no room for a fourth element.
+        sc::aligned_vector<std::string, 32> words{ "a", "b" };
+        for ( auto i{0} ; i < 30 ; ++i )
+            words.insert( words.begin(), std::string{ "c" } );
+        EXPECT_TRUE( sc::is_aligned<32>( words.data() ) );
+        EXPECT_EQ( words.size(), 32 );
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
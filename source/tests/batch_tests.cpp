@@ -0,0 +1,251 @@
+#include <cstddef>
+#include<algorithm>
+#include<functional>
+#include<iostream>
+#include<list>
+#include<random>
+#include<stdexcept>
+#include<string>
+#include<utility>
+#include<vector>
+
+#include "include/tm/test_manager.h"
+#include "../include/vector.h"
+#include "main.h"
+
+// =============================================================
+// batch tests: insert_sorted_batch, erase_indices and
+// merge_sorted, which move each element once.
+// =============================================================
+
+// Values land before the indices given, with or without growing the buffer.
+#define INSERT_SORTED_BATCH YES
+// Each old element is moved exactly once.
+#define MOVED_ONCE YES
+// A value that throws while the buffer grows leaves the vector as it was.
+#define BATCH_STRONG_GUARANTEE YES
+// Several elements removed in one pass.
+#define ERASE_INDICES YES
+// A sorted range merged into a sorted vector.
+#define MERGE_SORTED YES
+// The batch operations agree with one insert/erase at a time, on random input.
+#define AGAINST_ONE_AT_A_TIME YES
+
+namespace {
+
+/// Counts its moves (construction and assignment) and may be told to throw when copied.
+struct counted {
+    static inline int moves{0};
+    static inline int copies_left{-1}; //!< Copies allowed before one throws (-1: never).
+    int value;
+    counted( int v = 0 ) : value{v} { /* empty */ }
+    counted( const counted& other ) : value{other.value} { copied(); }
+    counted( counted&& other ) noexcept : value{other.value} { ++moves; }
+    counted& operator=( const counted& other ) { copied(); value = other.value; return *this; }
+    counted& operator=( counted&& other ) noexcept { ++moves; value = other.value; return *this; }
+    bool operator==( const counted& other ) const { return value == other.value; }
+    bool operator<( const counted& other ) const { return value < other.value; }
+    static void copied( void ) {
+        if ( copies_left == 0 ) throw std::runtime_error{ "no more copies" };
+        if ( copies_left > 0 ) --copies_left;
+    }
+};
+
+} // namespace.
+
+void run_batch_tests( void )
+{
+    TestManager tm{ "batch testing"};
+
+#if INSERT_SORTED_BATCH
+    {
+        BEGIN_TEST(tm, "InsertSortedBatch", "values before sorted positions, in place and growing");
+        sc::vector<int> vec{ 10, 20, 30, 40 };
+        vec.reserve( 16 );
+        vec.insert_sorted_batch( std::vector<int>{ 0, 2, 2, 4 }, std::vector<int>{ 5, 15, 16, 45 } );
+        EXPECT_EQ( vec, ( sc::vector<int>{ 5, 10, 20, 15, 16, 30, 40, 45 } ) );
+        EXPECT_EQ( vec.capacity(), 16 );
+
+        sc::vector<std::string> words{ "b", "d" };
+        sc::vector<std::string> extra{ "a", "c", "e" };
+        words.insert_sorted_batch( sc::vector<int>{ 0, 1, 2 }, std::move( extra ) ); // Grows.
+        EXPECT_EQ( words, ( sc::vector<std::string>{ "a", "b", "c", "d", "e" } ) );
+        EXPECT_TRUE( extra[0].empty() ); // Moved from.
+        const sc::vector<std::string> more{ "x", "y" };
+        words.reserve( 10 );
+        words.insert_sorted_batch( std::vector<std::size_t>{ 1, 5 }, more );
+        EXPECT_EQ( words, ( sc::vector<std::string>{ "a", "x", "b", "c", "d", "e", "y" } ) );
+        EXPECT_EQ( more[0], "x" );
+        words.insert_sorted_batch( std::vector<int>{}, std::vector<std::string>{} );
+        EXPECT_EQ( words.size(), 7 );
+
+        // Bad indices throw from `checked` on (see checks.h); below, they are undefined behavior.
+        if constexpr ( sc::vector_checks >= sc::check_level::checked ) {
+            bool thrown{false};
+            try { words.insert_sorted_batch( std::vector<int>{ 3, 1 }, more ); }
+            catch ( const std::out_of_range& ) { thrown = true; }
+            EXPECT_TRUE( thrown );
+            thrown = false;
+            try { words.insert_sorted_batch( std::vector<int>{ 8 }, std::vector<std::string>{ "z" } ); }
+            catch ( const std::out_of_range& ) { thrown = true; }
+            EXPECT_TRUE( thrown );
+        }
+        EXPECT_EQ( words.size(), 7 );
+    }
+#endif
+
+#if MOVED_ONCE
+    {
+        BEGIN_TEST(tm, "MovedOnce", "each old element from the first position on is moved once");
+        sc::vector<counted> vec;
+        vec.reserve( 200 );
+        for ( auto i{0} ; i < 100 ; ++i )
+            vec.emplace_back( i * 10 );
+        std::vector<int> positions{ 10, 30, 30, 60, 99, 100 };
+        std::vector<counted> values{ 1, 2, 3, 4, 5, 6 };
+        counted::moves = 0;
+        vec.insert_sorted_batch( positions, values );
+        EXPECT_EQ( counted::moves, 90 );
+        EXPECT_EQ( vec[10].value, 1 );
+        EXPECT_EQ( vec[11].value, 100 );
+        EXPECT_EQ( vec.back().value, 6 );
+
+        // Growing: every old element is relocated once, the values are moved in.
+        vec.shrink_to_fit();
+        counted::moves = 0;
+        vec.insert_sorted_batch( std::vector<int>{ 0, 50 }, std::vector<counted>{ -1, -2 } );
+        EXPECT_EQ( counted::moves, 108 );
+        EXPECT_EQ( vec.front().value, -1 );
+
+        counted::moves = 0;
+        vec.erase_indices( std::vector<int>{ 0, 1, 50, 107 } );
+        EXPECT_EQ( counted::moves, 106 - 2 );
+        EXPECT_EQ( vec.size(), 104 );
+    }
+#endif
+
+#if BATCH_STRONG_GUARANTEE
+    {
+        BEGIN_TEST(tm, "BatchStrongGuarantee", "a throwing value copy while growing changes nothing");
+        sc::vector<counted> vec{ 1, 2, 3 };
+        const counted* storage = &vec[0];
+        std::vector<counted> values{ 7, 8, 9 };
+        counted::copies_left = 2;
+        bool thrown{false};
+        try { vec.insert_sorted_batch( std::vector<int>{ 0, 1, 3 }, values ); }
+        catch ( const std::runtime_error& ) { thrown = true; }
+        counted::copies_left = -1;
+        EXPECT_TRUE( thrown );
+        EXPECT_EQ( vec, ( sc::vector<counted>{ 1, 2, 3 } ) );
+        EXPECT_EQ( &vec[0], storage );
+    }
+#endif
+
+#if ERASE_INDICES
+    {
+        BEGIN_TEST(tm, "EraseIndices", "sorted indices removed in one pass");
+        sc::vector<int> vec{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        vec.erase_indices( std::vector<int>{ 0, 3, 4, 9 } );
+        EXPECT_EQ( vec, ( sc::vector<int>{ 1, 2, 5, 6, 7, 8 } ) );
+        vec.erase_indices( sc::vector<int>{} );
+        EXPECT_EQ( vec.size(), 6 );
+
+        sc::vector<std::string> words{ "a", "b", "c", "d" };
+        const int all[]{ 0, 1, 2, 3 };
+        sc::vector<std::string> copy = words;
+        copy.erase_indices( all );
+        EXPECT_TRUE( copy.empty() );
+        words.erase_indices( std::vector<int>{ 1, 2 } );
+        EXPECT_EQ( words, ( sc::vector<std::string>{ "a", "d" } ) );
+
+        // Bad indices throw from `checked` on (see checks.h); below, they are undefined behavior.
+        if constexpr ( sc::vector_checks >= sc::check_level::checked ) {
+            bool thrown{false};
+            try { words.erase_indices( std::vector<int>{ 1, 1 } ); }
+            catch ( const std::out_of_range& ) { thrown = true; }
+            EXPECT_TRUE( thrown );
+            thrown = false;
+            try { words.erase_indices( std::vector<int>{ 2 } ); }
+            catch ( const std::out_of_range& ) { thrown = true; }
+            EXPECT_TRUE( thrown );
+        }
+        EXPECT_EQ( words.size(), 2 );
+    }
+#endif
+
+#if MERGE_SORTED
+    {
+        BEGIN_TEST(tm, "MergeSorted", "linear merge; equal elements of the vector stay first");
+        sc::vector<int> vec{ 1, 3, 5, 7 };
+        vec.merge_sorted( std::vector<int>{ 0, 3, 4, 8, 9 } );
+        EXPECT_EQ( vec, ( sc::vector<int>{ 0, 1, 3, 3, 4, 5, 7, 8, 9 } ) );
+        vec.merge_sorted( std::list<int>{ 2, 6 } ); // Not random access.
+        EXPECT_EQ( vec, ( sc::vector<int>{ 0, 1, 2, 3, 3, 4, 5, 6, 7, 8, 9 } ) );
+
+        using level = std::pair<int, std::string>; // price, owner
+        auto by_price = []( const level& a, const level& b ){ return a.first < b.first; };
+        sc::vector<level> book{ { 100, "old" }, { 102, "old" } };
+        std::vector<level> incoming{ { 99, "new" }, { 100, "new" }, { 103, "new" } };
+        book.merge_sorted( incoming, by_price );
+        EXPECT_EQ( book.size(), 5 );
+        EXPECT_EQ( book[1].second, "old" );
+        EXPECT_EQ( book[2].second, "new" );
+        EXPECT_EQ( book.back().first, 103 );
+
+        sc::vector<int> descending{ 9, 5, 1 };
+        descending.merge_sorted( std::vector<int>{ 6, 2 }, std::greater<>{} );
+        EXPECT_EQ( descending, ( sc::vector<int>{ 9, 6, 5, 2, 1 } ) );
+        // An unsorted range throws from `checked` on (see checks.h).
+        if constexpr ( sc::vector_checks >= sc::check_level::checked ) {
+            bool thrown{false};
+            try { descending.merge_sorted( std::vector<int>{ 1, 2 }, std::greater<>{} ); }
+            catch ( const std::out_of_range& ) { thrown = true; }
+            EXPECT_TRUE( thrown );
+        }
+        sc::vector<int> empty;
+        empty.merge_sorted( std::vector<int>{ 1, 2 } );
+        EXPECT_EQ( empty, ( sc::vector<int>{ 1, 2 } ) );
+    }
+#endif
+
+#if AGAINST_ONE_AT_A_TIME
+    {
+        BEGIN_TEST(tm, "AgainstOneAtATime", "random batches give what k single inserts/erases give");
+        std::mt19937 gen{ 42 };
+        bool same{true};
+        for ( auto round{0} ; round < 50 ; ++round ) {
+            std::vector<std::string> expected;
+            sc::vector<std::string> vec;
+            std::size_t n = gen() % 40;
+            for ( std::size_t i{0} ; i < n ; ++i ) {
+                expected.push_back( std::to_string( i ) );
+                vec.push_back( std::to_string( i ) );
+            }
+            if ( round % 2 ) vec.reserve( 100 );
+            std::vector<std::size_t> positions( gen() % 10 );
+            std::vector<std::string> values;
+            for ( auto& p : positions ) {
+                p = gen() % ( n + 1 );
+                values.push_back( "v" + std::to_string( values.size() ) );
+            }
+            std::sort( positions.begin(), positions.end() );
+            vec.insert_sorted_batch( positions, values );
+            for ( std::size_t j{positions.size()} ; j-- > 0 ; )
+                expected.insert( expected.begin() + positions[j], values[j] );
+            same = same && std::equal( vec.begin(), vec.end(), expected.begin(), expected.end() );
+
+            std::vector<std::size_t> doomed;
+            for ( std::size_t i{0} ; i < vec.size() ; ++i )
+                if ( gen() % 3 == 0 ) doomed.push_back( i );
+            vec.erase_indices( doomed );
+            for ( std::size_t j{doomed.size()} ; j-- > 0 ; )
+                expected.erase( expected.begin() + doomed[j] );
+            same = same && std::equal( vec.begin(), vec.end(), expected.begin(), expected.end() );
+        }
+        EXPECT_TRUE( same );
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
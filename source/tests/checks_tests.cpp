@@ -0,0 +1,102 @@
+#include <cstddef>
+#include<iostream>
+#include<stdexcept>
+#include<string>
+
+#include "include/tm/test_manager.h"
+#include "../include/vector.h"
+#include "main.h"
+
+// =============================================================
+// checks tests: what is validated in each SC_VECTOR_CHECKS mode
+// (cmake -DSC_VECTOR_CHECKS=none|assert|checked|hardened).
+// Only the tests of the mode being built run.
+// =============================================================
+
+// at() throws in every mode.
+#define AT_ALWAYS_CHECKS YES
+// checked/hardened: insert/erase positions and front()/back() throw std::out_of_range.
+#define CHECKED_PRECONDITIONS YES
+// hardened: operator[] is bounds-checked and stale iterators throw std::logic_error.
+#define HARDENED_ITERATORS YES
+
+namespace {
+
+/// Whether `op()` throws an `Exception`.
+template <typename Exception, typename Op>
+bool throws( Op op ) {
+    try { op(); }
+    catch ( const Exception& ) { return true; }
+    return false;
+}
+
+} // namespace.
+
+void run_checks_tests( void )
+{
+    TestManager tm{ "checks testing"};
+
+#if AT_ALWAYS_CHECKS
+    {
+        BEGIN_TEST(tm, "AtAlwaysChecks", "at() throws std::out_of_range whatever SC_VECTOR_CHECKS says");
+        sc::vector<int> vec{ 1, 2, 3 };
+        EXPECT_TRUE( throws<std::out_of_range>( [&]{ vec.at( 3 ); } ) );
+        const auto& cvec = vec;
+        EXPECT_TRUE( throws<std::out_of_range>( [&]{ cvec.at( 100 ); } ) );
+        EXPECT_EQ( cvec.at( 2 ), 3 );
+        EXPECT_EQ( static_cast<int>( sc::vector_checks ), SC_VECTOR_CHECK_LEVEL );
+    }
+#endif
+
+#if CHECKED_PRECONDITIONS && SC_VECTOR_CHECK_LEVEL >= SC_VECTOR_CHECKS_checked
+    {
+        BEGIN_TEST(tm, "CheckedPreconditions", "bad positions and empty vectors throw, leaving the vector intact");
+        sc::vector<std::string> vec{ "a", "b" };
+        EXPECT_TRUE( throws<std::out_of_range>( [&]{ vec.insert( vec.end() + 1, "c" ); } ) );
+        EXPECT_TRUE( throws<std::out_of_range>( [&]{ vec.emplace( vec.begin() - 1, "c" ); } ) );
+        EXPECT_TRUE( throws<std::out_of_range>( [&]{ vec.insert( vec.end() + 1, { "c", "d" } ); } ) );
+        EXPECT_TRUE( throws<std::out_of_range>( [&]{ vec.erase( vec.end() ); } ) );
+        EXPECT_TRUE( throws<std::out_of_range>( [&]{ vec.erase( vec.begin() + 1, vec.begin() ); } ) );
+        EXPECT_TRUE( throws<std::out_of_range>( [&]{ vec.erase_unordered( vec.end() ); } ) );
+        EXPECT_EQ( vec, ( sc::vector<std::string>{ "a", "b" } ) );
+        vec.erase( vec.begin(), vec.end() );
+        EXPECT_TRUE( throws<std::out_of_range>( [&]{ vec.front(); } ) );
+        EXPECT_TRUE( throws<std::out_of_range>( [&]{ vec.back(); } ) );
+        const auto& cvec = vec;
+        EXPECT_TRUE( throws<std::out_of_range>( [&]{ cvec.back(); } ) );
+    }
+#endif
+
+#if HARDENED_ITERATORS && SC_VECTOR_CHECK_LEVEL == SC_VECTOR_CHECKS_hardened
+    {
+        BEGIN_TEST(tm, "HardenedIterators", "iterators kept across a reallocation throw; operator[] is checked");
+        sc::vector<int> vec{ 1, 2, 3 };
+        auto it = vec.begin() + 1;
+        sc::vector<int>::const_iterator cit = vec.cend() - 1;
+        EXPECT_EQ( *it, 2 );
+        vec.reserve( 3 ); // No reallocation: the iterators stay valid.
+        EXPECT_EQ( *cit, 3 );
+        vec.reserve( 100 );
+        EXPECT_TRUE( throws<std::logic_error>( [&]{ *it; } ) );
+        EXPECT_TRUE( throws<std::logic_error>( [&]{ cit[0]; } ) );
+        it = vec.begin(); // Made after the reallocation.
+        EXPECT_EQ( *it, 1 );
+        vec.shrink_to_fit();
+        EXPECT_TRUE( throws<std::logic_error>( [&]{ *it; } ) );
+
+        it = vec.begin();
+        while ( vec.size() < vec.capacity() )
+            vec.push_back( 0 );
+        EXPECT_EQ( *it, 1 );
+        vec.push_back( 4 ); // Full: this one grows the buffer.
+        EXPECT_TRUE( throws<std::logic_error>( [&]{ *it; } ) );
+
+        EXPECT_TRUE( throws<std::out_of_range>( [&]{ vec[vec.size()]; } ) );
+        sc::vector<int>::iterator null;
+        EXPECT_TRUE( throws<std::logic_error>( [&]{ *null; } ) );
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
@@ -0,0 +1,227 @@
+#include <cstddef>
+#include<algorithm>
+#include<atomic>
+#include<iostream>
+#include<stdexcept>
+#include<string>
+#include<thread>
+#include<vector>
+
+#include "include/tm/test_manager.h"
+#include "../include/concurrent_vector.h"
+#include "main.h"
+
+// =============================================================
+// concurrent_vector tests: appends from several threads, stable
+// elements, and the single-threaded operations.
+// =============================================================
+
+// push_back/emplace_back return consecutive indices; elements are readable through them.
+#define APPEND_AND_READ YES
+// Elements never move, however much the vector grows.
+#define STABLE_ELEMENTS YES
+// Threads appending at once lose nothing and clash on nothing.
+#define CONCURRENT_APPENDS YES
+// grow_by reserves consecutive indices, and a failing constructor is contained.
+#define GROW_BY YES
+// Iterators, copies, moves and clear.
+#define SINGLE_THREADED_OPS YES
+
+namespace {
+
+/// Counts the live objects from any thread; building one from `poison` throws.
+struct Tracked {
+    static std::atomic<int> alive;
+    static int poison;
+    int m_value;
+
+    Tracked( int v = 0 ) : m_value{v} {
+        if ( m_value == poison ) throw std::runtime_error{ "poisoned element" };
+        ++alive;
+    }
+    Tracked( const Tracked& other ) : Tracked{ other.m_value } { }
+    Tracked& operator=( const Tracked& other ) = default;
+    ~Tracked() { --alive; }
+};
+std::atomic<int> Tracked::alive{0};
+int Tracked::poison{-1};
+
+} // namespace.
+
+void run_concurrent_vector_tests( void )
+{
+    TestManager tm{ "concurrent_vector testing"};
+
+#if APPEND_AND_READ
+    {
+        BEGIN_TEST(tm, "AppendAndRead", "push_back, emplace_back, operator[], at, ready");
+        sc::concurrent_vector<std::string> vec;
+        EXPECT_TRUE( vec.empty() );
+        EXPECT_EQ( vec.push_back( "zero" ), 0 );
+        std::string one{ "one" };
+        EXPECT_EQ( vec.push_back( std::move(one) ), 1 );
+        EXPECT_EQ( vec.emplace_back( 3, 'x' ), 2 );
+        EXPECT_EQ( vec.size(), 3 );
+        EXPECT_EQ( vec[1], "one" );
+        EXPECT_EQ( vec.at(2), "xxx" );
+        EXPECT_EQ( vec.front(), "zero" );
+        EXPECT_EQ( vec.back(), "xxx" );
+        EXPECT_TRUE( vec.ready( 2 ) );
+        EXPECT_FALSE( vec.ready( 3 ) );
+        bool thrown{false};
+        try { vec.at( 3 ); }
+        catch ( const std::out_of_range& ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+        // The first segment holds 8 elements.
+        EXPECT_EQ( vec.capacity(), 8 );
+    }
+#endif
+
+#if STABLE_ELEMENTS
+    {
+        BEGIN_TEST(tm, "StableElements", "references survive growth; segments double");
+        sc::concurrent_vector<int> vec;
+        vec.push_back( 42 );
+        const int* first = &vec[0];
+        std::vector<const int*> addresses;
+        for ( auto i{1} ; i < 100'000 ; ++i )
+            addresses.push_back( &vec[ vec.push_back( i ) ] );
+        EXPECT_EQ( first, &vec[0] );
+        EXPECT_EQ( *first, 42 );
+        bool same{true};
+        for ( std::size_t i{0} ; i < addresses.size() ; ++i )
+            same = same && addresses[i] == &vec[i + 1] && vec[i + 1] == static_cast<int>( i + 1 );
+        EXPECT_TRUE( same );
+        // 8 + 16 + ... + 8 * 2^13 = 131064 slots.
+        EXPECT_EQ( vec.capacity(), 131'064 );
+        // Indices 0..7 are one segment; 8 starts the next one.
+        EXPECT_EQ( &vec[7] - &vec[0], 7 );
+        vec.reserve( 200'000 );
+        EXPECT_EQ( vec.capacity(), 262'136 );
+        EXPECT_EQ( first, &vec[0] );
+    }
+#endif
+
+#if CONCURRENT_APPENDS
+    {
+        BEGIN_TEST(tm, "ConcurrentAppends", "four threads push_back while a fifth reads");
+        sc::concurrent_vector<long> vec;
+        const long per_thread{ 20'000 };
+        std::atomic<bool> done{false};
+        std::atomic<long> seen{0};
+        // The reader only touches indices it knows are constructed.
+        std::thread reader{ [&] {
+            while ( !done.load() ) {
+                auto n = vec.size();
+                for ( std::size_t i{0} ; i < n ; ++i )
+                    if ( vec.ready( i ) ) seen += vec[i] >= 0;
+            }
+        } };
+        std::vector<std::thread> writers;
+        std::vector<std::vector<std::size_t>> indices( 4 );
+        for ( long t{0} ; t < 4 ; ++t )
+            writers.emplace_back( [&, t] {
+                for ( long i{0} ; i < per_thread ; ++i )
+                    indices[t].push_back( vec.push_back( t * per_thread + i ) );
+            } );
+        for ( auto& w : writers )
+            w.join();
+        done = true;
+        reader.join();
+
+        EXPECT_EQ( vec.size(), 4 * per_thread );
+        // Every index went to exactly one element, and holds it.
+        bool matches{true};
+        for ( long t{0} ; t < 4 ; ++t )
+            for ( long i{0} ; i < per_thread ; ++i )
+                matches = matches && vec[ indices[t][i] ] == t * per_thread + i;
+        EXPECT_TRUE( matches );
+        std::vector<long> all( vec.begin(), vec.end() );
+        std::sort( all.begin(), all.end() );
+        bool each_once{true};
+        for ( long i{0} ; i < 4 * per_thread ; ++i )
+            each_once = each_once && all[i] == i;
+        EXPECT_TRUE( each_once );
+    }
+#endif
+
+#if GROW_BY
+    {
+        BEGIN_TEST(tm, "GrowBy", "grow_by(n), grow_by(n, value), a throwing constructor");
+        {
+            sc::concurrent_vector<Tracked> vec;
+            EXPECT_EQ( vec.grow_by( 5 ), 0 );
+            EXPECT_EQ( vec.grow_by( 20, Tracked{ 7 } ), 5 );
+            EXPECT_EQ( vec.size(), 25 );
+            EXPECT_EQ( vec[4].m_value, 0 );
+            EXPECT_EQ( vec[24].m_value, 7 );
+            EXPECT_EQ( Tracked::alive, 25 );
+
+            // The element that throws, and the rest of its range, are marked as never built.
+            Tracked::poison = 3;
+            bool thrown{false};
+            try { vec.emplace_back( 3 ); }
+            catch ( const std::runtime_error& ) { thrown = true; }
+            EXPECT_TRUE( thrown );
+            EXPECT_FALSE( vec.ready( 25 ) );
+            EXPECT_EQ( vec.size(), 26 );
+            Tracked::poison = -1;
+            vec.push_back( Tracked{ 1 } );
+            EXPECT_TRUE( vec.ready( 26 ) );
+            EXPECT_EQ( Tracked::alive, 26 );
+
+            // A copy keeps the indices: the broken slot is broken there too.
+            auto copy = vec;
+            EXPECT_EQ( copy.size(), 27 );
+            EXPECT_FALSE( copy.ready( 25 ) );
+            EXPECT_EQ( copy[26].m_value, 1 );
+            EXPECT_EQ( Tracked::alive, 52 );
+            copy.clear();
+            EXPECT_EQ( Tracked::alive, 26 );
+        }
+        // Only the constructed elements were destroyed.
+        EXPECT_EQ( Tracked::alive, 0 );
+        sc::concurrent_vector<int> empty;
+        EXPECT_EQ( empty.grow_by( 0 ), 0 );
+        EXPECT_EQ( empty.capacity(), 0 );
+    }
+#endif
+
+#if SINGLE_THREADED_OPS
+    {
+        BEGIN_TEST(tm, "SingleThreadedOps", "iterators, copy, move, swap, clear");
+        sc::concurrent_vector<int> vec{ 5, 3, 9, 1 };
+        std::sort( vec.begin(), vec.end() );
+        EXPECT_EQ( vec[0], 1 );
+        EXPECT_EQ( vec[3], 9 );
+        auto it = vec.begin();
+        EXPECT_EQ( vec.end() - it, 4 );
+        EXPECT_EQ( it[2], 5 );
+        sc::concurrent_vector<int>::const_iterator cit = it + 1;
+        EXPECT_EQ( *cit, 3 );
+        EXPECT_TRUE( ( cit > vec.cbegin() && cit != vec.cend() ) );
+
+        auto copy = vec;
+        copy.push_back( 10 );
+        EXPECT_EQ( copy.size(), 5 );
+        EXPECT_EQ( vec.size(), 4 );
+        auto moved = std::move( copy );
+        EXPECT_EQ( moved.back(), 10 );
+        EXPECT_TRUE( copy.empty() );
+        swap( moved, vec );
+        EXPECT_EQ( vec.size(), 5 );
+        vec = moved;
+        EXPECT_EQ( vec.size(), 4 );
+
+        auto capacity = vec.capacity();
+        vec.clear();
+        EXPECT_TRUE( vec.empty() );
+        EXPECT_EQ( vec.capacity(), capacity );
+        EXPECT_EQ( vec.push_back( 8 ), 0 );
+        EXPECT_EQ( vec.at(0), 8 );
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
@@ -0,0 +1,135 @@
+#include <cstddef>
+#include<algorithm>
+#include<array>
+#include<iostream>
+#include<type_traits>
+#include<utility>
+
+#include "include/tm/test_manager.h"
+#include "../include/vector.h"
+#include "main.h"
+
+// =============================================================
+// constexpr tests: data() on const vectors, and (in C++20) the
+// vector core running at compile time to build lookup tables.
+// =============================================================
+
+// data() on a const vector is a pointer to const elements.
+#define CONST_DATA YES
+// A lookup table computed with a vector at compile time.
+#define COMPILE_TIME_TABLE YES
+// Growth, insertion, copies, moves and == in constant expressions.
+#define CONSTEXPR_OPERATIONS YES
+
+#ifdef SC_VECTOR_CONSTEXPR
+namespace {
+
+/// The first `N` primes, found with a vector at compile time and frozen into an array.
+template <std::size_t N>
+constexpr std::array<int, N> first_primes( void ) {
+    sc::vector<int> primes;
+    for ( int candidate{2} ; primes.size() < N ; ++candidate ) {
+        bool prime{true};
+        for ( auto p : primes )
+            if ( candidate % p == 0 ) { prime = false; break; }
+        if ( prime ) primes.push_back( candidate );
+    }
+    std::array<int, N> table{};
+    std::copy( primes.begin(), primes.end(), table.begin() );
+    return table;
+}
+
+constexpr auto primes = first_primes<16>();
+static_assert( primes[0] == 2 && primes[15] == 53 );
+
+/// Owns a heap int, so the vector must move, copy and destroy it properly at compile time.
+struct boxed {
+    constexpr boxed( int v = 0 ) : value{ new int{v} } { /* empty */ }
+    constexpr boxed( const boxed& other ) : value{ new int{ *other.value } } { /* empty */ }
+    constexpr boxed( boxed&& other ) noexcept : value{ other.value } { other.value = nullptr; }
+    constexpr boxed& operator=( boxed other ) noexcept { std::swap( value, other.value ); return *this; }
+    constexpr ~boxed( void ) { delete value; }
+    constexpr bool operator==( const boxed& other ) const { return *value == *other.value; }
+    int* value;
+};
+
+constexpr bool trivial_operations( void ) {
+    sc::vector<int> vec{ 3, 4 };
+    vec.insert( vec.begin(), 1 );     // Opens a hole: the shift is elementwise here.
+    vec.emplace( vec.begin() + 1, 2 );
+    for ( int i{5} ; i <= 20 ; ++i )
+        vec.push_back( i );          // Several reallocations.
+    vec.reserve( 64 );
+    vec.pop_back();
+    const auto copy = vec;
+    sc::vector<int> moved{ std::move( vec ) };
+    sc::vector<int> zeros( 3 );
+    const int list[]{ 1, 2, 3 };
+    sc::vector<int> ranged( list, list + 3 );
+    return copy == moved && vec.empty() && copy.size() == 19 && copy.capacity() == 19
+        && moved.capacity() == 64 && copy.front() == 1 && copy.back() == 19 && copy.at( 3 ) == 4
+        && *copy.data() == 1 && zeros[2] == 0 && ranged == sc::vector<int>{ 1, 2, 3 };
+}
+static_assert( trivial_operations() );
+
+constexpr bool owning_operations( void ) {
+    sc::vector<boxed> vec;
+    for ( int i{0} ; i < 10 ; ++i )
+        vec.emplace_back( i );
+    vec.push_front( boxed{ -1 } );
+    vec.insert( vec.begin() + 5, vec[0] );
+    auto copy = vec;
+    copy.pop_back();
+    copy.clear();
+    return vec.size() == 12 && *vec[0].value == -1 && *vec[5].value == -1 && *vec.back().value == 9
+        && copy.empty() && vec != copy;
+}
+static_assert( owning_operations() );
+
+} // namespace.
+#endif
+
+void run_constexpr_tests( void )
+{
+    TestManager tm{ "constexpr testing"};
+
+#if CONST_DATA
+    {
+        BEGIN_TEST(tm, "ConstData", "data() const returns const T*, the first element's address");
+        const sc::vector<int> vec{ 1, 2, 3 };
+        const int* p = vec.data();
+        EXPECT_EQ( p, &vec[0] );
+        EXPECT_EQ( p[2], 3 );
+        EXPECT_TRUE( ( std::is_same_v<decltype( vec.data() ), const int*> ) );
+        EXPECT_EQ( sc::vector<int>{}.data(), nullptr );
+    }
+#endif
+
+#ifdef SC_VECTOR_CONSTEXPR
+#if COMPILE_TIME_TABLE
+    {
+        BEGIN_TEST(tm, "CompileTimeTable", "a table of primes built by a vector in a constant expression");
+        // Checked by static_assert already; the table is a plain constexpr array at run time.
+        EXPECT_EQ( primes.size(), 16 );
+        EXPECT_EQ( primes[4], 11 );
+        EXPECT_TRUE( ( std::is_sorted( primes.begin(), primes.end() ) ) );
+    }
+#endif
+
+#if CONSTEXPR_OPERATIONS
+    {
+        BEGIN_TEST(tm, "ConstexprOperations", "push_back, insert, reserve, copies, moves, == at compile time");
+        constexpr bool trivial = trivial_operations();
+        constexpr bool owning = owning_operations();
+        EXPECT_TRUE( trivial );
+        EXPECT_TRUE( owning );
+        // The same code also runs at run time.
+        EXPECT_TRUE( trivial_operations() );
+        EXPECT_TRUE( owning_operations() );
+    }
+#endif
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
@@ -0,0 +1,185 @@
+#include <cstddef>
+#include<iostream>
+#include<iterator>
+#include<sstream>
+#include<string>
+#include<type_traits>
+
+#include "include/tm/test_manager.h"
+#include "../include/devector.h"
+#include "main.h"
+
+// =============================================================
+// devector tests, focused on the free room at both ends
+// =============================================================
+
+// push_front/pop_front do not move the other elements.
+#define FRONT_O1 YES
+// A queue (push_back + pop_front) keeps reusing the same buffer.
+#define QUEUE_REUSE YES
+// Growing keeps the elements contiguous and data() pointing to the first one.
+#define CONTIGUOUS YES
+// insert/erase in the middle shift the shorter side.
+#define MIDDLE_MODIFIERS YES
+// Copy/move/assign/swap.
+#define DEVECTOR_SPECIAL_MEMBERS YES
+
+/// Counts how many times it was moved or copied.
+struct Counted {
+    static int moves;
+    std::string m_value;
+
+    Counted( const std::string& v = "" ) : m_value{v} {}
+    Counted( const Counted& other ) : m_value{other.m_value} { ++moves; }
+    Counted( Counted&& other ) noexcept : m_value{std::move(other.m_value)} { ++moves; }
+    Counted& operator=( const Counted& other ) { m_value = other.m_value; ++moves; return *this; }
+    Counted& operator=( Counted&& other ) noexcept { m_value = std::move(other.m_value); ++moves; return *this; }
+};
+int Counted::moves{0};
+
+void run_devector_tests( void )
+{
+    TestManager tm{ "devector testing"};
+
+#if FRONT_O1
+    {
+        BEGIN_TEST(tm, "FrontO1", "push_front/pop_front amortized O(1)");
+        Counted::moves = 0;
+        sc::devector<Counted> dv;
+        for ( auto i{0} ; i < 1000 ; ++i )
+            dv.emplace_front( std::to_string(i) );
+        // Each element is moved O(1) times on average (only by reallocations).
+        EXPECT_LE( Counted::moves, 3000 );
+        EXPECT_EQ( dv.size(), 1000 );
+        EXPECT_EQ( dv.front().m_value, "999" );
+        EXPECT_EQ( dv.back().m_value, "0" );
+
+        auto moves = Counted::moves;
+        for ( auto i{0} ; i < 500 ; ++i )
+            dv.pop_front();
+        EXPECT_EQ( Counted::moves, moves );
+        EXPECT_EQ( dv.front().m_value, "499" );
+        EXPECT_GE( dv.front_free_capacity(), 500 );
+
+        // A single free slot, at the back: push_front must not re-center onto it.
+        sc::devector<int> small{ 1, 2 };
+        small.pop_back();
+        small.push_front( 7 );
+        EXPECT_EQ( small, ( sc::devector<int>{ 7, 1 } ) );
+        small.pop_front();
+        small.push_back( 8 );
+        EXPECT_EQ( small, ( sc::devector<int>{ 1, 8 } ) );
+    }
+#endif
+
+#if QUEUE_REUSE
+    {
+        BEGIN_TEST(tm, "QueueReuse", "sliding window stays within its buffer");
+        sc::devector<int> window;
+        for ( auto i{0} ; i < 64 ; ++i )
+            window.push_back( i );
+        window.shrink_to_fit();
+        window.reserve( 128 );
+        auto capacity = window.capacity();
+        for ( auto i{64} ; i < 100'000 ; ++i )
+        {
+            window.push_back( i );
+            window.pop_front();
+        }
+        // Re-centering in place: the buffer never grew.
+        EXPECT_EQ( window.capacity(), capacity );
+        EXPECT_EQ( window.size(), 64 );
+        EXPECT_EQ( window.front(), 100'000 - 64 );
+        EXPECT_EQ( window.back(), 99'999 );
+    }
+#endif
+
+#if CONTIGUOUS
+    {
+        BEGIN_TEST(tm, "Contiguous", "elements stay contiguous, data() is the first one");
+        sc::devector<int> dv;
+        for ( auto i{0} ; i < 100 ; ++i )
+        {
+            dv.push_back( i );
+            dv.push_front( -i-1 );
+        }
+        EXPECT_EQ( dv.size(), 200 );
+        EXPECT_EQ( dv.data(), &dv.front() );
+        EXPECT_EQ( dv.data() + 199, &dv.back() );
+        for ( auto i{0u} ; i < dv.size() ; ++i )
+            EXPECT_EQ( dv.data()[i], (int)i - 100 );
+        EXPECT_EQ( dv.end() - dv.begin(), 200 );
+        EXPECT_EQ( dv.at(0), -100 );
+        bool thrown{false};
+        try { dv.at(200); }
+        catch ( const std::out_of_range& ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+
+        dv.reserve_front( 300 );
+        EXPECT_GE( dv.front_free_capacity(), 100 );
+        EXPECT_EQ( dv[100], 0 );
+    }
+#endif
+
+#if MIDDLE_MODIFIERS
+    {
+        BEGIN_TEST(tm, "MiddleModifiers", "insert/erase in the middle");
+        sc::devector<std::string> dv{ "a", "b", "c", "d", "e", "f" };
+        dv.insert( dv.begin()+1, "x" );  // Close to the front.
+        dv.insert( dv.end()-1, "y" );    // Close to the back.
+        dv.emplace( dv.begin()+4, 2, 'z' );
+        EXPECT_EQ( dv, ( sc::devector<std::string>{ "a", "x", "b", "c", "zz", "d", "e", "y", "f" } ) );
+
+        dv.erase( dv.begin()+1 );
+        dv.erase( dv.end()-3, dv.end()-1 );
+        EXPECT_EQ( dv, ( sc::devector<std::string>{ "a", "b", "c", "zz", "d", "f" } ) );
+        dv.erase( dv.begin(), dv.end() );
+        EXPECT_TRUE( dv.empty() );
+
+        // Inserting an element of the devector itself.
+        sc::devector<std::string> self{ "1", "2", "3" };
+        self.insert( self.begin()+1, self[2] );
+        self.insert( self.begin()+2, self[0] );
+        EXPECT_EQ( self, ( sc::devector<std::string>{ "1", "3", "1", "2", "3" } ) );
+    }
+#endif
+
+#if DEVECTOR_SPECIAL_MEMBERS
+    {
+        BEGIN_TEST(tm, "SpecialMembers", "copy/move/assign/swap");
+        sc::devector<std::string> dv{ "a", "b", "c" };
+        dv.push_front( "z" );
+        sc::devector<std::string> copy{ dv };
+        EXPECT_EQ( copy, dv );
+        // A single-pass range is read once.
+        std::istringstream numbers{ "1 2 3 4" };
+        sc::devector<int> read( std::istream_iterator<int>{ numbers }, std::istream_iterator<int>{} );
+        EXPECT_EQ( read, ( sc::devector<int>{ 1, 2, 3, 4 } ) );
+        // Two integers are not an iterator range.
+        static_assert( not std::is_constructible_v< sc::devector<int>, int, int > );
+
+        auto data = dv.data();
+        sc::devector<std::string> moved{ std::move(dv) };
+        EXPECT_EQ( moved.data(), data );
+        EXPECT_TRUE( dv.empty() );
+
+        dv = moved;
+        EXPECT_EQ( dv, copy );
+        dv = { "1" };
+        EXPECT_EQ( dv.size(), 1 );
+        swap( dv, moved );
+        EXPECT_EQ( moved.front(), "1" );
+        EXPECT_EQ( dv, copy );
+        moved = std::move( dv );
+        EXPECT_EQ( moved, copy );
+        EXPECT_TRUE( moved != dv );
+        moved.clear();
+        moved.push_front( "q" );
+        moved.push_back( "r" );
+        EXPECT_EQ( moved, ( sc::devector<std::string>{ "q", "r" } ) );
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
@@ -0,0 +1,156 @@
+#include <cstddef>
+#include<algorithm>
+#include<iostream>
+#include<map>
+#include<random>
+#include<stdexcept>
+#include<string>
+#include<utility>
+#include<vector>
+
+#include "include/tm/test_manager.h"
+#include "../include/flat_map.h"
+#include "main.h"
+
+// =============================================================
+// flat_map tests: a sorted sc::vector of pairs with the
+// interface of std::map.
+// =============================================================
+
+// The range constructor sorts by key and keeps the first of each repeated key.
+#define BULK_CONSTRUCTION YES
+// operator[], at, find and the bounds.
+#define ELEMENT_ACCESS YES
+// insert, try_emplace, insert_or_assign, erase.
+#define MODIFIERS YES
+// A batch is merged in; keys already there keep their values.
+#define BATCH_INSERT YES
+// On random input, the same pairs as std::map.
+#define AGAINST_STD_MAP YES
+
+namespace {
+
+using pairs = sc::vector<std::pair<int, std::string>>;
+
+} // namespace.
+
+void run_flat_map_tests( void )
+{
+    TestManager tm{ "flat_map testing"};
+
+#if BULK_CONSTRUCTION
+    {
+        BEGIN_TEST(tm, "BulkConstruction", "sorted by key, the first of equal keys wins");
+        sc::flat_map<int, std::string> map{ { 3, "c" }, { 1, "a" }, { 3, "x" }, { 2, "b" }, { 1, "y" } };
+        EXPECT_EQ( map.sequence(), ( pairs{ { 1, "a" }, { 2, "b" }, { 3, "c" } } ) );
+        std::vector<std::pair<int, std::string>> source{ { 9, "i" }, { 8, "h" } };
+        sc::flat_map<int, std::string> ranged( source.begin(), source.end() );
+        EXPECT_EQ( ranged.begin()->first, 8 );
+        sc::flat_map<int, std::string> adopted{ sc::sorted_unique, pairs{ { 1, "a" }, { 5, "e" } } };
+        EXPECT_EQ( adopted.at( 5 ), "e" );
+        EXPECT_TRUE( ( sc::flat_map<int, int>{}.empty() ) );
+    }
+#endif
+
+#if ELEMENT_ACCESS
+    {
+        BEGIN_TEST(tm, "ElementAccess", "operator[] inserts, at() throws, find and bounds");
+        sc::flat_map<std::string, int> ports{ { "http", 80 }, { "ssh", 22 } };
+        ports["https"] = 443;
+        EXPECT_EQ( ports.size(), 3 );
+        EXPECT_EQ( ports["http"], 80 );
+        EXPECT_EQ( ports["ftp"], 0 ); // Value-initialized.
+        EXPECT_EQ( ports.at( "https" ), 443 );
+        bool thrown{false};
+        try { ports.at( "smtp" ); }
+        catch ( const std::out_of_range& ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+        const auto& cports = ports;
+        EXPECT_EQ( cports.find( "ssh" )->second, 22 );
+        EXPECT_TRUE( cports.find( "telnet" ) == cports.end() );
+        EXPECT_EQ( ports.lower_bound( "i" )->first, "ssh" );
+        EXPECT_EQ( ports.upper_bound( "http" )->first, "https" );
+        auto [first, last] = ports.equal_range( "ftp" );
+        EXPECT_EQ( last - first, 1 );
+        ports.find( "ssh" )->second = 2222;
+        EXPECT_EQ( ports["ssh"], 2222 );
+        EXPECT_TRUE( ports.contains( "ftp" ) );
+        EXPECT_EQ( ports.count( "gopher" ), 0 );
+    }
+#endif
+
+#if MODIFIERS
+    {
+        BEGIN_TEST(tm, "Modifiers", "insert and try_emplace keep old values; insert_or_assign replaces");
+        sc::flat_map<int, std::string> map;
+        EXPECT_TRUE( map.insert( { 2, "two" } ).second );
+        EXPECT_TRUE( not map.insert( std::make_pair( 2, std::string{ "deux" } ) ).second );
+        EXPECT_EQ( map[2], "two" );
+        std::string value{ "one" };
+        auto [it, inserted] = map.try_emplace( 1, std::move( value ) );
+        EXPECT_TRUE( inserted );
+        EXPECT_EQ( it->second, "one" );
+        std::string kept{ "uno" };
+        EXPECT_TRUE( not map.try_emplace( 1, std::move( kept ) ).second );
+        EXPECT_EQ( kept, "uno" ); // Not moved from.
+        EXPECT_TRUE( not map.insert_or_assign( 1, "uno" ).second );
+        EXPECT_EQ( map[1], "uno" );
+        EXPECT_TRUE( map.insert_or_assign( 3, "tres" ).second );
+        EXPECT_TRUE( map.emplace( 0, "zero" ).second );
+        EXPECT_EQ( map.begin()->second, "zero" );
+
+        EXPECT_EQ( map.erase( 2 ), 1 );
+        EXPECT_EQ( map.erase( 2 ), 0 );
+        auto next = map.erase( map.begin() );
+        EXPECT_EQ( next->first, 1 );
+        map.erase( map.cbegin(), map.cend() - 1 );
+        EXPECT_EQ( map.sequence(), ( pairs{ { 3, "tres" } } ) );
+    }
+#endif
+
+#if BATCH_INSERT
+    {
+        BEGIN_TEST(tm, "BatchInsert", "new keys merged in once; present keys unchanged");
+        sc::flat_map<int, std::string> map{ { 10, "a" }, { 30, "c" } };
+        std::vector<std::pair<int, std::string>> batch{ { 30, "X" }, { 20, "b" }, { 5, "z" }, { 20, "Y" } };
+        map.insert( batch.begin(), batch.end() );
+        EXPECT_EQ( map.sequence(), ( pairs{ { 5, "z" }, { 10, "a" }, { 20, "b" }, { 30, "c" } } ) );
+        map.insert( { { 40, "d" }, { 35, "e" } } );
+        EXPECT_EQ( map.size(), 6 );
+        EXPECT_EQ( ( map.end() - 1 )->second, "d" );
+    }
+#endif
+
+#if AGAINST_STD_MAP
+    {
+        BEGIN_TEST(tm, "AgainstStdMap", "random operations give std::map's pairs");
+        std::mt19937 gen{ 11 };
+        std::map<int, int> expected;
+        sc::flat_map<int, int> map;
+        bool same{true};
+        for ( auto round{0} ; round < 300 ; ++round ) {
+            int key = gen() % 300;
+            int value = gen() % 1000;
+            switch ( gen() % 4 ) {
+                case 0: map[key] = value; expected[key] = value; break;
+                case 1: same = same && map.erase( key ) == expected.erase( key ); break;
+                case 2:
+                    same = same && map.insert( { key, value } ).second == expected.insert( { key, value } ).second;
+                    break;
+                default: {
+                    std::vector<std::pair<int, int>> batch( gen() % 16 );
+                    for ( auto& p : batch ) p = { int( gen() % 300 ), int( gen() % 1000 ) };
+                    map.insert( batch.begin(), batch.end() );
+                    expected.insert( batch.begin(), batch.end() );
+                }
+            }
+            same = same && std::equal( map.begin(), map.end(), expected.begin(), expected.end(),
+                                       []( const auto& a, const auto& b ){ return a.first == b.first && a.second == b.second; } );
+        }
+        EXPECT_TRUE( same );
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
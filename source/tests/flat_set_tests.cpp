@@ -0,0 +1,182 @@
+#include <cstddef>
+#include<algorithm>
+#include<functional>
+#include<iostream>
+#include<iterator>
+#include<list>
+#include<random>
+#include<set>
+#include<string>
+#include<vector>
+
+#include "include/tm/test_manager.h"
+#include "../include/flat_set.h"
+#include "main.h"
+
+// =============================================================
+// flat_set tests: a sorted sc::vector with the interface of
+// std::set, bulk construction and batch insertion.
+// =============================================================
+
+// The range constructor sorts and drops the duplicates; sorted_unique adopts as is.
+#define BULK_CONSTRUCTION YES
+// find, contains, count, lower_bound, upper_bound, equal_range.
+#define LOOKUP YES
+// Single insert/emplace/erase keep the keys sorted and unique.
+#define SINGLE_MODIFIERS YES
+// A batch is merged in; keys already there are left alone.
+#define BATCH_INSERT YES
+// On random input, the same keys as std::set.
+#define AGAINST_STD_SET YES
+
+void run_flat_set_tests( void )
+{
+    TestManager tm{ "flat_set testing"};
+
+#if BULK_CONSTRUCTION
+    {
+        BEGIN_TEST(tm, "BulkConstruction", "sort + unique from a range; sorted_unique adopts the vector");
+        sc::flat_set<int> set{ 5, 1, 4, 1, 5, 9, 2, 6, 5 };
+        EXPECT_EQ( set.size(), 6 );
+        EXPECT_EQ( set.sequence(), ( sc::vector<int>{ 1, 2, 4, 5, 6, 9 } ) );
+        const std::list<std::string> words{ "pear", "apple", "pear", "fig" };
+        sc::flat_set<std::string, std::greater<>> desc( words.begin(), words.end() );
+        EXPECT_EQ( *desc.begin(), "pear" );
+        EXPECT_EQ( desc.size(), 3 );
+
+        sc::vector<int> keys{ 1, 3, 5 };
+        const int* buffer = keys.data();
+        sc::flat_set<int> adopted{ sc::sorted_unique, std::move( keys ) };
+        EXPECT_EQ( adopted.sequence().data(), buffer ); // No copy.
+        EXPECT_TRUE( adopted.contains( 3 ) );
+        sc::flat_set<int> sorted{ sc::vector<int>{ 3, 3, 1 } };
+        EXPECT_EQ( sorted.sequence(), ( sc::vector<int>{ 1, 3 } ) );
+        sc::vector<int> out = std::move( sorted ).extract();
+        EXPECT_EQ( out.size(), 2 );
+        EXPECT_TRUE( sorted.empty() );
+        EXPECT_TRUE( sc::flat_set<int>{}.empty() );
+    }
+#endif
+
+#if LOOKUP
+    {
+        BEGIN_TEST(tm, "Lookup", "binary search over the sorted keys");
+        sc::flat_set<int> set{ 10, 20, 30, 40, 50 };
+        EXPECT_EQ( *set.find( 30 ), 30 );
+        EXPECT_TRUE( set.find( 35 ) == set.end() );
+        EXPECT_TRUE( set.contains( 10 ) );
+        EXPECT_TRUE( not set.contains( 55 ) );
+        EXPECT_EQ( set.count( 50 ), 1 );
+        EXPECT_EQ( set.count( 0 ), 0 );
+        EXPECT_EQ( *set.lower_bound( 25 ), 30 );
+        EXPECT_EQ( *set.lower_bound( 20 ), 20 );
+        EXPECT_EQ( *set.upper_bound( 20 ), 30 );
+        EXPECT_TRUE( set.lower_bound( 60 ) == set.end() );
+        EXPECT_TRUE( set.lower_bound( 0 ) == set.begin() );
+        auto [first, last] = set.equal_range( 40 );
+        EXPECT_EQ( last - first, 1 );
+        auto [none, none_end] = set.equal_range( 45 );
+        EXPECT_TRUE( none == none_end );
+
+        // Every size around the powers of two, every key and the gaps between them.
+        bool found{true};
+        for ( int n{0} ; n < 70 ; ++n ) {
+            sc::vector<int> keys;
+            for ( int i{0} ; i < n ; ++i ) keys.push_back( 2 * i );
+            sc::flat_set<int> s{ sc::sorted_unique, std::move( keys ) };
+            for ( int k{-1} ; k <= 2 * n ; ++k ) {
+                bool present = k >= 0 && k % 2 == 0 && k < 2 * n;
+                found = found && s.contains( k ) == present
+                              && s.lower_bound( k ) - s.begin() == ( k + 1 ) / 2;
+            }
+        }
+        EXPECT_TRUE( found );
+    }
+#endif
+
+#if SINGLE_MODIFIERS
+    {
+        BEGIN_TEST(tm, "SingleModifiers", "insert/emplace report whether the key was new; erase by key or position");
+        sc::flat_set<std::string> set;
+        auto [it, inserted] = set.insert( "m" );
+        EXPECT_TRUE( inserted );
+        EXPECT_EQ( *it, "m" );
+        EXPECT_TRUE( set.insert( "a" ).second );
+        EXPECT_TRUE( set.emplace( 1, 'z' ).second );
+        auto again = set.insert( std::string{ "m" } );
+        EXPECT_TRUE( not again.second );
+        EXPECT_EQ( again.first - set.begin(), 1 );
+        EXPECT_EQ( set.sequence(), ( sc::vector<std::string>{ "a", "m", "z" } ) );
+
+        EXPECT_EQ( set.erase( "m" ), 1 );
+        EXPECT_EQ( set.erase( "m" ), 0 );
+        auto next = set.erase( set.begin() );
+        EXPECT_EQ( *next, "z" );
+        set.insert( { "b", "c", "d" } );
+        set.erase( set.begin(), set.find( "d" ) );
+        EXPECT_EQ( set.sequence(), ( sc::vector<std::string>{ "d", "z" } ) );
+
+        sc::flat_set<std::string> other{ "q" };
+        swap( set, other );
+        EXPECT_EQ( set.size(), 1 );
+        EXPECT_TRUE( other.contains( "z" ) );
+        EXPECT_TRUE( ( set != other ) );
+        other = set;
+        EXPECT_TRUE( ( set == other ) );
+    }
+#endif
+
+#if BATCH_INSERT
+    {
+        BEGIN_TEST(tm, "BatchInsert", "sort the batch, drop known and repeated keys, merge once");
+        sc::flat_set<int> set{ 10, 20, 30 };
+        std::vector<int> batch{ 25, 5, 20, 35, 5, 15 };
+        set.insert( batch.begin(), batch.end() );
+        EXPECT_EQ( set.sequence(), ( sc::vector<int>{ 5, 10, 15, 20, 25, 30, 35 } ) );
+        const int tail[]{ 50, 40, 40 }; // All after the last key: appended.
+        set.insert( std::begin( tail ), std::end( tail ) );
+        EXPECT_EQ( set.size(), 9 );
+        EXPECT_EQ( *( set.end() - 1 ), 50 );
+        set.insert( batch.begin(), batch.end() ); // Nothing new.
+        EXPECT_EQ( set.size(), 9 );
+        set.insert( batch.begin(), batch.begin() );
+        EXPECT_EQ( set.size(), 9 );
+        sc::flat_set<int> empty;
+        empty.insert( { 3, 1, 2 } );
+        EXPECT_EQ( empty.sequence(), ( sc::vector<int>{ 1, 2, 3 } ) );
+    }
+#endif
+
+#if AGAINST_STD_SET
+    {
+        BEGIN_TEST(tm, "AgainstStdSet", "random inserts, batches and erases give std::set's keys");
+        std::mt19937 gen{ 7 };
+        std::set<int> expected;
+        sc::flat_set<int> set;
+        bool same{true};
+        for ( auto round{0} ; round < 200 ; ++round ) {
+            int key = gen() % 500;
+            switch ( gen() % 3 ) {
+                case 0:
+                    same = same && set.insert( key ).second == expected.insert( key ).second;
+                    break;
+                case 1:
+                    same = same && set.erase( key ) == expected.erase( key );
+                    break;
+                default: {
+                    std::vector<int> batch( gen() % 20 );
+                    for ( auto& k : batch ) k = gen() % 500;
+                    set.insert( batch.begin(), batch.end() );
+                    expected.insert( batch.begin(), batch.end() );
+                }
+            }
+            same = same && std::equal( set.begin(), set.end(), expected.begin(), expected.end() )
+                        && set.contains( key ) == ( expected.count( key ) == 1 );
+        }
+        EXPECT_TRUE( same );
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
@@ -7,6 +7,208 @@
 
 #include "test_manager.h"
 
+#include <atomic>     // atomic
+#include <chrono>     // steady_clock
+#include <cstdint>    // uint64_t
+#include <cstdlib>    // getenv, malloc, free, strtod
+#include <fstream>    // ifstream, ofstream
+#include <new>        // bad_alloc, nothrow_t
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+/// Calls to the global `operator new`, counted by the replacements below.
+std::atomic< size_t > n_allocations{0};
+/// Failed tests, over every suite summarized so far.
+size_t n_failures{0};
+
+long long now_ns( void )
+{
+    using namespace std::chrono;
+    return duration_cast< nanoseconds >( steady_clock::now().time_since_epoch() ).count();
+}
+
+/// A measurement recorded in a baseline file.
+struct Baseline { double ns; double allocs; };
+
+/// The baseline file named by TM_BENCH_BASELINE, read once. Each line is `ns allocs id`.
+const std::unordered_map< std::string, Baseline >& baselines( void )
+{
+    static const std::unordered_map< std::string, Baseline > table = []{
+        std::unordered_map< std::string, Baseline > t;
+        if ( const char* file = std::getenv( "TM_BENCH_BASELINE" ) )
+        {
+            std::ifstream in{ file };
+            Baseline b;
+            std::string id;
+            while ( in >> b.ns >> b.allocs and std::getline( in >> std::ws, id ) )
+                t[id] = b;
+        }
+        return t;
+    }();
+    return table;
+}
+
+/// How much slower than its baseline a measurement may be (TM_BENCH_TOLERANCE, 25% by default).
+double tolerance( void )
+{
+    const char* value = std::getenv( "TM_BENCH_TOLERANCE" );
+    return value ? std::strtod( value, nullptr ) : 0.25;
+}
+
+#if defined(__linux__)
+/// Opens a user-space hardware counter of this thread, in the group of `leader` (-1: a new group).
+int open_counter( std::uint64_t config, int leader )
+{
+    perf_event_attr attr{};
+    attr.size = sizeof( attr );
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = leader == -1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast< int >( syscall( SYS_perf_event_open, &attr, 0, -1, leader, 0 ) );
+}
+
+double read_counter( int fd )
+{
+    std::uint64_t value{0};
+    return read( fd, &value, sizeof( value ) ) == sizeof( value ) ? static_cast< double >( value ) : -1;
+}
+#endif
+
+} // namespace.
+
+// Counting replacements of the global allocation functions (all the forms that are not
+// over-aligned, so they pair with each other and not with a sanitizer's). Over-aligned
+// allocations are not counted.
+void* operator new( std::size_t size )
+{
+    n_allocations.fetch_add( 1, std::memory_order_relaxed );
+    if ( void* p = std::malloc( size ? size : 1 ) ) return p;
+    throw std::bad_alloc{};
+}
+void* operator new[]( std::size_t size ) { return ::operator new( size ); }
+void* operator new( std::size_t size, const std::nothrow_t& ) noexcept
+{
+    n_allocations.fetch_add( 1, std::memory_order_relaxed );
+    return std::malloc( size ? size : 1 );
+}
+void* operator new[]( std::size_t size, const std::nothrow_t& tag ) noexcept { return ::operator new( size, tag ); }
+void operator delete( void* p ) noexcept { std::free( p ); }
+void operator delete[]( void* p ) noexcept { std::free( p ); }
+void operator delete( void* p, std::size_t ) noexcept { std::free( p ); }
+void operator delete[]( void* p, std::size_t ) noexcept { std::free( p ); }
+void operator delete( void* p, const std::nothrow_t& ) noexcept { std::free( p ); }
+void operator delete[]( void* p, const std::nothrow_t& ) noexcept { std::free( p ); }
+
+size_t TestManager::allocations( void ) { return n_allocations.load( std::memory_order_relaxed ); }
+
+size_t TestManager::failures( void ) { return n_failures; }
+
+TestManager::Sampler::Sampler( void ) : m_cycles_fd{-1}, m_instructions_fd{-1}, m_start_ns{0}, m_start_allocs{0}
+{
+#if defined(__linux__)
+    m_cycles_fd = open_counter( PERF_COUNT_HW_CPU_CYCLES, -1 );
+    if ( m_cycles_fd != -1 )
+        m_instructions_fd = open_counter( PERF_COUNT_HW_INSTRUCTIONS, m_cycles_fd );
+#endif
+}
+
+TestManager::Sampler::~Sampler( void )
+{
+#if defined(__linux__)
+    if ( m_instructions_fd != -1 ) close( m_instructions_fd );
+    if ( m_cycles_fd != -1 ) close( m_cycles_fd );
+#endif
+}
+
+void TestManager::Sampler::start( void )
+{
+#if defined(__linux__)
+    if ( m_cycles_fd != -1 )
+    {
+        ioctl( m_cycles_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP );
+        ioctl( m_cycles_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP );
+    }
+#endif
+    m_start_allocs = allocations();
+    m_start_ns = now_ns();
+}
+
+TestManager::Measurement TestManager::Sampler::stop( size_t runs )
+{
+    long long end_ns = now_ns();
+    size_t end_allocs = allocations();
+    Measurement m;
+#if defined(__linux__)
+    if ( m_cycles_fd != -1 )
+    {
+        ioctl( m_cycles_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP );
+        double cycles = read_counter( m_cycles_fd );
+        double instructions = m_instructions_fd != -1 ? read_counter( m_instructions_fd ) : -1;
+        if ( cycles >= 0 ) m.cycles = cycles / runs;
+        if ( instructions >= 0 ) m.instructions = instructions / runs;
+    }
+#endif
+    m.ns = static_cast< double >( end_ns - m_start_ns ) / runs;
+    m.allocs = static_cast< double >( end_allocs - m_start_allocs ) / runs;
+    return m;
+}
+
+/*!
+ * Registers a test and starts its clock and allocation count; the previous test, if still
+ * running, is finished.
+ * @param key_name The unique test key, which is the test's name.
+ * @param msg The test description.
+ * @param bench Whether the test was opened by `BEGIN_BENCH`.
+ */
+void TestManager::record( const std::string &key_name, const std::string& msg, bool bench )
+{
+    stop_running();
+    // Store the entry in the data base.
+    tests_record[key_name] = Entry{ msg, n_tests++ };
+    tests_record[key_name].m_bench = bench;
+    running = key_name;
+    running_start_allocs = allocations();
+    running_start_ns = now_ns();
+}
+
+void TestManager::stop_running( void )
+{
+    if ( running.empty() ) return;
+    auto &entry = tests_record[ running ];
+    entry.m_ms = static_cast< double >( now_ns() - running_start_ns ) / 1e6;
+    entry.m_allocs = allocations() - running_start_allocs;
+    running.clear();
+}
+
+/*!
+ * Keeps a measurement of the test `key` and compares it with its baseline, if there is one: it
+ * fails the test when slower by more than the tolerance, or when it allocates more.
+ * @param key The unique test key, which is the test's name.
+ * @param m The measurement.
+ * @param line The line number of the `MEASURE`.
+ */
+void TestManager::record_measure( const std::string &key, Measurement m, int line )
+{
+    auto found = baselines().find( test_suite_name + "/" + key + "/" + m.label );
+    if ( found != baselines().end() )
+    {
+        m.baseline_ns = found->second.ns;
+        m.regressed = m.ns > found->second.ns * ( 1 + tolerance() )
+                      or m.allocs > found->second.allocs * 1.0001 + 1e-9;
+    }
+    result( key, not m.regressed, line );
+    tests_record[key].m_measures.push_back( m );
+}
+
 /*!
  * Updates the test result database.
  * @param key The unique test key, which is the test's name.
@@ -27,8 +229,28 @@ void TestManager::result( const std::string &key, bool value, int line )
     }
 }
 
-void TestManager::summary(void) const
+void TestManager::print_cost( const Entry &entry ) const
 {
+    std::cout << " (" << std::fixed << std::setprecision( 3 ) << entry.m_ms << " ms, "
+              << entry.m_allocs << " allocations)\n";
+    for ( const auto & m : entry.m_measures )
+    {
+        std::cout << ( m.regressed ? "[ \e[1;31mREGRESSED\e[0m ] " : "[           ] " )
+                  << m.label << ": " << std::setprecision( 1 ) << m.ns << " ns, "
+                  << std::setprecision( 2 ) << m.allocs << " allocations";
+        if ( m.cycles >= 0 ) std::cout << ", " << std::setprecision( 0 ) << m.cycles << " cycles";
+        if ( m.instructions >= 0 ) std::cout << ", " << std::setprecision( 0 ) << m.instructions << " instructions";
+        std::cout << " per run";
+        if ( m.baseline_ns >= 0 ) std::cout << " (baseline " << std::setprecision( 1 ) << m.baseline_ns << " ns)";
+        std::cout << '\n';
+    }
+    std::cout.unsetf( std::ios::floatfield );
+    std::cout << std::setprecision( 6 );
+}
+
+void TestManager::summary(void)
+{
+    stop_running();
     size_t n_successful{0}, n_failed{0}, n_disabled{0}, n_undefined{0};
 
     // This list helps us to print all the test results in the same order
@@ -59,4 +281,15 @@ void TestManager::summary(void) const
     if ( n_failed != 0 )     std::cout << "[ "<< "\e[1;31mFAILED\e[0m"    << "    ] " << n_failed     << " tests.\n";
     if ( n_disabled != 0 )   std::cout << "[ "<< "\e[1;36mDISABLED\e[0m"  << "  ] "   << n_disabled   << " tests.\n";
     if ( n_undefined != 0 )  std::cout << "[ "<< "\e[1;35mUNDEFINED\e[0m" << " ] "    << n_undefined  << " tests.\n";
+    n_failures += n_failed;
+
+    // Append the measurements to the baseline being recorded, if any.
+    if ( const char* file = std::getenv( "TM_BENCH_RECORD" ) )
+    {
+        std::ofstream out{ file, std::ios::app };
+        out << std::setprecision( 10 );
+        for ( const auto & t : sorted_list )
+            for ( const auto & m : t.second.m_measures )
+                out << m.ns << ' ' << m.allocs << ' ' << test_suite_name << '/' << t.first << '/' << m.label << '\n';
+    }
 }
@@ -8,6 +8,21 @@
  * @author Selan R. dos Santos
  * 
  * Updated on January 27th, 2021: improved macro definition and unified divergent versions.
+ *
+ * Timed tests: `BEGIN_BENCH` opens a test whose `MEASURE`s time a piece of code (best of a few
+ * samples, per run: wall clock, allocations through `operator new` and, on Linux when
+ * `perf_event_open` is allowed, CPU cycles and instructions). `EXPECT_FASTER_THAN` and
+ * `EXPECT_ALLOCS_LE` check them like any other expectation.
+ *
+ *     BEGIN_BENCH(tm, "Lookup", "flat_set against a linear scan");
+ *     auto flat = MEASURE( "flat_set", 100, hits += set.contains( key ) );
+ *     auto scan = MEASURE( "find", 100, hits += std::find( v.begin(), v.end(), key ) != v.end() );
+ *     EXPECT_FASTER_THAN( flat, scan );
+ *
+ * Each measurement is also a regression gate. With `TM_BENCH_RECORD=<file>` in the environment,
+ * `summary()` appends every measurement to `<file>`; with `TM_BENCH_BASELINE=<file>`, a
+ * measurement more than `TM_BENCH_TOLERANCE` (0.25 by default: 25%) slower than its baseline,
+ * or allocating more, fails its test.
  */
 
 #include <iostream>   // cout, endl
@@ -25,10 +40,23 @@ using std::string;
 using std::unordered_map;
 #include <vector>
 using std::vector;
+#include <cstddef>    // size_t
 
 
 /// Implements a simple test manager.
 class TestManager {
+    public:
+        /// The cost of one run of the code given to `measure()`.
+        struct Measurement {
+            string label;              //!< What was measured, unique within the test.
+            double ns{0};              //!< Wall-clock nanoseconds.
+            double allocs{0};          //!< Calls to the global `operator new`.
+            double cycles{-1};         //!< CPU cycles (-1: no hardware counters).
+            double instructions{-1};   //!< Retired instructions (-1: no hardware counters).
+            double baseline_ns{-1};    //!< The recorded `ns` this one is compared to (-1: none).
+            bool regressed{false};     //!< Slower or allocating more than the baseline allows.
+        };
+
     private:
         /// Defines a single entry in our database.
         struct Entry {
@@ -39,6 +67,10 @@ class TestManager {
             result_t m_result; //!< The test result.
             int m_line;        //!< The test line number.
             bool m_enabled;    //!< Indicates wheter the test is enabled (default) or not.
+            bool m_bench{false};          //!< Registered by `BEGIN_BENCH`.
+            double m_ms{-1};              //!< Wall-clock milliseconds the test took (-1: still running).
+            size_t m_allocs{0};           //!< Allocations made while the test ran.
+            vector< Measurement > m_measures; //!< What the test's `MEASURE`s found, in order.
             /// Default Ctro
             Entry( string d="no_name", size_t s = 0, result_t r=result_t::UNDEFINED, int l=0, bool e=true )
                 : m_desc{ d }, m_seq{ s }, m_result{ r }, m_line{ l }, m_enabled{ e }
@@ -50,25 +82,59 @@ class TestManager {
         std::string test_suite_name;
         /// Number of tests registred.
         size_t n_tests;
+        /// The test that is running (the last one registered), to time it.
+        std::string running;
+        /// Clock reading and allocation count when `running` started.
+        long long running_start_ns{0};
+        size_t running_start_allocs{0};
+
+        /// Reads the hardware counters and the clock around the samples of `measure()`.
+        class Sampler {
+            public:
+                Sampler( void );
+                ~Sampler( void );
+                Sampler( const Sampler& ) = delete;
+                Sampler& operator=( const Sampler& ) = delete;
+                void start( void );
+                /// What the runs since `start()` cost, divided by `runs`.
+                Measurement stop( size_t runs );
+            private:
+                int m_cycles_fd;       //!< perf_event file descriptors, -1 if unavailable.
+                int m_instructions_fd;
+                long long m_start_ns;
+                size_t m_start_allocs;
+        };
+
+        /// Stores `m` under `key`, failing the test if it regressed from its baseline.
+        void record_measure( const std::string &key, Measurement m, int line );
+        /// Closes the timing of the running test.
+        void stop_running( void );
 
     private:
         /// Prints out the overall result of a single test.
         void print_test_result( const std::string &test_name, const Entry &entry ) const
         {
-            std::cout << "[ " << "\e[1;34mRUN\e[0m" << "       ] " << test_name << "-> " << entry.m_desc << std::endl;
+            if ( entry.m_bench )
+                std::cout << "[ " << "\e[1;34mBENCH\e[0m" << "     ] " << test_name << "-> " << entry.m_desc << std::endl;
+            else
+                std::cout << "[ " << "\e[1;34mRUN\e[0m" << "       ] " << test_name << "-> " << entry.m_desc << std::endl;
             if ( entry.m_enabled == false )
             {
                 std::cout << "[  " << "\e[1;36mDISABLED\e[0m" << " ]\n";
                 return;
             }
             if ( entry.m_result == Entry::result_t::SUCCESS )
-                std::cout << "[        " << "\e[1;32mOK\e[0m" << " ]\n";
+                std::cout << "[        " << "\e[1;32mOK\e[0m" << " ]";
             else if ( entry.m_result == Entry::result_t::FAILED )
-                std::cout << "[      "  << "\e[1;31mFAIL\e[0m" << " ] at line " << entry.m_line << ".\n";
+                std::cout << "[      "  << "\e[1;31mFAIL\e[0m" << " ] at line " << entry.m_line << ".";
             else if ( entry.m_result == Entry::result_t::UNDEFINED )
-                std::cout << "[ "  << "\e[1;35mUNDEFINED\e[0m" << " ] at line " << entry.m_line << ".\n";
+                std::cout << "[ "  << "\e[1;35mUNDEFINED\e[0m" << " ] at line " << entry.m_line << ".";
+            print_cost( entry );
         }
 
+        /// Prints how long a test took, what it allocated and its measurements.
+        void print_cost( const Entry &entry ) const;
+
         //=== Public interface.
     public:
         /// Default constructor that may take the test suite name.
@@ -76,12 +142,8 @@ class TestManager {
             : test_suite_name{ suite_name }, n_tests{0}
         { /* empty */ }
 
-        /// Registers a test with this suite
-        inline void record ( const std::string &key_name, const std::string& msg )
-        {
-            // Store the entry in the data base.
-            tests_record[key_name] = Entry{ msg, n_tests++ };
-        }
+        /// Registers a test with this suite and starts timing it.
+        void record ( const std::string &key_name, const std::string& msg, bool bench=false );
 
         inline void enable ( const std::string &key_name, bool value=true )
         {
@@ -95,8 +157,51 @@ class TestManager {
         /// Updates the test result.
         void result( const std::string &key, bool value, int line );
 
-        /// Shows the test suite results.
-        void summary(void) const;
+        /// Runs `fn` `runs` times per sample and keeps the cheapest sample, per run.
+        /*!
+         * One warm-up run comes first (caches, lazy allocations); the best of the samples is the
+         * one least disturbed by the rest of the machine.
+         */
+        template < typename Fn >
+        Measurement measure( const std::string &key, const std::string &label, size_t runs, Fn&& fn, int line )
+        {
+            constexpr int n_samples{5};
+            if ( runs == 0 ) runs = 1;
+            fn();
+            Sampler sampler;
+            Measurement best;
+            for ( int s{0} ; s < n_samples ; ++s )
+            {
+                sampler.start();
+                for ( size_t i{0} ; i < runs ; ++i ) fn();
+                Measurement m = sampler.stop( runs );
+                if ( s == 0 or m.ns < best.ns ) best = m;
+            }
+            best.label = label;
+            record_measure( key, best, line );
+            return best;
+        }
+
+        /// Keeps the compiler from optimizing `value` (and the work that produced it) away.
+        template < typename T >
+        static void do_not_optimize( const T& value )
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            asm volatile( "" : : "r,m"(value) : "memory" );
+#else
+            static volatile const void* sink;
+            sink = &value;
+#endif
+        }
+
+        /// Calls to the global `operator new` so far, in every thread.
+        static size_t allocations( void );
+
+        /// Failed tests in every suite whose `summary()` ran, for the program's exit status.
+        static size_t failures( void );
+
+        /// Shows the test suite results (and records the measurements if asked to).
+        void summary(void);
 };
 
 //=== MACRO definitions.
@@ -117,4 +222,12 @@ class TestManager {
 #define EXPECT_LT( value1, value2 ) _tm.result( _test_id, value1<value2, __LINE__ )
 #define EXPECT_LE( value1, value2 ) _tm.result( _test_id, value1<=value2, __LINE__ )
 #define DISABLE() _tm.enable( _test_id, false );
+//=== Timed tests.
+#define BEGIN_BENCH(tm, key, msg) std::string _test_id{key}; \
+    TestManager &_tm = tm; \
+    _tm.record( key, msg, true )
+/// Measures the statements after `runs`, run `runs` times per sample; yields a `TestManager::Measurement`.
+#define MEASURE( label, runs, ... ) _tm.measure( _test_id, label, runs, [&]{ __VA_ARGS__; }, __LINE__ )
+#define EXPECT_FASTER_THAN( fast, slow ) _tm.result( _test_id, (fast).ns < (slow).ns, __LINE__ )
+#define EXPECT_ALLOCS_LE( measure, count ) _tm.result( _test_id, (measure).allocs <= (count), __LINE__ )
 
@@ -1,10 +1,15 @@
 #include<iostream>
 #include<vector>
+#include<algorithm>
+#include<iterator>
+#include<string>
 
 #include "include/tm/test_manager.h"
 #include "../include/vector.h"
 #include "main.h"
 
+// vec[vec.capacity()] (the slot end() points to) throws when hardened (see checks.h).
+constexpr bool unchecked_subscript{ sc::vector_checks < sc::check_level::hardened };
 
 // =============================================================
 // Second batch of tests, focused on the iterator interface
@@ -52,6 +57,14 @@
 #define EQUAL YES
 // Different operator. it1 != it2
 #define DIFFERENT YES
+// Subscript operator. it[n]
+#define SUBSCRIPT YES
+// Random access category, iterator -> const_iterator conversion and mixed comparisons.
+#define RANDOM_ACCESS YES
+// Equality compares addresses, not the pointed-to values.
+#define EQUAL_BY_ADDRESS YES
+// Standard algorithms that require random access iterators.
+#define STD_ALGORITHMS YES
 
 
 void run_iterator_tests( void )
@@ -119,7 +132,7 @@ void run_iterator_tests( void )
         which_lib::vector<int> vec { 1, 2, 4, 5, 6 };
 
         auto it = vec.end();
-        EXPECT_EQ( *it , vec[vec.capacity()] );
+        if ( unchecked_subscript ) EXPECT_EQ( *it , vec[vec.capacity()] );
 
         auto vec2 = vec;
         it = vec2.end();
@@ -208,7 +221,8 @@ void run_iterator_tests( void )
         {
             // std::cout << it << " == " << &vec[i] << "\n";
             // same address
-            EXPECT_EQ( *it , vec[i--] );
+            if ( unchecked_subscript or i < vec.size() ) EXPECT_EQ( *it , vec[i] );
+            --i;
             --it;
         }
         EXPECT_EQ( *it , vec[i] );
@@ -227,7 +241,8 @@ void run_iterator_tests( void )
         while( it != vec.begin() )
         {
             // same address
-            EXPECT_EQ( *it , vec[i--] );
+            if ( unchecked_subscript or i < vec.size() ) EXPECT_EQ( *it , vec[i] );
+            --i;
             it--;
         }
         EXPECT_EQ( *it , vec[i] );
@@ -436,5 +451,82 @@ void run_iterator_tests( void )
     }
 #endif
 
+#if SUBSCRIPT
+    {
+        BEGIN_TEST(tm, "operator[]()","it[n]");
+
+        which_lib::vector<int> vec { 1, 2, 4, 5, 6 };
+
+        auto it = vec.begin()+1;
+        EXPECT_EQ( it[0], 2 );
+        EXPECT_EQ( it[3], 6 );
+        EXPECT_EQ( it[-1], 1 );
+        it[1] = 10;
+        EXPECT_EQ( vec[2], 10 );
+        EXPECT_EQ( vec.cbegin()[2], 10 );
+    }
+#endif
+
+#if RANDOM_ACCESS
+    {
+        BEGIN_TEST(tm, "RandomAccess","iterator_category and const_iterator conversion");
+        using it_t = which_lib::vector<int>::iterator;
+        using cit_t = which_lib::vector<int>::const_iterator;
+        static_assert( std::is_same_v< std::iterator_traits<it_t>::iterator_category, std::random_access_iterator_tag > );
+        static_assert( std::is_same_v< std::iterator_traits<cit_t>::value_type, int > );
+        static_assert( std::is_convertible_v< it_t, cit_t > );
+        static_assert( not std::is_convertible_v< cit_t, it_t > );
+#if __cplusplus >= 202002L
+        static_assert( std::contiguous_iterator< it_t > );
+        static_assert( std::contiguous_iterator< cit_t > );
+#endif
+
+        which_lib::vector<int> vec { 1, 2, 4, 5, 6 };
+        cit_t cit = vec.begin();
+        EXPECT_TRUE( cit == vec.begin() );
+        EXPECT_TRUE( vec.begin() == cit );
+        EXPECT_TRUE( vec.end() != cit );
+        EXPECT_TRUE( cit < vec.end() );
+        EXPECT_EQ( vec.end() - cit, 5 );
+        EXPECT_EQ( *(++cit), 2 );
+        EXPECT_EQ( std::distance( vec.cbegin(), vec.cend() ), 5 );
+    }
+#endif
+
+#if EQUAL_BY_ADDRESS
+    {
+        BEGIN_TEST(tm, "EqualByAddress","it1 == it2 only for the same slot");
+
+        which_lib::vector<std::string> vec { "a", "a", "a" };
+        // Same value, different slots.
+        EXPECT_TRUE( vec.begin() != vec.begin()+1 );
+        EXPECT_FALSE( vec.begin() == vec.begin()+1 );
+        auto count{0};
+        for ( auto it = vec.begin() ; it != vec.end() ; ++it )
+            ++count;
+        EXPECT_EQ( count, 3 );
+    }
+#endif
+
+#if STD_ALGORITHMS
+    {
+        BEGIN_TEST(tm, "StdAlgorithms","std::sort, std::copy, std::lower_bound, std::reverse");
+
+        which_lib::vector<int> vec { 5, 3, 1, 4, 2 };
+        std::sort( vec.begin(), vec.end() );
+        EXPECT_EQ( vec, ( which_lib::vector<int>{ 1, 2, 3, 4, 5 } ) );
+        EXPECT_EQ( *std::lower_bound( vec.cbegin(), vec.cend(), 4 ), 4 );
+        std::reverse( vec.begin(), vec.end() );
+        EXPECT_EQ( vec, ( which_lib::vector<int>{ 5, 4, 3, 2, 1 } ) );
+
+        std::vector<int> out( vec.size() );
+        std::copy( vec.cbegin(), vec.cend(), out.begin() );
+        EXPECT_EQ( out[0], 5 );
+        EXPECT_EQ( out[4], 1 );
+        std::nth_element( vec.begin(), vec.begin()+2, vec.end() );
+        EXPECT_EQ( vec[2], 3 );
+    }
+#endif
+
     tm.summary();
 }
@@ -5,6 +5,28 @@
 
 #include "vector_tests.h"
 void run_iterator_tests(void);
+void run_storage_tests(void);
+void run_move_semantics_tests(void);
+void run_allocator_tests(void);
+void run_small_vector_tests(void);
+void run_devector_tests(void);
+void run_vector_stats_tests(void);
+void run_simd_tests(void);
+void run_parallel_tests(void);
+void run_mmap_vector_tests(void);
+void run_serialization_tests(void);
+void run_soa_vector_tests(void);
+void run_concurrent_vector_tests(void);
+void run_stable_vector_tests(void);
+void run_shared_vector_tests(void);
+void run_vector_view_tests(void);
+void run_constexpr_tests(void);
+void run_static_vector_tests(void);
+void run_checks_tests(void);
+void run_batch_tests(void);
+void run_flat_set_tests(void);
+void run_flat_map_tests(void);
+void run_perf_tests(void);
 
 // ============================================================================
 // TESTING VECTOR AS A CONTAINER OF INTEGERS
@@ -26,5 +48,72 @@ int main( void )
     std::cout << ">>> Testing out iterator operations on vector.\n";
     run_iterator_tests();
 
-    return 1;
+    std::cout << ">>> Testing out vector storage management.\n";
+    run_storage_tests();
+
+    std::cout << ">>> Testing out move operations on vector.\n";
+    run_move_semantics_tests();
+
+    std::cout << ">>> Testing out vector with custom allocators.\n";
+    run_allocator_tests();
+
+    std::cout << ">>> Testing out small_vector.\n";
+    run_small_vector_tests();
+
+    std::cout << ">>> Testing out devector.\n";
+    run_devector_tests();
+
+    std::cout << ">>> Testing out vector_stats.\n";
+    run_vector_stats_tests();
+
+    std::cout << ">>> Testing out SIMD kernels.\n";
+    run_simd_tests();
+
+    std::cout << ">>> Testing out parallel bulk operations.\n";
+    run_parallel_tests();
+
+    std::cout << ">>> Testing out mmap_vector.\n";
+    run_mmap_vector_tests();
+
+    std::cout << ">>> Testing out binary serialization.\n";
+    run_serialization_tests();
+
+    std::cout << ">>> Testing out soa_vector.\n";
+    run_soa_vector_tests();
+
+    std::cout << ">>> Testing out concurrent_vector.\n";
+    run_concurrent_vector_tests();
+
+    std::cout << ">>> Testing out stable_vector.\n";
+    run_stable_vector_tests();
+
+    std::cout << ">>> Testing out shared_vector.\n";
+    run_shared_vector_tests();
+
+    std::cout << ">>> Testing out vector_view.\n";
+    run_vector_view_tests();
+
+    std::cout << ">>> Testing out constexpr vector.\n";
+    run_constexpr_tests();
+
+    std::cout << ">>> Testing out static_vector.\n";
+    run_static_vector_tests();
+
+    std::cout << ">>> Testing out SC_VECTOR_CHECKS modes.\n";
+    run_checks_tests();
+
+    std::cout << ">>> Testing out batch modifiers.\n";
+    run_batch_tests();
+
+    std::cout << ">>> Testing out flat_set.\n";
+    run_flat_set_tests();
+
+    std::cout << ">>> Testing out flat_map.\n";
+    run_flat_map_tests();
+
+    std::cout << ">>> Testing out timed tests.\n";
+    run_perf_tests();
+
+    // Fails when a test failed, so `run_tests` is a gate (a regressed measurement fails its test).
+    return TestManager::failures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -0,0 +1,235 @@
+#include <cstddef>
+#include <cstdint>
+#include<algorithm>
+#include<filesystem>
+#include<fstream>
+#include<iostream>
+#include<stdexcept>
+#include<string>
+#include<system_error>
+
+#include "include/tm/test_manager.h"
+#include "../include/mmap_vector.h"
+#include "main.h"
+
+// =============================================================
+// mmap_vector tests. Each one works on its own file in the
+// temporary directory, removed at the end.
+// =============================================================
+
+// Elements written through the mapping are in the file after closing, and only them.
+#define PERSISTS YES
+// Growing extends the file and remaps it without losing elements.
+#define GROWS_BY_REMAP YES
+// A read-only mapping sees the file and refuses to change it.
+#define READ_ONLY_SHARED YES
+// sync() trims the file, so a reader opening it before close() sees only the records.
+#define SYNC_TRIMS YES
+// The file is plain records, readable and writable by anyone.
+#define RAW_FILE_FORMAT YES
+// Opening errors are reported; moving hands the mapping over.
+#define ERRORS_AND_MOVES YES
+
+namespace {
+
+struct record {
+    std::uint32_t id;
+    float score;
+};
+
+/// A fresh path in the temporary directory, removed when the test ends.
+struct temp_file {
+    std::filesystem::path path;
+    explicit temp_file( const std::string& name )
+        : path{ std::filesystem::temp_directory_path() / ( "sc_mmap_vector_" + name + ".bin" ) } {
+        std::filesystem::remove( path );
+    }
+    ~temp_file() { std::filesystem::remove( path ); }
+};
+
+} // namespace.
+
+void run_mmap_vector_tests( void )
+{
+    TestManager tm{ "mmap_vector testing"};
+
+#if PERSISTS
+    {
+        BEGIN_TEST(tm, "Persists", "push_back, close, reopen");
+        temp_file file{ "persists" };
+        {
+            sc::mmap_vector<record> vec{ file.path.string() };
+            EXPECT_TRUE( vec.empty() );
+            for ( std::uint32_t i{0} ; i < 100 ; ++i )
+                vec.push_back( { i, i * 0.5f } );
+            vec.sync();
+            EXPECT_GE( vec.capacity(), 100 );
+        }
+        EXPECT_EQ( std::filesystem::file_size( file.path ), 100 * sizeof(record) );
+        sc::mmap_vector<record> vec{ file.path.string() };
+        EXPECT_EQ( vec.size(), 100 );
+        EXPECT_EQ( vec[42].id, 42u );
+        EXPECT_EQ( vec.back().score, 49.5f );
+        vec.pop_back();
+        vec.close();
+        EXPECT_EQ( std::filesystem::file_size( file.path ), 99 * sizeof(record) );
+    }
+#endif
+
+#if GROWS_BY_REMAP
+    {
+        BEGIN_TEST(tm, "GrowsByRemap", "reserve/resize/append_range extend the file");
+        temp_file file{ "grows" };
+        sc::mmap_vector<std::uint64_t> vec{ file.path.string() };
+        for ( std::uint64_t i{0} ; i < 100'000 ; ++i )
+            vec.emplace_back( i );
+        bool intact{true};
+        for ( std::uint64_t i{0} ; i < vec.size() ; ++i )
+            intact = intact && vec[i] == i;
+        EXPECT_TRUE( intact );
+        // The mapping covers whole pages, and the file the whole mapping.
+        EXPECT_EQ( std::filesystem::file_size( file.path ), vec.capacity() * sizeof(std::uint64_t) );
+
+        vec.resize( 100'010 );
+        EXPECT_EQ( vec[100'009], 0 );
+        std::uint64_t more[]{ 7, 8, 9 };
+        vec.append_range( std::begin(more), std::end(more) );
+        EXPECT_EQ( vec.size(), 100'013 );
+        EXPECT_EQ( vec.back(), 9 );
+        // An element of the vector itself, when the push reallocates.
+        vec.reserve( vec.size() );
+        vec.shrink_to_fit();
+        auto cap = vec.capacity();
+        while ( vec.size() < cap )
+            vec.push_back( 1 );
+        vec.push_back( vec[0] );
+        EXPECT_EQ( vec.back(), 0 );
+        EXPECT_EQ( std::count( vec.begin(), vec.end(), 9 ), 2 ); // 9 was there already.
+
+        // Shrinking maps the smaller file before cutting it.
+        vec.resize( 1000 );
+        vec.shrink_to_fit();
+        EXPECT_LT( vec.capacity(), 100'000 );
+        EXPECT_EQ( std::filesystem::file_size( file.path ), vec.capacity() * sizeof(std::uint64_t) );
+        EXPECT_EQ( vec[999], 999 );
+    }
+#endif
+
+#if READ_ONLY_SHARED
+    {
+        BEGIN_TEST(tm, "ReadOnlyShared", "map_mode::read_only");
+        temp_file file{ "read_only" };
+        {
+            sc::mmap_vector<int> writer{ file.path.string() };
+            for ( auto i{0} ; i < 10 ; ++i )
+                writer.push_back( i * i );
+        }
+        sc::mmap_vector<int> reader1{ file.path.string(), sc::map_mode::read_only };
+        sc::mmap_vector<int> reader2{ file.path.string(), sc::map_mode::read_only };
+        EXPECT_TRUE( reader1.read_only() );
+        EXPECT_EQ( reader1.size(), 10 );
+        EXPECT_EQ( reader2.at(9), 81 );
+        const auto& creader = reader1;
+        int sum{0};
+        for ( auto v : creader )
+            sum += v;
+        EXPECT_EQ( sum, 285 );
+
+        bool thrown{false};
+        try { reader1.push_back( 1 ); }
+        catch ( const std::logic_error& ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+        reader1.close();
+        // Closing a reader leaves the file alone.
+        EXPECT_EQ( std::filesystem::file_size( file.path ), 10 * sizeof(int) );
+    }
+#endif
+
+#if SYNC_TRIMS
+    {
+        BEGIN_TEST(tm, "SyncTrims", "read_only opens while the writer is still open");
+        temp_file file{ "sync" };
+        sc::mmap_vector<record> writer{ file.path.string() };
+        for ( std::uint32_t i{0} ; i < 10 ; ++i )
+            writer.push_back( { i, 1.0f } );
+        writer.sync();
+        EXPECT_EQ( std::filesystem::file_size( file.path ), 10 * sizeof(record) );
+        sc::mmap_vector<record> before{ file.path.string(), sc::map_mode::read_only };
+        EXPECT_EQ( before.size(), 10 );
+        EXPECT_EQ( before.back().id, 9u );
+
+        // Writing past the end again extends the file under the same mapping.
+        auto data = writer.data();
+        writer.push_back( { 10, 2.0f } );
+        record more[]{ { 11, 3.0f }, { 12, 4.0f } };
+        writer.append_range( std::begin(more), std::end(more) );
+        EXPECT_EQ( writer.data(), data );
+        writer.pop_back();
+        writer.sync();
+        sc::mmap_vector<record> after{ file.path.string(), sc::map_mode::read_only };
+        EXPECT_EQ( after.size(), 12 );
+        EXPECT_EQ( after.back().score, 3.0f );
+        EXPECT_EQ( before[9].id, 9u ); // The older mapping still reads its records.
+        writer.resize( 20 );
+        writer.sync();
+        EXPECT_EQ( std::filesystem::file_size( file.path ), 20 * sizeof(record) );
+        writer.close();
+    }
+#endif
+
+#if RAW_FILE_FORMAT
+    {
+        BEGIN_TEST(tm, "RawFileFormat", "the file is the records back to back");
+        temp_file file{ "raw" };
+        {
+            std::ofstream out{ file.path, std::ios::binary };
+            std::int32_t values[]{ 3, 1, 4, 1, 5 };
+            out.write( reinterpret_cast<const char*>( values ), sizeof(values) );
+        }
+        sc::mmap_vector<std::int32_t> vec{ file.path.string() };
+        EXPECT_EQ( vec.size(), 5 );
+        EXPECT_EQ( vec[2], 4 );
+        std::sort( vec.begin(), vec.end() );
+        vec.close();
+
+        std::ifstream in{ file.path, std::ios::binary };
+        std::int32_t values[5];
+        in.read( reinterpret_cast<char*>( values ), sizeof(values) );
+        EXPECT_EQ( values[0], 1 );
+        EXPECT_EQ( values[4], 5 );
+
+        // A size that is not a whole number of records is refused.
+        bool thrown{false};
+        try { sc::mmap_vector<record> bad{ file.path.string() }; }
+        catch ( const std::runtime_error& ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+    }
+#endif
+
+#if ERRORS_AND_MOVES
+    {
+        BEGIN_TEST(tm, "ErrorsAndMoves", "missing files, move construction/assignment");
+        temp_file file{ "moves" };
+        bool thrown{false};
+        try { sc::mmap_vector<int> missing{ file.path.string(), sc::map_mode::read_only }; }
+        catch ( const std::system_error& e ) { thrown = e.code() == std::errc::no_such_file_or_directory; }
+        EXPECT_TRUE( thrown );
+
+        sc::mmap_vector<int> vec{ file.path.string() };
+        vec.push_back( 1 );
+        auto data = vec.data();
+        sc::mmap_vector<int> moved{ std::move(vec) };
+        EXPECT_EQ( moved.data(), data );
+        EXPECT_EQ( moved.size(), 1 );
+        EXPECT_TRUE( vec.empty() );
+        moved.push_back( 2 );
+        vec = std::move( moved );
+        EXPECT_EQ( vec.size(), 2 );
+        vec.close();
+        EXPECT_EQ( std::filesystem::file_size( file.path ), 2 * sizeof(int) );
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
@@ -19,6 +19,10 @@
 #define EMPLACE_BACK_INT YES
 // Emplace back operator.
 #define EMPLACE_BACK_STRING YES
+// Emplace at an arbitrary position.
+#define EMPLACE_POS YES
+// Emplace front operator.
+#define EMPLACE_FRONT YES
 
 
 void run_move_semantics_tests( void )
@@ -132,6 +136,44 @@ void run_move_semantics_tests( void )
             EXPECT_EQ( values_s[i], vec[i] );
     }
 #endif
+#if EMPLACE_POS
+    {
+        BEGIN_TEST(tm, "Emplace at position", "vec.emplace(pos, args...)");
+        which_lib::vector<std::string> vec{ "a", "b", "c" };
+
+        // Builds the string from (count, char) directly in the vector.
+        auto it = vec.emplace( vec.begin()+1, 3, 'x' );
+        EXPECT_EQ( *it, "xxx" );
+        it = vec.emplace( vec.end(), 2, 'y' );
+        EXPECT_EQ( *it, "yy" );
+        it = vec.emplace( vec.begin(), "z" );
+        EXPECT_EQ( *it, "z" );
+        EXPECT_EQ( vec, ( which_lib::vector<std::string>{ "z", "a", "xxx", "b", "c", "yy" } ) );
+
+        // The argument may refer to an element of the vector itself.
+        vec.emplace( vec.begin(), vec[5] );
+        EXPECT_EQ( vec[0], "yy" );
+        EXPECT_EQ( vec.size(), 7 );
+    }
+#endif
+
+#if EMPLACE_FRONT
+    {
+        BEGIN_TEST(tm, "Emplace front", "vec.emplace_front(args...)");
+        which_lib::vector<std::string> vec;
+
+        for ( auto i{1} ; i <= 20 ; ++i )
+            vec.emplace_front( i, 'a' );
+        EXPECT_EQ( vec.size(), 20 );
+        EXPECT_EQ( vec.front(), std::string( 20, 'a' ) );
+        EXPECT_EQ( vec.back(), "a" );
+
+        auto& ref = vec.emplace_front( "front" );
+        EXPECT_EQ( ref, "front" );
+        EXPECT_EQ( vec[0], "front" );
+    }
+#endif
+
     tm.summary();
     std::cout << "\n\n";
 }
@@ -0,0 +1,193 @@
+#include <cstddef>
+#include<atomic>
+#include<iostream>
+#include<stdexcept>
+#include<string>
+
+#include "include/tm/test_manager.h"
+#include "../include/vector.h"
+#include "main.h"
+
+// =============================================================
+// Parallel bulk operations. Most tests use a policy with no threshold,
+// so even small vectors are split across threads.
+// =============================================================
+
+// parallel_copy_from() copies every element, into the same or a new buffer.
+#define PARALLEL_COPY_FROM YES
+// assign(par, ...) with a range and with count copies of a value.
+#define PARALLEL_ASSIGN YES
+// for_each(par, f) and transform(par, f) visit every element exactly once.
+#define PARALLEL_FOR_EACH YES
+// sc::equal(par, a, b) agrees with a == b.
+#define PARALLEL_EQUAL YES
+// A copy that throws leaves no element behind.
+#define PARALLEL_EXCEPTIONS YES
+// Chunk bounds cover [0, n) exactly; small inputs stay serial.
+#define PARALLEL_CHUNKS YES
+
+namespace {
+
+/// Four threads, however short the vector.
+const sc::parallel_policy four_threads{ 0, 1, 4 };
+
+/// Counts the live objects from any thread; the copy of `poison` throws.
+struct Fragile {
+    static std::atomic<int> alive;
+    static int poison;
+    int m_value;
+
+    Fragile( int v = 0 ) : m_value{v} { ++alive; }
+    Fragile( const Fragile& other ) : m_value{other.m_value} {
+        if ( m_value == poison ) throw std::runtime_error{ "poisoned copy" };
+        ++alive;
+    }
+    Fragile& operator=( const Fragile& other ) = default;
+    ~Fragile() { --alive; }
+};
+std::atomic<int> Fragile::alive{0};
+int Fragile::poison{-1};
+
+} // namespace.
+
+void run_parallel_tests( void )
+{
+    TestManager tm{ "Parallel testing"};
+
+#if PARALLEL_COPY_FROM
+    {
+        BEGIN_TEST(tm, "ParallelCopyFrom", "vec.parallel_copy_from(other)");
+        sc::vector<int> src( 100'001 );
+        for ( auto i{0u} ; i < src.size() ; ++i )
+            src[i] = static_cast<int>( i );
+        sc::vector<int> dst{ 1, 2, 3 };
+        dst.parallel_copy_from( src, four_threads );
+        EXPECT_EQ( dst, src );
+
+        // Reusing the buffer it already has.
+        auto data = dst.data();
+        src[50'000] = -1;
+        dst.parallel_copy_from( src, four_threads );
+        EXPECT_EQ( dst.data(), data );
+        EXPECT_EQ( dst[50'000], -1 );
+        dst.parallel_copy_from( dst, four_threads );
+        EXPECT_EQ( dst.size(), 100'001 );
+
+        sc::vector<std::string> words;
+        for ( auto i{0} ; i < 1000 ; ++i )
+            words.push_back( "word number " + std::to_string(i) );
+        sc::vector<std::string> copy;
+        copy.parallel_copy_from( words, four_threads );
+        EXPECT_EQ( copy, words );
+        // The default policy keeps such a short vector serial, with the same result.
+        sc::vector<std::string> serial;
+        serial.parallel_copy_from( words );
+        EXPECT_EQ( serial, words );
+    }
+#endif
+
+#if PARALLEL_ASSIGN
+    {
+        BEGIN_TEST(tm, "ParallelAssign", "vec.assign(par, first, last) and vec.assign(par, count, value)");
+        std::string raw[]{ "a", "b", "c", "d", "e", "f", "g" };
+        sc::vector<std::string> vec;
+        vec.assign( four_threads, std::begin(raw), std::end(raw) );
+        EXPECT_EQ( vec, ( sc::vector<std::string>{ "a", "b", "c", "d", "e", "f", "g" } ) );
+        vec.assign( four_threads, vec.size(), vec[1] );
+        EXPECT_EQ( vec, ( sc::vector<std::string>{ "b", "b", "b", "b", "b", "b", "b" } ) );
+
+        sc::vector<double> dvec;
+        dvec.assign( four_threads, 12'345, 0.5 );
+        EXPECT_EQ( dvec.size(), 12'345 );
+        EXPECT_EQ( dvec.count( 0.5 ), 12'345 );
+        dvec.assign( sc::par, 3, 1.5 );
+        EXPECT_EQ( dvec, ( sc::vector<double>{ 1.5, 1.5, 1.5 } ) );
+    }
+#endif
+
+#if PARALLEL_FOR_EACH
+    {
+        BEGIN_TEST(tm, "ParallelForEach", "vec.for_each(par, f) and vec.transform(par, f)");
+        sc::vector<long> vec( 10'000 );
+        for ( auto i{0u} ; i < vec.size() ; ++i )
+            vec[i] = i;
+        std::atomic<long> sum{0};
+        const auto& cvec = vec;
+        cvec.for_each( four_threads, [&]( long v ){ sum += v; } );
+        EXPECT_EQ( sum.load(), 10'000L * 9'999 / 2 );
+
+        vec.for_each( four_threads, []( long& v ){ v *= 2; } );
+        vec.transform( four_threads, []( long v ){ return v + 1; } );
+        bool all_odd{true};
+        for ( auto i{0u} ; i < vec.size() ; ++i )
+            all_odd = all_odd && vec[i] == 2 * static_cast<long>(i) + 1;
+        EXPECT_TRUE( all_odd );
+    }
+#endif
+
+#if PARALLEL_EQUAL
+    {
+        BEGIN_TEST(tm, "ParallelEqual", "sc::equal(par, a, b)");
+        sc::vector<int> a( 50'000 ), b( 50'000 );
+        EXPECT_TRUE( sc::equal( four_threads, a, b ) );
+        b[49'999] = 1;
+        EXPECT_FALSE( sc::equal( four_threads, a, b ) );
+        b[49'999] = 0;
+        b[0] = 1;
+        EXPECT_FALSE( sc::equal( four_threads, a, b ) );
+        EXPECT_FALSE( sc::equal( four_threads, a, sc::vector<int>( 3 ) ) );
+        EXPECT_TRUE( sc::equal( sc::par, sc::vector<int>{}, sc::vector<int>{} ) );
+    }
+#endif
+
+#if PARALLEL_EXCEPTIONS
+    {
+        BEGIN_TEST(tm, "ParallelExceptions", "a throwing copy destroys what the other threads built");
+        {
+            sc::vector<Fragile> src;
+            for ( auto i{0} ; i < 1000 ; ++i )
+                src.emplace_back( i );
+            sc::vector<Fragile> dst;
+            dst.emplace_back( 7 );
+            Fragile::poison = 600;
+            bool thrown{false};
+            try { dst.parallel_copy_from( src, four_threads ); }
+            catch ( const std::runtime_error& ) { thrown = true; }
+            EXPECT_TRUE( thrown );
+            // A new buffer was needed, so the old content survives.
+            EXPECT_EQ( dst.size(), 1 );
+            EXPECT_EQ( Fragile::alive.load(), 1001 );
+
+            dst.reserve( 2000 );
+            thrown = false;
+            try { dst.parallel_copy_from( src, four_threads ); }
+            catch ( const std::runtime_error& ) { thrown = true; }
+            EXPECT_TRUE( thrown );
+            // Rebuilt in place: left empty.
+            EXPECT_TRUE( dst.empty() );
+            EXPECT_EQ( Fragile::alive.load(), 1000 );
+            Fragile::poison = -1;
+        }
+        EXPECT_EQ( Fragile::alive.load(), 0 );
+    }
+#endif
+
+#if PARALLEL_CHUNKS
+    {
+        BEGIN_TEST(tm, "ParallelChunks", "chunk bounds and the serial threshold");
+        EXPECT_EQ( sc::detail::parallel_chunks( 100, sc::par ), 1 );
+        EXPECT_EQ( sc::detail::parallel_chunks( 100, four_threads ), 4 );
+        EXPECT_EQ( sc::detail::parallel_chunks( 3, four_threads ), 3 );
+        EXPECT_EQ( sc::detail::parallel_chunks( 100, sc::parallel_policy{ 0, 40, 4 } ), 2 );
+        // 10 elements in 4 chunks: 3, 3, 2, 2.
+        EXPECT_EQ( sc::detail::chunk_begin( 10, 4, 0 ), 0 );
+        EXPECT_EQ( sc::detail::chunk_begin( 10, 4, 1 ), 3 );
+        EXPECT_EQ( sc::detail::chunk_begin( 10, 4, 2 ), 6 );
+        EXPECT_EQ( sc::detail::chunk_begin( 10, 4, 3 ), 8 );
+        EXPECT_EQ( sc::detail::chunk_begin( 10, 4, 4 ), 10 );
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
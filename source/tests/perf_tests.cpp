@@ -0,0 +1,107 @@
+#include <cstddef>
+#include<algorithm>
+#include<iostream>
+#include<string>
+#include<vector>
+
+#include "include/tm/test_manager.h"
+#include "../include/vector.h"
+#include "../include/flat_set.h"
+#include "../include/static_vector.h"
+#include "main.h"
+
+// =============================================================
+// timed tests: what the fast paths cost, in time and
+// allocations, against the slow way of doing the same thing.
+// Run by `run_tests` against the baseline `record_baseline`
+// keeps (see include/tm/test_manager.h).
+// =============================================================
+
+// A flat_set lookup against a linear scan of the same keys.
+#define FLAT_SET_LOOKUP YES
+// insert_sorted_batch against one insert per value.
+#define BATCH_INSERT YES
+// reserve + push_back allocates once; growing allocates log(n) times.
+#define RESERVE_ALLOCATIONS YES
+// A static_vector never goes to the heap.
+#define STATIC_VECTOR_NO_HEAP YES
+
+void run_perf_tests( void )
+{
+    TestManager tm{ "timed testing"};
+
+#if FLAT_SET_LOOKUP
+    {
+        BEGIN_BENCH(tm, "FlatSetLookup", "binary search beats a scan of 4096 keys, without allocating");
+        sc::vector<int> keys;
+        for ( int i{0} ; i < 4096 ; ++i ) keys.push_back( 3 * i );
+        sc::flat_set<int> set{ keys.begin(), keys.end() };
+        std::size_t hits{0};
+        int key{0};
+        auto flat = MEASURE( "contains", 50, for ( int i{0} ; i < 64 ; ++i ) hits += set.contains( key = ( key + 97 ) % 12288 ) );
+        auto scan = MEASURE( "find", 50, for ( int i{0} ; i < 64 ; ++i ) hits += keys.find( key = ( key + 97 ) % 12288 ) != keys.end() );
+        TestManager::do_not_optimize( hits );
+        EXPECT_FASTER_THAN( flat, scan );
+        EXPECT_ALLOCS_LE( flat, 0 );
+        EXPECT_TRUE( ( flat.ns > 0 ) );
+        EXPECT_TRUE( ( flat.cycles == -1 or flat.cycles > 0 ) ); // Counters may be off limits.
+    }
+#endif
+
+#if BATCH_INSERT
+    {
+        BEGIN_BENCH(tm, "BatchInsert", "200 values inserted in one pass, not 200 shifts of the tail");
+        sc::vector<int> base;
+        for ( int i{0} ; i < 20000 ; ++i ) base.push_back( i );
+        std::vector<int> positions;
+        std::vector<int> values;
+        for ( int i{0} ; i < 200 ; ++i ) {
+            positions.push_back( i * 100 );
+            values.push_back( -i );
+        }
+        auto batch = MEASURE( "insert_sorted_batch", 5,
+            auto vec = base;
+            vec.insert_sorted_batch( positions, values );
+            TestManager::do_not_optimize( vec.data() ) );
+        auto single = MEASURE( "insert", 5,
+            auto vec = base;
+            for ( auto j{values.size()} ; j-- > 0 ; )
+                vec.insert( vec.begin() + positions[j], values[j] );
+            TestManager::do_not_optimize( vec.data() ) );
+        EXPECT_FASTER_THAN( batch, single );
+        EXPECT_ALLOCS_LE( batch, 2 ); // The copy and one growth.
+    }
+#endif
+
+#if RESERVE_ALLOCATIONS
+    {
+        BEGIN_BENCH(tm, "ReserveAllocations", "one allocation after reserve, several while growing");
+        auto reserved = MEASURE( "reserve", 20,
+            sc::vector<std::size_t> vec;
+            vec.reserve( 1000 );
+            for ( std::size_t i{0} ; i < 1000 ; ++i ) vec.push_back( i );
+            TestManager::do_not_optimize( vec.data() ) );
+        auto grown = MEASURE( "grow", 20,
+            sc::vector<std::size_t> vec;
+            for ( std::size_t i{0} ; i < 1000 ; ++i ) vec.push_back( i );
+            TestManager::do_not_optimize( vec.data() ) );
+        EXPECT_ALLOCS_LE( reserved, 1 );
+        EXPECT_TRUE( ( grown.allocs > reserved.allocs ) );
+    }
+#endif
+
+#if STATIC_VECTOR_NO_HEAP
+    {
+        BEGIN_BENCH(tm, "StaticVectorNoHeap", "filling and emptying a static_vector allocates nothing");
+        auto fill = MEASURE( "fill", 100,
+            sc::static_vector<int, 64> vec;
+            while ( vec.try_push_back( int( vec.size() ) ) != nullptr ) { /* empty */ }
+            vec.erase( vec.begin(), vec.begin() + 32 );
+            TestManager::do_not_optimize( vec.data() ) );
+        EXPECT_ALLOCS_LE( fill, 0 );
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
@@ -0,0 +1,219 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include<iostream>
+#include<sstream>
+#include<streambuf>
+#include<string>
+#include<utility>
+
+#include "include/tm/test_manager.h"
+#include "../include/vector.h"
+#include "main.h"
+
+// =============================================================
+// Binary serialization: write_to/read_from round trips, the header,
+// and streams that do not hold what the reader expects.
+// =============================================================
+
+// Trivially copyable elements survive a round trip.
+#define ROUND_TRIP_RAW YES
+// Strings are length-prefixed and survive a round trip.
+#define ROUND_TRIP_STRINGS YES
+// The header is 20 bytes and the raw payload is the buffer as it is.
+#define HEADER_LAYOUT YES
+// Wrong magic, element type, byte order or a truncated stream are reported.
+#define BAD_STREAMS YES
+// A count or string length larger than the data throws, seekable stream or not.
+#define OVERSIZED_COUNTS YES
+// as_bytes() covers exactly the live elements.
+#define BYTE_VIEW YES
+
+namespace {
+
+struct sample {
+    std::int32_t id;
+    double value;
+};
+
+/// Serializes `vec` into a string.
+template <typename V>
+std::string serialized( const V& vec ) {
+    std::ostringstream os{ std::ios::binary };
+    vec.write_to( os );
+    return os.str();
+}
+
+/// Replaces the 8 bytes at `offset` of `bytes` with `value`, little endian.
+std::string patched( std::string bytes, std::size_t offset, std::uint64_t value ) {
+    for ( std::size_t i{0} ; i < 8 ; ++i )
+        bytes[offset + i] = static_cast<char>( value >> ( 8 * i ) );
+    return bytes;
+}
+
+/// A stream buffer over a string that cannot seek, like a pipe or a socket.
+struct pipe_buffer : std::streambuf {
+    std::string m_bytes;
+    explicit pipe_buffer( std::string bytes ) : m_bytes{ std::move( bytes ) } {
+        setg( m_bytes.data(), m_bytes.data(), m_bytes.data() + m_bytes.size() );
+    }
+};
+
+} // namespace.
+
+void run_serialization_tests( void )
+{
+    TestManager tm{ "serialization testing"};
+
+#if ROUND_TRIP_RAW
+    {
+        BEGIN_TEST(tm, "RoundTripRaw", "write_to/read_from with int and a struct");
+        sc::vector<int> ints;
+        for ( auto i{0} ; i < 1000 ; ++i )
+            ints.push_back( i * 3 );
+        std::istringstream is{ serialized( ints ), std::ios::binary };
+        sc::vector<int> back{ 1, 2, 3 };
+        back.read_from( is );
+        EXPECT_EQ( back, ints );
+
+        sc::vector<sample> samples{ { 1, 0.5 }, { 2, -1.25 } };
+        std::istringstream sis{ serialized( samples ), std::ios::binary };
+        sc::vector<sample> sback;
+        sback.read_from( sis );
+        EXPECT_EQ( sback.size(), 2 );
+        EXPECT_EQ( sback[1].id, 2 );
+        EXPECT_EQ( sback[1].value, -1.25 );
+
+        // Several vectors one after the other in the same stream.
+        std::stringstream both{ std::ios::in | std::ios::out | std::ios::binary };
+        ints.write_to( both );
+        sc::vector<int>{}.write_to( both );
+        sc::vector<int> first, second{ 7 };
+        first.read_from( both );
+        second.read_from( both );
+        EXPECT_EQ( first.size(), 1000 );
+        EXPECT_TRUE( second.empty() );
+    }
+#endif
+
+#if ROUND_TRIP_STRINGS
+    {
+        BEGIN_TEST(tm, "RoundTripStrings", "length-prefixed std::string and std::u16string");
+        sc::vector<std::string> words{ "", "a", std::string( 1000, 'x' ), std::string( "nul\0inside", 10 ) };
+        std::istringstream is{ serialized( words ), std::ios::binary };
+        sc::vector<std::string> back;
+        back.read_from( is );
+        EXPECT_EQ( back, words );
+        EXPECT_EQ( back[3].size(), 10 );
+
+        sc::vector<std::u16string> wide{ u"café", u"" };
+        std::istringstream wis{ serialized( wide ), std::ios::binary };
+        sc::vector<std::u16string> wback;
+        wback.read_from( wis );
+        EXPECT_TRUE( ( wback == wide ) );
+    }
+#endif
+
+#if HEADER_LAYOUT
+    {
+        BEGIN_TEST(tm, "HeaderLayout", "magic, version, byte order, layout, element size, count");
+        sc::vector<std::uint16_t> vec{ 0x0102, 0x0304, 0x0506 };
+        vec.reserve( 100 );
+        auto bytes = serialized( vec );
+        // The spare capacity is not written.
+        EXPECT_EQ( bytes.size(), 20 + 3 * sizeof(std::uint16_t) );
+        EXPECT_EQ( bytes.substr( 0, 4 ), "SCVB" );
+        EXPECT_EQ( bytes[4], 1 );   // Version, little endian.
+        EXPECT_EQ( bytes[5], 0 );
+        EXPECT_EQ( bytes[7], 0 );   // Raw layout.
+        EXPECT_EQ( bytes[8], 2 );   // sizeof(std::uint16_t).
+        EXPECT_EQ( bytes[12], 3 );  // Count.
+        std::uint16_t first;
+        std::memcpy( &first, bytes.data() + 20, sizeof(first) );
+        EXPECT_EQ( first, 0x0102 );
+        EXPECT_EQ( serialized( sc::vector<std::string>{ "ab" } ).size(), 20 + 8 + 2 );
+    }
+#endif
+
+#if BAD_STREAMS
+    {
+        BEGIN_TEST(tm, "BadStreams", "sc::serialization_error; the vector is unchanged or empty");
+        // Size of the vector after the error, or -1 when nothing was thrown.
+        auto size_after_error = []( const std::string& bytes, auto vec ) {
+            std::istringstream is{ bytes, std::ios::binary };
+            try { vec.read_from( is ); }
+            catch ( const sc::serialization_error& ) { return static_cast<long>( vec.size() ); }
+            return -1L;
+        };
+        auto ints = serialized( sc::vector<int>{ 1, 2, 3 } );
+        // A bad header leaves the vector alone.
+        EXPECT_EQ( size_after_error( "", sc::vector<int>{ 9 } ), 1 );
+        EXPECT_EQ( size_after_error( "not a vector at all, really", sc::vector<int>{ 9 } ), 1 );
+        EXPECT_EQ( size_after_error( ints, sc::vector<double>{ 9 } ), 1 );
+        EXPECT_EQ( size_after_error( ints, sc::vector<std::string>{ "9" } ), 1 );
+        auto swapped = ints;
+        swapped[6] = swapped[6] == 1 ? 2 : 1;  // Another byte order.
+        EXPECT_EQ( size_after_error( swapped, sc::vector<int>{ 9 } ), 1 );
+        // A payload cut short leaves it empty.
+        EXPECT_EQ( size_after_error( ints.substr( 0, ints.size() - 1 ), sc::vector<int>{ 9 } ), 0 );
+        auto words = serialized( sc::vector<std::string>{ "hello", "world" } );
+        EXPECT_EQ( size_after_error( words.substr( 0, words.size() - 2 ), sc::vector<std::string>{ "9" } ), 0 );
+    }
+#endif
+
+#if OVERSIZED_COUNTS
+    {
+        BEGIN_TEST(tm, "OversizedCounts", "counts are checked against the stream, or read in chunks");
+        // Size of the vector after the error, or -1 when nothing was thrown.
+        auto size_after_error = []( const std::string& bytes, auto vec, bool seekable ) {
+            pipe_buffer pipe{ bytes };
+            std::istringstream file{ bytes, std::ios::binary };
+            std::istream piped{ &pipe };
+            try { vec.read_from( seekable ? static_cast<std::istream&>( file ) : piped ); }
+            catch ( const sc::serialization_error& ) { return static_cast<long>( vec.size() ); }
+            return -1L;
+        };
+        auto ints = serialized( sc::vector<int>{ 1, 2, 3 } );
+        auto words = serialized( sc::vector<std::string>{ "hello", "world" } );
+        for ( bool seekable : { true, false } ) {
+            // Counts no stream could back: each throws rather than allocating that much.
+            EXPECT_EQ( size_after_error( patched( ints, 12, std::uint64_t{1} << 60 ), sc::vector<int>{ 9 }, seekable ), 0 );
+            EXPECT_EQ( size_after_error( patched( ints, 12, 4 ), sc::vector<int>{ 9 }, seekable ), 0 );
+            EXPECT_EQ( size_after_error( patched( words, 12, std::uint64_t{1} << 40 ), sc::vector<std::string>{}, seekable ), 0 );
+            EXPECT_EQ( size_after_error( patched( words, 20, std::uint64_t{1} << 50 ), sc::vector<std::string>{}, seekable ), 0 );
+            EXPECT_EQ( size_after_error( ints, sc::vector<int>{}, seekable ), -1 );
+        }
+        // Without seeking, a payload of several chunks still comes back whole.
+        sc::vector<std::uint32_t> big( 600'000 );
+        for ( std::uint32_t i{0} ; i < big.size() ; ++i ) big[i] = i * 7;
+        sc::vector<std::string> texts{ std::string( 3'000'000, 'x' ), "", "y" };
+        pipe_buffer big_pipe{ serialized( big ) + serialized( texts ) };
+        std::istream piped{ &big_pipe };
+        sc::vector<std::uint32_t> big_back;
+        big_back.read_from( piped );
+        sc::vector<std::string> texts_back;
+        texts_back.read_from( piped );
+        EXPECT_EQ( big_back, big );
+        EXPECT_EQ( texts_back, texts );
+    }
+#endif
+
+#if BYTE_VIEW
+    {
+        BEGIN_TEST(tm, "ByteView", "vec.as_bytes()");
+        sc::vector<std::uint32_t> vec{ 1, 2, 3 };
+        vec.reserve( 50 );
+        auto view = vec.as_bytes();
+        EXPECT_EQ( view.size(), 3 * sizeof(std::uint32_t) );
+        EXPECT_EQ( static_cast<const void*>( view.data() ), static_cast<const void*>( vec.data() ) );
+        std::size_t sum{0};
+        for ( auto b : view )
+            sum += std::to_integer<std::size_t>( b );
+        EXPECT_EQ( sum, 6 );
+        EXPECT_TRUE( sc::vector<int>{}.as_bytes().empty() );
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
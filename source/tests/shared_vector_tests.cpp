@@ -0,0 +1,182 @@
+#include <cstddef>
+#include<iostream>
+#include<numeric>
+#include<stdexcept>
+#include<string>
+#include<thread>
+#include<vector>
+
+#include "include/tm/test_manager.h"
+#include "../include/shared_vector.h"
+#include "main.h"
+
+// =============================================================
+// shared_vector tests: copies share one buffer, and the first
+// change through a copy gives it a buffer of its own.
+// =============================================================
+
+// Copies and assignments share the buffer and count the owners.
+#define SHARED_COPIES YES
+// Modifying a shared copy copies the elements once; the others do not see the change.
+#define COPY_ON_WRITE YES
+// A sole owner is changed in place; clear() never copies.
+#define IN_PLACE YES
+// Element access, iteration, ==, and conversions to and from sc::vector.
+#define READ_ACCESS YES
+// Copies used from several threads at once.
+#define THREADS YES
+
+void run_shared_vector_tests( void )
+{
+    TestManager tm{ "shared_vector testing"};
+
+#if SHARED_COPIES
+    {
+        BEGIN_TEST(tm, "SharedCopies", "copy construction/assignment are O(1)");
+        sc::shared_vector<std::string> table{ "alpha", "beta", "gamma" };
+        EXPECT_EQ( table.use_count(), 1 );
+        auto copy = table;
+        EXPECT_TRUE( copy.shares_with( table ) );
+        EXPECT_EQ( copy.data(), table.data() );
+        EXPECT_EQ( table.use_count(), 2 );
+        sc::shared_vector<std::string> assigned;
+        EXPECT_EQ( assigned.use_count(), 0 );
+        assigned = copy;
+        EXPECT_EQ( table.use_count(), 3 );
+        {
+            auto scoped = assigned;
+            EXPECT_EQ( table.use_count(), 4 );
+        }
+        EXPECT_EQ( table.use_count(), 3 );
+        auto moved = std::move( assigned );
+        EXPECT_EQ( table.use_count(), 3 );
+        EXPECT_TRUE( assigned.empty() );
+        EXPECT_FALSE( assigned.shares_with( sc::shared_vector<std::string>{} ) );
+    }
+#endif
+
+#if COPY_ON_WRITE
+    {
+        BEGIN_TEST(tm, "CopyOnWrite", "push_back, set, edit, resize on a shared buffer");
+        sc::shared_vector<int> original{ 1, 2, 3 };
+        auto copy = original;
+        const int* shared = original.data();
+        copy.push_back( 4 );
+        EXPECT_FALSE( copy.shares_with( original ) );
+        EXPECT_EQ( original.data(), shared );
+        EXPECT_EQ( original.size(), 3 );
+        EXPECT_EQ( copy.size(), 4 );
+        EXPECT_EQ( original.use_count(), 1 );
+        EXPECT_EQ( copy.use_count(), 1 );
+
+        auto second = original;
+        second.set( 0, 100 );
+        EXPECT_EQ( original[0], 1 );
+        EXPECT_EQ( second[0], 100 );
+        auto third = original;
+        third.edit().insert( third.edit().begin(), 0 );
+        EXPECT_EQ( third.size(), 4 );
+        EXPECT_EQ( original.size(), 3 );
+        auto fourth = original;
+        fourth.resize( 10 );
+        fourth.pop_back();
+        EXPECT_EQ( fourth.size(), 9 );
+        EXPECT_EQ( original.size(), 3 );
+
+        // An element of the shared buffer itself.
+        auto fifth = original;
+        fifth.push_back( fifth[2] );
+        fifth.set( 0, fifth[1] );
+        EXPECT_EQ( fifth.back(), 3 );
+        EXPECT_EQ( fifth.front(), 2 );
+        bool thrown{false};
+        try { fifth.set( 4, 0 ); }
+        catch ( const std::out_of_range& ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+    }
+#endif
+
+#if IN_PLACE
+    {
+        BEGIN_TEST(tm, "InPlace", "a buffer used once is modified in place; clear() drops a share");
+        sc::shared_vector<int> vec;
+        vec.reserve( 100 );
+        const int* buffer = vec.data();
+        for ( auto i{0} ; i < 100 ; ++i )
+            vec.push_back( i );
+        EXPECT_EQ( vec.data(), buffer );
+        vec.set( 5, -5 );
+        EXPECT_EQ( vec.data(), buffer );
+
+        auto copy = vec;
+        copy.clear();
+        EXPECT_TRUE( copy.empty() );
+        EXPECT_EQ( copy.use_count(), 0 );
+        EXPECT_EQ( vec.use_count(), 1 );
+        EXPECT_EQ( vec.size(), 100 );
+        vec.clear();
+        EXPECT_EQ( vec.data(), buffer );
+        EXPECT_EQ( vec.capacity(), 100 );
+    }
+#endif
+
+#if READ_ACCESS
+    {
+        BEGIN_TEST(tm, "ReadAccess", "[], at, iterators, ==, to_vector, adopting an sc::vector");
+        sc::vector<int> source{ 4, 5, 6 };
+        const int* storage = &source[0];
+        sc::shared_vector<int> vec{ std::move( source ) };
+        EXPECT_EQ( vec.data(), storage );
+        EXPECT_EQ( std::accumulate( vec.begin(), vec.end(), 0 ), 15 );
+        EXPECT_EQ( vec.at(2), 6 );
+        bool thrown{false};
+        try { vec.at( 3 ); }
+        catch ( const std::out_of_range& ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+
+        sc::shared_vector<int> same{ 4, 5, 6 };
+        EXPECT_TRUE( ( vec == same ) );
+        EXPECT_FALSE( vec.shares_with( same ) );
+        same.set( 0, 0 );
+        EXPECT_TRUE( ( vec != same ) );
+        EXPECT_TRUE( ( sc::shared_vector<int>{} == sc::shared_vector<int>( sc::vector<int>{} ) ) );
+        auto plain = vec.to_vector();
+        EXPECT_EQ( plain, ( sc::vector<int>{ 4, 5, 6 } ) );
+        int list[]{ 1, 2 };
+        sc::shared_vector<int> ranged( std::begin(list), std::end(list) );
+        EXPECT_EQ( ranged.size(), 2 );
+        EXPECT_EQ( sc::shared_vector<int>{}.data(), nullptr );
+    }
+#endif
+
+#if THREADS
+    {
+        BEGIN_TEST(tm, "Threads", "readers and a writer on copies of one buffer");
+        sc::vector<long> items;
+        for ( long i{0} ; i < 10'000 ; ++i )
+            items.push_back( i );
+        sc::shared_vector<long> table{ std::move( items ) };
+        std::vector<long> sums( 4 );
+        std::vector<std::thread> threads;
+        for ( std::size_t t{0} ; t < 4 ; ++t )
+            threads.emplace_back( [table, t, &sums]() mutable {
+                for ( auto round{0} ; round < 50 ; ++round ) {
+                    auto local = table; // A per-request copy: no element is copied.
+                    sums[t] = std::accumulate( local.begin(), local.end(), 0L );
+                }
+                if ( t == 0 ) table.set( 0, -1 ); // Only this copy changes.
+            } );
+        for ( auto& th : threads )
+            th.join();
+        bool all{true};
+        for ( auto s : sums )
+            all = all && s == 49'995'000;
+        EXPECT_TRUE( all );
+        EXPECT_EQ( table[0], 0 );
+        EXPECT_EQ( table.use_count(), 1 );
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
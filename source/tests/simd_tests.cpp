@@ -0,0 +1,180 @@
+#include <cstddef>
+#include <cstdint>
+#include<algorithm>
+#include<iostream>
+#include<limits>
+#include<string>
+
+#include "include/tm/test_manager.h"
+#include "../include/vector.h"
+#include "../include/vector_simd.h"
+#include "main.h"
+
+// =============================================================
+// SIMD kernel tests: every result must match the scalar algorithm,
+// whatever the length, the type and where the values sit.
+// =============================================================
+
+// operator== finds a difference in any lane and in the scalar tail.
+#define SIMD_EQUAL YES
+// Floating point keeps the semantics of ==: NaN differs from itself, -0.0 equals 0.0.
+#define SIMD_EQUAL_FLOAT YES
+// find/contains return the first match.
+#define SIMD_FIND YES
+// count gets the right total, even past the range of narrow lane counters.
+#define SIMD_COUNT YES
+// fill/assign(count, value) write every element.
+#define SIMD_FILL YES
+// Non-arithmetic elements take the scalar path.
+#define SIMD_FALLBACK YES
+
+/// Checks a, b and every single-element difference between them, for a few lengths.
+template <typename T>
+bool equal_everywhere(void) {
+    for ( std::size_t n : { 0, 1, 3, 15, 16, 17, 31, 64, 100, 257 } )
+    {
+        sc::vector<T> a( n ), b( n );
+        for ( std::size_t i{0} ; i < n ; ++i )
+            a[i] = b[i] = static_cast<T>( i % 100 );
+        if ( !( a == b ) ) return false;
+        for ( std::size_t i{0} ; i < n ; ++i )
+        {
+            b[i] = static_cast<T>( 101 );
+            if ( a == b || !( a != b ) ) return false;
+            b[i] = a[i];
+        }
+    }
+    return true;
+}
+
+/// Checks find/count against std::find/std::count.
+template <typename T>
+bool scan_like_std(void) {
+    for ( std::size_t n : { 0, 1, 7, 16, 33, 100, 1000 } )
+    {
+        sc::vector<T> vec( n );
+        for ( std::size_t i{0} ; i < n ; ++i )
+            vec[i] = static_cast<T>( i % 7 );
+        for ( int v : { 0, 3, 6, 9 } )
+        {
+            auto value = static_cast<T>( v );
+            if ( vec.find( value ) != std::find( vec.begin(), vec.end(), value ) ) return false;
+            if ( vec.count( value ) != static_cast<std::size_t>( std::count( vec.begin(), vec.end(), value ) ) ) return false;
+            if ( vec.contains( value ) != ( std::find( vec.begin(), vec.end(), value ) != vec.end() ) ) return false;
+        }
+    }
+    return true;
+}
+
+void run_simd_tests( void )
+{
+    TestManager tm{ "SIMD testing"};
+    std::cout << "Kernels run with: " << sc::simd::active_isa() << "\n";
+
+#if SIMD_EQUAL
+    {
+        BEGIN_TEST(tm, "SimdEqual", "vec1 == vec2, differences in every position");
+        EXPECT_TRUE( equal_everywhere<std::int8_t>() );
+        EXPECT_TRUE( equal_everywhere<std::uint16_t>() );
+        EXPECT_TRUE( equal_everywhere<int>() );
+        EXPECT_TRUE( equal_everywhere<std::int64_t>() );
+        EXPECT_TRUE( equal_everywhere<float>() );
+        EXPECT_TRUE( equal_everywhere<double>() );
+        EXPECT_FALSE( ( sc::vector<int>{ 1, 2 } == sc::vector<int>{ 1, 2, 3 } ) );
+    }
+#endif
+
+#if SIMD_EQUAL_FLOAT
+    {
+        BEGIN_TEST(tm, "SimdEqualFloat", "NaN and signed zeros");
+        sc::vector<float> a, b;
+        a.assign( 40, 1.0f );
+        b.assign( 40, 1.0f );
+        a[20] = b[20] = std::numeric_limits<float>::quiet_NaN();
+        EXPECT_TRUE( ( a != b ) );
+        a[20] = 0.0f;
+        b[20] = -0.0f;
+        EXPECT_TRUE( ( a == b ) );
+        sc::vector<double> c;
+        c.assign( 9, std::numeric_limits<double>::quiet_NaN() );
+        EXPECT_FALSE( ( c == c ) );
+        EXPECT_FALSE( c.contains( std::numeric_limits<double>::quiet_NaN() ) );
+    }
+#endif
+
+#if SIMD_FIND
+    {
+        BEGIN_TEST(tm, "SimdFind", "vec.find(value) and vec.contains(value)");
+        EXPECT_TRUE( scan_like_std<std::uint8_t>() );
+        EXPECT_TRUE( scan_like_std<short>() );
+        EXPECT_TRUE( scan_like_std<unsigned>() );
+        EXPECT_TRUE( scan_like_std<long long>() );
+        EXPECT_TRUE( scan_like_std<float>() );
+        EXPECT_TRUE( scan_like_std<double>() );
+
+        sc::vector<int> vec( 1000 );
+        vec[999] = 5;
+        vec[500] = 5;
+        EXPECT_EQ( vec.find( 5 ) - vec.begin(), 500 );
+        *vec.find( 5 ) = 0;
+        const auto& cvec = vec;
+        EXPECT_EQ( cvec.find( 5 ) - cvec.cbegin(), 999 );
+        EXPECT_TRUE( ( cvec.find( 7 ) == cvec.cend() ) );
+        EXPECT_FALSE( cvec.contains( 7 ) );
+    }
+#endif
+
+#if SIMD_COUNT
+    {
+        BEGIN_TEST(tm, "SimdCount", "vec.count(value) on long runs of narrow elements");
+        // 8-bit lane counters would overflow after 127 matches each without periodic flushing.
+        sc::vector<char> bytes;
+        bytes.assign( 100'003, 'a' );
+        bytes[17] = 'b';
+        EXPECT_EQ( bytes.count( 'a' ), 100'002 );
+        EXPECT_EQ( bytes.count( 'b' ), 1 );
+        sc::vector<std::int16_t> shorts;
+        shorts.assign( 2'000'001, 3 );
+        EXPECT_EQ( shorts.count( 3 ), 2'000'001 );
+        EXPECT_EQ( sc::vector<int>{}.count( 0 ), 0 );
+    }
+#endif
+
+#if SIMD_FILL
+    {
+        BEGIN_TEST(tm, "SimdFill", "vec.fill(value) and vec.assign(count, value)");
+        sc::vector<int> vec{ 1, 2, 3 };
+        vec.assign( 37, 9 );
+        EXPECT_EQ( vec.size(), 37 );
+        EXPECT_EQ( static_cast<std::size_t>( std::count( vec.begin(), vec.end(), 9 ) ), 37 );
+        vec.assign( 5, vec[0] + 1 );
+        EXPECT_EQ( vec, ( sc::vector<int>{ 10, 10, 10, 10, 10 } ) );
+        // The value may be an element of the vector itself, even when it reallocates.
+        vec.assign( 1000, vec[4] );
+        EXPECT_EQ( vec.count( 10 ), 1000 );
+
+        sc::vector<double> dvec( 19 );
+        dvec.fill( 2.5 );
+        EXPECT_EQ( dvec.count( 2.5 ), 19 );
+        EXPECT_EQ( dvec.size(), 19 );
+    }
+#endif
+
+#if SIMD_FALLBACK
+    {
+        BEGIN_TEST(tm, "SimdFallback", "find/count/fill on std::string");
+        static_assert( not sc::simd::is_vectorizable_v<std::string> );
+        static_assert( not sc::simd::is_vectorizable_v<bool> );
+        sc::vector<std::string> vec{ "a", "b", "a" };
+        EXPECT_EQ( vec.count( "a" ), 2 );
+        EXPECT_EQ( vec.find( "b" ) - vec.begin(), 1 );
+        EXPECT_FALSE( vec.contains( "c" ) );
+        vec.fill( "z" );
+        EXPECT_EQ( vec, ( sc::vector<std::string>{ "z", "z", "z" } ) );
+        EXPECT_TRUE( ( sc::vector<bool>{ true, false } == sc::vector<bool>{ true, false } ) );
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
@@ -0,0 +1,177 @@
+#include <cstddef>
+#include<iostream>
+#include<string>
+
+#include "include/tm/test_manager.h"
+#include "../include/small_vector.h"
+#include "main.h"
+
+// =============================================================
+// small_vector tests, focused on the inline buffer
+// =============================================================
+
+// No allocation while the elements fit inline.
+#define INLINE_NO_ALLOC YES
+// Growing past N spills to the heap and keeps the elements.
+#define SPILL_TO_HEAP YES
+// shrink_to_fit() brings the elements back inline.
+#define SHRINK_BACK_INLINE YES
+// Copy/move/swap with inline and heap storage.
+#define INLINE_COPY_MOVE YES
+// insert/erase/assign overloads behave as in sc::vector.
+#define INLINE_MODIFIERS YES
+
+/// Allocator that counts how many times it was asked for memory.
+template <typename T>
+struct tally_allocator {
+    using value_type = T;
+    static inline int n_allocs{0};  //!< Number of calls to allocate().
+
+    tally_allocator() = default;
+    template <typename U>
+    tally_allocator( const tally_allocator<U>& ) {}
+
+    T* allocate( std::size_t n ) { ++n_allocs; return std::allocator<T>{}.allocate(n); }
+    void deallocate( T* p, std::size_t n ) { std::allocator<T>{}.deallocate(p, n); }
+
+    friend bool operator==( const tally_allocator&, const tally_allocator& ) { return true; }
+    friend bool operator!=( const tally_allocator&, const tally_allocator& ) { return false; }
+};
+
+template <typename T, std::size_t N>
+using tallied_small_vector = sc::small_vector<T, N, tally_allocator<T>>;
+
+void run_small_vector_tests( void )
+{
+    TestManager tm{ "small_vector testing"};
+
+#if INLINE_NO_ALLOC
+    {
+        BEGIN_TEST(tm, "InlineNoAlloc", "small_vector<T,N> up to N elements");
+        tally_allocator<std::string>::n_allocs = 0;
+        tallied_small_vector<std::string, 16> vec;
+
+        EXPECT_EQ( vec.capacity(), 16 );
+        EXPECT_TRUE( vec.empty() );
+        for ( auto i{0} ; i < 16 ; ++i )
+            vec.push_back( std::to_string(i) );
+        vec.erase( vec.begin() );
+        vec.insert( vec.begin(), "first" );
+        vec.pop_back();
+        vec.emplace( vec.begin()+8, 3, 'z' );
+
+        EXPECT_EQ( tally_allocator<std::string>::n_allocs, 0 );
+        EXPECT_EQ( vec.size(), 16 );
+        EXPECT_EQ( vec[0], "first" );
+        EXPECT_EQ( vec[8], "zzz" );
+        EXPECT_EQ( vec.back(), "14" );
+
+        tallied_small_vector<std::string, 16> list{ "a", "b", "c" };
+        EXPECT_EQ( list.capacity(), 16 );
+        EXPECT_EQ( tally_allocator<std::string>::n_allocs, 0 );
+    }
+#endif
+
+#if SPILL_TO_HEAP
+    {
+        BEGIN_TEST(tm, "SpillToHeap", "small_vector<T,N> beyond N elements");
+        tally_allocator<int>::n_allocs = 0;
+        tallied_small_vector<int, 4> vec{ 1, 2, 3, 4 };
+        auto inline_data = vec.data();
+
+        vec.push_back( 5 );
+        EXPECT_EQ( tally_allocator<int>::n_allocs, 1 );
+        EXPECT_NE( vec.data(), inline_data );
+        EXPECT_GE( vec.capacity(), 5 );
+        EXPECT_EQ( vec, ( tallied_small_vector<int, 4>{ 1, 2, 3, 4, 5 } ) );
+
+        for ( auto i{6} ; i <= 100 ; ++i )
+            vec.push_back( i );
+        for ( auto i{0u} ; i < vec.size() ; ++i )
+            EXPECT_EQ( vec[i], (int)i+1 );
+    }
+#endif
+
+#if SHRINK_BACK_INLINE
+    {
+        BEGIN_TEST(tm, "ShrinkBackInline", "shrink_to_fit() with size <= N");
+        sc::small_vector<std::string, 4> vec{ "a", "b", "c", "d", "e", "f" };
+        EXPECT_EQ( vec.capacity(), 6 );
+        auto heap_data = vec.data();
+
+        vec.erase( vec.begin()+1, vec.begin()+4 );
+        vec.shrink_to_fit();
+        EXPECT_NE( vec.data(), heap_data );
+        EXPECT_EQ( vec.capacity(), 4 );
+        EXPECT_EQ( vec, ( sc::small_vector<std::string, 4>{ "a", "e", "f" } ) );
+
+        // Already inline: nothing to shrink.
+        vec.shrink_to_fit();
+        EXPECT_EQ( vec.capacity(), 4 );
+    }
+#endif
+
+#if INLINE_COPY_MOVE
+    {
+        BEGIN_TEST(tm, "InlineCopyMove", "copy/move/swap of small vectors");
+        using svec = sc::small_vector<std::string, 4>;
+        svec small{ "a", "b" };
+        svec big{ "1", "2", "3", "4", "5", "6" };
+
+        svec copy{ small };
+        EXPECT_EQ( copy, small );
+        EXPECT_NE( copy.data(), small.data() );
+
+        // Moving inline elements moves them one by one into the target's own buffer.
+        svec moved{ std::move( copy ) };
+        EXPECT_EQ( moved, small );
+        EXPECT_TRUE( copy.empty() );
+        EXPECT_EQ( copy.capacity(), 4 );
+
+        // Moving heap elements steals the buffer.
+        auto big_data = big.data();
+        svec big2{ std::move( big ) };
+        EXPECT_EQ( big2.data(), big_data );
+        EXPECT_TRUE( big.empty() );
+        EXPECT_EQ( big.capacity(), 4 );
+
+        moved = std::move( big2 );
+        EXPECT_EQ( moved.data(), big_data );
+        EXPECT_EQ( moved.size(), 6 );
+
+        swap( moved, small );
+        EXPECT_EQ( small.size(), 6 );
+        EXPECT_EQ( small.data(), big_data );
+        EXPECT_EQ( moved, ( svec{ "a", "b" } ) );
+
+        big = small;
+        EXPECT_EQ( big, small );
+    }
+#endif
+
+#if INLINE_MODIFIERS
+    {
+        BEGIN_TEST(tm, "InlineModifiers", "insert/erase/assign on small_vector");
+        sc::small_vector<int, 8> vec{ 1, 2, 3 };
+        sc::vector<int> src{ 10, 20, 30 };
+
+        vec.insert( vec.begin()+1, src.begin(), src.end() );
+        EXPECT_EQ( vec, ( sc::small_vector<int, 8>{ 1, 10, 20, 30, 2, 3 } ) );
+        vec.insert( vec.end(), { 7, 8, 9 } ); // Spills: 9 > 8.
+        EXPECT_EQ( vec.size(), 9 );
+        vec.erase( vec.begin(), vec.begin()+4 );
+        EXPECT_EQ( vec, ( sc::small_vector<int, 8>{ 2, 3, 7, 8, 9 } ) );
+        vec.assign( size_t(3), 0 );
+        EXPECT_EQ( vec, ( sc::small_vector<int, 8>{ 0, 0, 0 } ) );
+        vec.assign( { 5, 6 } );
+        EXPECT_TRUE( vec != ( sc::small_vector<int, 8>{ 0, 0, 0 } ) );
+        vec.push_front( 4 );
+        EXPECT_EQ( vec.front(), 4 );
+        vec.clear();
+        EXPECT_TRUE( vec.empty() );
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
@@ -0,0 +1,292 @@
+#include <cstddef>
+#include <cstdint>
+#include<algorithm>
+#include<iostream>
+#include<memory>
+#include<numeric>
+#include<stdexcept>
+#include<string>
+#include<tuple>
+#include<type_traits>
+
+#include "include/tm/test_manager.h"
+#include "../include/soa_vector.h"
+#include "main.h"
+
+// =============================================================
+// soa_vector tests: rows go in as tuples and come out as tuples
+// of references; every field lives in its own aligned column.
+// =============================================================
+
+// push_back/emplace_back, operator[] and at() agree on every field.
+#define ROWS YES
+// Each column is one contiguous, aligned array, also after growing.
+#define COLUMNS YES
+// The zip iterator walks the rows, with MyForwardIterator's operations.
+#define ZIP_ITERATOR YES
+// pop_back, resize, erase_unordered, clear and shrink_to_fit.
+#define MODIFIERS YES
+// Copies, moves and a field constructor that throws.
+#define SPECIAL_MEMBERS YES
+
+namespace {
+
+/// Counts the live objects; building one from `poison` throws.
+struct Guarded {
+    static int alive;
+    static int poison;
+    int m_value;
+
+    Guarded( int v = 0 ) : m_value{v} {
+        if ( m_value == poison ) throw std::runtime_error{ "poisoned field" };
+        ++alive;
+    }
+    Guarded( const Guarded& other ) : Guarded{ other.m_value } { }
+    Guarded& operator=( const Guarded& other ) = default;
+    ~Guarded() { --alive; }
+    bool operator==( const Guarded& other ) const { return m_value == other.m_value; }
+};
+int Guarded::alive{0};
+int Guarded::poison{-1};
+
+/// Counts the live objects too, but may be relocated with memcpy.
+struct Relocatable {
+    static int alive;
+    int m_value;
+
+    Relocatable( int v = 0 ) : m_value{v} { ++alive; }
+    Relocatable( const Relocatable& other ) : m_value{other.m_value} { ++alive; }
+    ~Relocatable() { --alive; }
+};
+int Relocatable::alive{0};
+
+/// Whether `p` starts a new cache line.
+bool aligned( const void* p ) {
+    return reinterpret_cast<std::uintptr_t>( p ) % 64 == 0;
+}
+
+} // namespace.
+
+template <> struct sc::is_trivially_relocatable<Relocatable> : std::true_type {};
+
+void run_soa_vector_tests( void )
+{
+    TestManager tm{ "soa_vector testing"};
+
+#if ROWS
+    {
+        BEGIN_TEST(tm, "Rows", "push_back(tuple), emplace_back(fields...), operator[], at");
+        sc::soa_vector<int, std::string, double> vec;
+        EXPECT_TRUE( vec.empty() );
+        vec.push_back( std::make_tuple( 1, std::string{ "one" }, 1.5 ) );
+        auto [id, name, weight] = vec.emplace_back( 2, "two", 2.5 );
+        EXPECT_EQ( id, 2 );
+        EXPECT_EQ( name, "two" );
+        EXPECT_EQ( weight, 2.5 );
+        const std::tuple<int, std::string, double> row{ 3, "three", 3.5 };
+        vec.push_back( row );
+        EXPECT_EQ( vec.size(), 3 );
+
+        // operator[] hands out references into the columns.
+        std::get<1>( vec[0] ) += "!";
+        EXPECT_EQ( std::get<1>( vec.at(0) ), "one!" );
+        EXPECT_TRUE( ( vec.back() == std::make_tuple( 3, std::string{ "three" }, 3.5 ) ) );
+        EXPECT_EQ( std::get<0>( vec.front() ), 1 );
+
+        bool thrown{false};
+        try { vec.at( 3 ); }
+        catch ( const std::out_of_range& ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+
+        // A field of the vector itself, when the push reallocates.
+        sc::soa_vector<std::string> words;
+        words.emplace_back( std::string( 100, 'w' ) );
+        words.shrink_to_fit();
+        words.emplace_back( std::get<0>( words[0] ) );
+        EXPECT_EQ( std::get<0>( words[1] ), std::string( 100, 'w' ) );
+    }
+#endif
+
+#if COLUMNS
+    {
+        BEGIN_TEST(tm, "Columns", "column<I>() and data<I>()");
+        sc::soa_vector<float, char, double> vec;
+        for ( auto i{0} ; i < 1000 ; ++i )
+            vec.emplace_back( i * 1.0f, static_cast<char>( 'a' + i % 26 ), i * 2.0 );
+        EXPECT_GE( vec.capacity(), 1000 );
+
+        auto xs = vec.column<0>();
+        EXPECT_EQ( xs.size(), 1000 );
+        EXPECT_EQ( xs.data(), vec.data<0>() );
+        EXPECT_TRUE( aligned( vec.data<0>() ) );
+        EXPECT_TRUE( aligned( vec.data<1>() ) );
+        EXPECT_TRUE( aligned( vec.data<2>() ) );
+        // Every column is dense: the fields are sizeof(T) apart.
+        EXPECT_EQ( &xs[999] - &xs[0], 999 );
+        EXPECT_EQ( std::accumulate( xs.begin(), xs.end(), 0.0f ), 499500.0f );
+
+        for ( auto& d : vec.column<2>() )
+            d = -d;
+        EXPECT_EQ( std::get<2>( vec[10] ), -20.0 );
+        const auto& cvec = vec;
+        auto letters = cvec.column<1>();
+        EXPECT_EQ( std::count( letters.begin(), letters.end(), 'a' ), 39 );
+        EXPECT_EQ( letters.front(), 'a' );
+        EXPECT_EQ( letters.back(), 'a' + 999 % 26 );
+    }
+#endif
+
+#if ZIP_ITERATOR
+    {
+        BEGIN_TEST(tm, "ZipIterator", "begin/end, structured bindings, random access");
+        sc::soa_vector<int, int> pairs{ { 1, 10 }, { 2, 20 }, { 3, 30 }, { 4, 40 } };
+        for ( auto [key, value] : pairs )
+            value += key;
+        int sum{0};
+        const auto& cpairs = pairs;
+        for ( auto [key, value] : cpairs )
+            sum += value;
+        EXPECT_EQ( sum, 110 );
+
+        auto first = pairs.begin();
+        auto last = pairs.end();
+        EXPECT_EQ( last - first, 4 );
+        EXPECT_EQ( std::distance( first, last ), 4 );
+        EXPECT_EQ( std::get<1>( first[2] ), 33 );
+        EXPECT_EQ( std::get<0>( *( first + 3 ) ), 4 );
+        EXPECT_EQ( std::get<0>( *( last - 1 ) ), 4 );
+        auto it = first;
+        it++;
+        ++it;
+        it--;
+        EXPECT_TRUE( ( it == first + 1 ) );
+        EXPECT_TRUE( ( first < it && it <= last && last > it && it >= first && it != last ) );
+        // Mutable and const iterators compare with each other.
+        sc::soa_vector<int, int>::const_iterator cit = it;
+        EXPECT_TRUE( ( cit == pairs.cbegin() + 1 ) );
+        auto found = std::find_if( pairs.begin(), pairs.end(),
+                                   []( auto row ) { return std::get<1>( row ) == 22; } );
+        EXPECT_EQ( found - pairs.begin(), 1 );
+    }
+#endif
+
+#if MODIFIERS
+    {
+        BEGIN_TEST(tm, "Modifiers", "pop_back, resize, erase_unordered, clear, shrink_to_fit");
+        sc::soa_vector<int, std::string> vec;
+        for ( auto i{0} ; i < 10 ; ++i )
+            vec.emplace_back( i, std::to_string( i ) );
+        vec.pop_back();
+        EXPECT_EQ( vec.size(), 9 );
+        vec.erase_unordered( 2 );
+        EXPECT_EQ( vec.size(), 8 );
+        EXPECT_TRUE( ( vec[2] == std::make_tuple( 8, std::string{ "8" } ) ) );
+        vec.erase_unordered( 7 );
+        EXPECT_EQ( std::get<1>( vec.back() ), "6" );
+        bool thrown{false};
+        try { vec.erase_unordered( 7 ); }
+        catch ( const std::out_of_range& ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+
+        vec.resize( 20 );
+        EXPECT_EQ( vec.size(), 20 );
+        EXPECT_TRUE( ( vec[19] == std::make_tuple( 0, std::string{} ) ) );
+        vec.resize( 3 );
+        EXPECT_EQ( vec.size(), 3 );
+        EXPECT_EQ( std::get<0>( vec[2] ), 8 );
+
+        vec.shrink_to_fit();
+        EXPECT_EQ( vec.capacity(), 3 );
+        vec.clear();
+        EXPECT_TRUE( vec.empty() );
+        EXPECT_EQ( vec.capacity(), 3 );
+        vec.shrink_to_fit();
+        EXPECT_EQ( vec.capacity(), 0 );
+    }
+#endif
+
+#if SPECIAL_MEMBERS
+    {
+        BEGIN_TEST(tm, "SpecialMembers", "copy, move, swap, ==, and a field that throws");
+        {
+            sc::soa_vector<Guarded, std::unique_ptr<int>> owners;
+            owners.emplace_back( 1, std::make_unique<int>( 10 ) );
+            owners.emplace_back( 2, std::make_unique<int>( 20 ) );
+            // The second column is move-only: growing still works.
+            owners.reserve( 100 );
+            EXPECT_EQ( *std::get<1>( owners[1] ), 20 );
+            auto moved = std::move( owners );
+            EXPECT_EQ( moved.size(), 2 );
+            EXPECT_TRUE( owners.empty() );
+            EXPECT_EQ( Guarded::alive, 2 );
+
+            // The third column fails: the fields already built for the row go away.
+            sc::soa_vector<Guarded, Guarded, Guarded> rows;
+            rows.emplace_back( 1, 2, 3 );
+            Guarded::poison = 6;
+            bool thrown{false};
+            try { rows.emplace_back( 4, 5, 6 ); }
+            catch ( const std::runtime_error& ) { thrown = true; }
+            EXPECT_TRUE( thrown );
+            EXPECT_EQ( rows.size(), 1 );
+            EXPECT_EQ( Guarded::alive, 5 );
+
+            // A copy that fails halfway leaves nothing behind.
+            Guarded::poison = -1;
+            rows.emplace_back( 4, 5, 7 );
+            Guarded::poison = 7;
+            thrown = false;
+            try { auto copy = rows; }
+            catch ( const std::runtime_error& ) { thrown = true; }
+            EXPECT_TRUE( thrown );
+            EXPECT_EQ( Guarded::alive, 8 );
+            Guarded::poison = -1;
+
+            auto copy = rows;
+            EXPECT_TRUE( ( copy == rows ) );
+            std::get<2>( copy[1] ).m_value = 0;
+            EXPECT_TRUE( ( copy != rows ) );
+            swap( copy, rows );
+            EXPECT_EQ( std::get<2>( rows[1] ).m_value, 0 );
+            copy = rows;
+            EXPECT_TRUE( ( copy == rows ) );
+
+            // Growing fails on the second column: the memcpy'd first one is not destroyed twice.
+            sc::soa_vector<Relocatable, Guarded> mixed;
+            mixed.emplace_back( 1, 1 );
+            mixed.emplace_back( 2, 2 );
+            mixed.shrink_to_fit();
+            Guarded::poison = 2;
+            thrown = false;
+            try { mixed.reserve( 100 ); }
+            catch ( const std::runtime_error& ) { thrown = true; }
+            EXPECT_TRUE( thrown );
+            Guarded::poison = -1;
+            EXPECT_EQ( Relocatable::alive, 2 );
+            EXPECT_EQ( std::get<0>( mixed[1] ).m_value, 2 );
+
+            // Same with a moved first column: its fields are moved back, not lost.
+            sc::soa_vector<std::string, Guarded> named;
+            named.emplace_back( "a string too long for the small buffer", 1 );
+            named.emplace_back( "b", 2 );
+            named.shrink_to_fit();
+            Guarded::poison = 2;
+            thrown = false;
+            try { named.reserve( 100 ); }
+            catch ( const std::runtime_error& ) { thrown = true; }
+            EXPECT_TRUE( thrown );
+            Guarded::poison = -1;
+            EXPECT_EQ( named.size(), 2 );
+            EXPECT_EQ( std::get<0>( named[0] ), "a string too long for the small buffer" );
+            EXPECT_EQ( std::get<0>( named[1] ), "b" );
+            named.reserve( 100 );
+            EXPECT_EQ( std::get<0>( named[1] ), "b" );
+        }
+        EXPECT_EQ( Guarded::alive, 0 );
+        EXPECT_EQ( Relocatable::alive, 0 );
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
@@ -0,0 +1,178 @@
+#include <cstddef>
+#include<algorithm>
+#include<iostream>
+#include<list>
+#include<numeric>
+#include<stdexcept>
+#include<string>
+#include<vector>
+
+#include "include/tm/test_manager.h"
+#include "../include/stable_vector.h"
+#include "main.h"
+
+// =============================================================
+// stable_vector tests: the vector interface on chunked storage
+// whose elements never move when it grows.
+// =============================================================
+
+// Growth adds chunks; references taken before stay valid.
+#define STABLE_GROWTH YES
+// push_back/emplace_back/pop_back/resize/at/front/back, as in sc::vector.
+#define VECTOR_INTERFACE YES
+// insert/emplace/erase shift the elements after the position.
+#define INSERT_ERASE YES
+// Constructors, copies, moves, ==, and the iterators with standard algorithms.
+#define CONSTRUCT_AND_ITERATE YES
+// reserve/shrink_to_fit/clear manage whole chunks.
+#define CHUNK_CAPACITY YES
+
+void run_stable_vector_tests( void )
+{
+    TestManager tm{ "stable_vector testing"};
+
+#if STABLE_GROWTH
+    {
+        BEGIN_TEST(tm, "StableGrowth", "references survive any number of push_back");
+        sc::stable_vector<std::string, 4> vec;
+        vec.push_back( "first" );
+        std::string& first = vec[0];
+        std::vector<const std::string*> addresses;
+        for ( auto i{0} ; i < 1000 ; ++i ) {
+            vec.emplace_back( std::to_string( i ) );
+            addresses.push_back( &vec.back() );
+        }
+        EXPECT_EQ( &first, &vec[0] );
+        EXPECT_EQ( first, "first" );
+        bool same{true};
+        for ( std::size_t i{0} ; i < addresses.size() ; ++i )
+            same = same && addresses[i] == &vec[i + 1];
+        EXPECT_TRUE( same );
+        EXPECT_EQ( vec.capacity(), 1004 );
+
+        // An element of the vector itself, when the push needs a new chunk.
+        while ( vec.size() < vec.capacity() )
+            vec.push_back( "filler" );
+        vec.push_back( vec[0] );
+        EXPECT_EQ( vec.back(), "first" );
+        // The default chunk is about 4 KiB of elements.
+        EXPECT_EQ( sc::stable_vector<int>::chunk_size, 1024 );
+        EXPECT_EQ( ( sc::stable_vector<char[1000]>::chunk_size ), 16 );
+    }
+#endif
+
+#if VECTOR_INTERFACE
+    {
+        BEGIN_TEST(tm, "VectorInterface", "push_back, pop_back, resize, assign, at, front, back");
+        sc::stable_vector<int, 8> vec;
+        EXPECT_TRUE( vec.empty() );
+        for ( auto i{0} ; i < 20 ; ++i )
+            vec.push_back( i );
+        vec.pop_back();
+        EXPECT_EQ( vec.size(), 19 );
+        EXPECT_EQ( vec.front(), 0 );
+        EXPECT_EQ( vec.back(), 18 );
+        EXPECT_EQ( vec.at(9), 9 );
+        bool thrown{false};
+        try { vec.at( 19 ); }
+        catch ( const std::out_of_range& ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+
+        vec.resize( 30 );
+        EXPECT_EQ( vec[29], 0 );
+        vec.resize( 35, 7 );
+        EXPECT_EQ( vec[34], 7 );
+        vec.resize( 5 );
+        EXPECT_EQ( vec.size(), 5 );
+        vec.assign( 3, vec[4] );
+        EXPECT_EQ( vec.size(), 3 );
+        EXPECT_EQ( vec[2], 4 );
+    }
+#endif
+
+#if INSERT_ERASE
+    {
+        BEGIN_TEST(tm, "InsertErase", "insert, emplace, erase(pos), erase(first, last)");
+        sc::stable_vector<std::string, 2> vec{ "a", "b", "c", "d", "e" };
+        auto it = vec.insert( vec.begin() + 1, "x" );
+        EXPECT_EQ( *it, "x" );
+        vec.emplace( vec.end(), 2, 'z' );
+        vec.insert( vec.begin(), vec[3] );
+        EXPECT_TRUE( ( vec == sc::stable_vector<std::string, 2>{ "c", "a", "x", "b", "c", "d", "e", "zz" } ) );
+
+        it = vec.erase( vec.begin() + 2 );
+        EXPECT_EQ( *it, "b" );
+        it = vec.erase( vec.begin(), vec.begin() + 3 );
+        EXPECT_EQ( *it, "c" );
+        EXPECT_TRUE( ( vec == sc::stable_vector<std::string, 2>{ "c", "d", "e", "zz" } ) );
+        vec.erase( vec.begin() + 1, vec.begin() + 1 );
+        EXPECT_EQ( vec.size(), 4 );
+
+        bool thrown{false};
+        try { vec.erase( vec.end() ); }
+        catch ( const std::out_of_range& ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+        thrown = false;
+        try { vec.insert( vec.end() + 1, "?" ); }
+        catch ( const std::out_of_range& ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+    }
+#endif
+
+#if CONSTRUCT_AND_ITERATE
+    {
+        BEGIN_TEST(tm, "ConstructAndIterate", "range/list constructors, copy, move, std algorithms");
+        std::list<int> source{ 5, 1, 4, 2, 3 };
+        sc::stable_vector<int, 2> vec( source.begin(), source.end() );
+        EXPECT_EQ( vec.size(), 5 );
+        std::sort( vec.begin(), vec.end() );
+        EXPECT_TRUE( ( vec == sc::stable_vector<int, 2>{ 1, 2, 3, 4, 5 } ) );
+        const auto& cvec = vec;
+        EXPECT_EQ( std::accumulate( cvec.begin(), cvec.end(), 0 ), 15 );
+        EXPECT_EQ( cvec.end() - cvec.begin(), 5 );
+        sc::stable_vector<int, 2>::const_iterator cit = vec.begin() + 2;
+        EXPECT_EQ( *cit, 3 );
+        EXPECT_EQ( std::find( vec.begin(), vec.end(), 4 ) - vec.begin(), 3 );
+
+        auto copy = vec;
+        copy[0] = 100;
+        EXPECT_EQ( vec[0], 1 );
+        EXPECT_TRUE( ( copy != vec ) );
+        const int* kept = &copy[4];
+        auto moved = std::move( copy );
+        EXPECT_EQ( &moved[4], kept );
+        EXPECT_TRUE( copy.empty() );
+        vec = moved;
+        EXPECT_EQ( vec[0], 100 );
+        swap( vec, copy );
+        EXPECT_TRUE( vec.empty() );
+        EXPECT_EQ( copy.size(), 5 );
+    }
+#endif
+
+#if CHUNK_CAPACITY
+    {
+        BEGIN_TEST(tm, "ChunkCapacity", "reserve, shrink_to_fit, clear");
+        sc::stable_vector<int, 16> vec;
+        EXPECT_EQ( vec.capacity(), 0 );
+        vec.reserve( 17 );
+        EXPECT_EQ( vec.capacity(), 32 );
+        for ( auto i{0} ; i < 40 ; ++i )
+            vec.push_back( i );
+        EXPECT_EQ( vec.capacity(), 48 );
+        const int* kept = &vec[3];
+        vec.resize( 10 );
+        vec.shrink_to_fit();
+        EXPECT_EQ( vec.capacity(), 16 );
+        EXPECT_EQ( &vec[3], kept );
+        vec.clear();
+        EXPECT_TRUE( vec.empty() );
+        EXPECT_EQ( vec.capacity(), 16 );
+        vec.shrink_to_fit();
+        EXPECT_EQ( vec.capacity(), 0 );
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
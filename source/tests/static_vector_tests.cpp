@@ -0,0 +1,160 @@
+#include <cstddef>
+#include<algorithm>
+#include<iostream>
+#include<numeric>
+#include<stdexcept>
+#include<string>
+
+#include "include/tm/test_manager.h"
+#include "../include/static_vector.h"
+#include "main.h"
+
+// =============================================================
+// static_vector tests: a fixed capacity inside the object, no
+// allocation, and overflow reported as an error.
+// =============================================================
+
+// The elements always live inside the object; capacity() is N.
+#define INSIDE_THE_OBJECT YES
+// Needing more than N elements throws std::length_error and changes nothing.
+#define OVERFLOW_IS_AN_ERROR YES
+// try_push_back/try_emplace_back report a full vector with nullptr.
+#define TRY_PUSH YES
+// insert/erase/assign, iterators and algorithms, as in sc::vector.
+#define VECTOR_INTERFACE YES
+// Copies, moves and swaps exchange the elements.
+#define COPY_MOVE_SWAP YES
+
+namespace {
+
+/// Whether the elements of `vec` are stored in the bytes of `vec` itself.
+template <typename Vec>
+bool stored_inside( const Vec& vec ) {
+    auto first = reinterpret_cast<const unsigned char*>( &vec );
+    auto elems = reinterpret_cast<const unsigned char*>( vec.data() );
+    return elems >= first && elems + vec.capacity() * sizeof( *vec.data() ) <= first + sizeof( vec );
+}
+
+} // namespace.
+
+void run_static_vector_tests( void )
+{
+    TestManager tm{ "static_vector testing"};
+
+#if INSIDE_THE_OBJECT
+    {
+        BEGIN_TEST(tm, "InsideTheObject", "the buffer is part of the static_vector, of capacity N");
+        sc::static_vector<std::string, 8> vec;
+        EXPECT_EQ( vec.capacity(), 8 );
+        EXPECT_TRUE( stored_inside( vec ) );
+        for ( auto i{0} ; i < 8 ; ++i )
+            vec.emplace_back( std::to_string( i ) );
+        vec.reserve( 8 );
+        vec.shrink_to_fit();
+        EXPECT_EQ( vec.capacity(), 8 );
+        EXPECT_TRUE( stored_inside( vec ) );
+        EXPECT_EQ( vec.back(), "7" );
+        sc::static_vector<int, 4> sized( 3 );
+        EXPECT_EQ( sized.size(), 3 );
+        EXPECT_EQ( sized.capacity(), 4 );
+        EXPECT_TRUE( stored_inside( sized ) );
+    }
+#endif
+
+#if OVERFLOW_IS_AN_ERROR
+    {
+        BEGIN_TEST(tm, "OverflowIsAnError", "push_back, insert, reserve, assign past N throw length_error");
+        sc::static_vector<std::string, 4> vec{ "a", "b", "c", "d" };
+        auto throws = [&]( auto op ) {
+            try { op(); }
+            catch ( const std::length_error& ) { return true; }
+            return false;
+        };
+        EXPECT_TRUE( throws( [&]{ vec.push_back( "e" ); } ) );
+        EXPECT_TRUE( throws( [&]{ vec.insert( vec.begin(), "e" ); } ) );
+        EXPECT_TRUE( throws( [&]{ vec.reserve( 5 ); } ) );
+        EXPECT_TRUE( throws( [&]{ vec.resize( 5 ); } ) );
+        // Nothing changed.
+        EXPECT_EQ( vec, ( sc::static_vector<std::string, 4>{ "a", "b", "c", "d" } ) );
+        vec.pop_back();
+        const std::string more[]{ "x", "y" };
+        EXPECT_TRUE( throws( [&]{ vec.insert( vec.begin(), std::begin( more ), std::end( more ) ); } ) );
+        EXPECT_TRUE( throws( [&]{ vec.assign( 5, "z" ); } ) );
+        EXPECT_TRUE( throws( [&]{ sc::static_vector<int, 2>{ 1, 2, 3 }; } ) );
+        EXPECT_EQ( vec.size(), 3 );
+        EXPECT_EQ( vec.back(), "c" );
+        vec.push_back( "d" );
+        EXPECT_EQ( vec.size(), 4 );
+    }
+#endif
+
+#if TRY_PUSH
+    {
+        BEGIN_TEST(tm, "TryPush", "try_push_back/try_emplace_back never grow the vector");
+        sc::static_vector<int, 3> vec;
+        int* first = vec.try_push_back( 1 );
+        EXPECT_EQ( first, vec.data() );
+        EXPECT_EQ( *vec.try_emplace_back( 2 ), 2 );
+        EXPECT_TRUE( ( vec.try_push_back( 3 ) != nullptr ) );
+        EXPECT_EQ( vec.try_push_back( 4 ), nullptr );
+        EXPECT_EQ( vec.try_emplace_back( 4 ), nullptr );
+        EXPECT_EQ( vec.size(), 3 );
+        // sc::vector has them too: they append only if no reallocation is needed.
+        sc::vector<int> plain;
+        EXPECT_EQ( plain.try_push_back( 1 ), nullptr );
+        plain.reserve( 1 );
+        EXPECT_TRUE( ( plain.try_push_back( 1 ) != nullptr ) );
+        EXPECT_EQ( plain.try_push_back( 2 ), nullptr );
+    }
+#endif
+
+#if VECTOR_INTERFACE
+    {
+        BEGIN_TEST(tm, "VectorInterface", "insert, erase, assign, iterators, standard algorithms");
+        sc::static_vector<int, 16> vec{ 5, 3, 1 };
+        vec.insert( vec.begin() + 1, 4 );
+        vec.insert( vec.end(), { 2, 0 } );
+        std::sort( vec.begin(), vec.end() );
+        EXPECT_EQ( vec, ( sc::static_vector<int, 16>{ 0, 1, 2, 3, 4, 5 } ) );
+        vec.erase( vec.begin(), vec.begin() + 2 );
+        vec.erase( vec.begin() );
+        EXPECT_EQ( std::accumulate( vec.begin(), vec.end(), 0 ), 12 );
+        EXPECT_EQ( vec.find( 4 ) - vec.begin(), 1 );
+        vec.assign( 16, 7 );
+        EXPECT_EQ( vec.count( 7 ), 16 );
+        vec.assign( { 1, 2 } );
+        EXPECT_EQ( vec.size(), 2 );
+        EXPECT_EQ( vec.at( 1 ), 2 );
+        vec.clear();
+        EXPECT_TRUE( vec.empty() );
+        EXPECT_EQ( vec.capacity(), 16 );
+    }
+#endif
+
+#if COPY_MOVE_SWAP
+    {
+        BEGIN_TEST(tm, "CopyMoveSwap", "copies, moves and swaps keep each buffer in its object");
+        sc::static_vector<std::string, 4> a{ "one", "two" };
+        sc::static_vector<std::string, 4> b{ "three" };
+        auto copy = a;
+        EXPECT_EQ( copy, a );
+        EXPECT_TRUE( stored_inside( copy ) );
+        auto moved = std::move( copy );
+        EXPECT_EQ( moved, a );
+        EXPECT_TRUE( stored_inside( moved ) );
+        swap( a, b );
+        EXPECT_EQ( a.size(), 1 );
+        EXPECT_EQ( b.back(), "two" );
+        EXPECT_TRUE( stored_inside( a ) );
+        EXPECT_TRUE( stored_inside( b ) );
+        b = a;
+        EXPECT_EQ( b, a );
+        a = std::move( moved );
+        EXPECT_EQ( a.front(), "one" );
+        EXPECT_TRUE( stored_inside( a ) );
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
@@ -0,0 +1,525 @@
+#include <cstddef>
+#include<iostream>
+#include<string>
+#include<memory>
+#include<cstring>
+#include<array>
+#include<list>
+#include<sstream>
+#include<iterator>
+
+#include "include/tm/test_manager.h"
+#include "../include/vector.h"
+#include "main.h"
+
+// =============================================================
+// Storage tests, focused on how many elements the vector builds
+// =============================================================
+
+// reserve() must not construct any element.
+#define RESERVE_NO_CTRO YES
+// vec(n) builds exactly n elements, no more.
+#define CTRO_SIZE_COUNT YES
+// The destructor only destroys the live elements.
+#define DTRO_LIVE_ONLY YES
+// Growing the vector through push_back keeps every live element alive exactly once.
+#define PUSH_BACK_BALANCE YES
+// Reallocation moves the elements instead of copying them.
+#define GROWTH_MOVES YES
+// push_back/insert of a temporary moves it into the vector.
+#define RVALUE_INSERT YES
+// emplace_back/emplace build the element directly in its slot.
+#define EMPLACE_IN_PLACE YES
+// Trivially relocatable types are shifted/reallocated bitwise, never through their move ctor.
+#define BITWISE_RELOCATION YES
+// Range insert grows geometrically, so repeated bulk appends do not reallocate every time.
+#define RANGE_INSERT_GEOMETRIC YES
+// Every growing modifier follows the growth policy.
+#define GROWTH_POLICIES YES
+// append_range() reallocates at most once and copies each element once.
+#define APPEND_RANGE YES
+// resize_for_overwrite() leaves trivial elements alone and default-constructs the others.
+#define RESIZE_FOR_OVERWRITE YES
+// Single-pass input ranges (istream_iterator) can construct, assign and insert.
+#define INPUT_ITERATOR_RANGES YES
+// Forward ranges are measured up front: one allocation, one copy per element.
+#define FORWARD_ITERATOR_RANGES YES
+// erase_unordered() fills the hole with the last element: one move, no shifting.
+#define ERASE_UNORDERED YES
+// remove_if()/sc::erase_if() compact in one pass, moving each kept element at most once.
+#define ERASE_IF_SINGLE_PASS YES
+
+/// Counts how many objects are alive, so we can check construction/destruction balance.
+struct Tracked {
+    static int alive;  //!< Number of live Tracked objects.
+    static int built;  //!< Total number of constructor calls.
+    static int copies; //!< Number of copy constructions/assignments.
+    std::string m_value;
+
+    Tracked( const std::string& v = "" ) : m_value{v} { ++alive; ++built; }
+    Tracked( const Tracked& other ) : m_value{other.m_value} { ++alive; ++built; ++copies; }
+    Tracked( Tracked&& other ) noexcept : m_value{std::move(other.m_value)} { ++alive; ++built; }
+    Tracked& operator=( const Tracked& other ) { m_value = other.m_value; ++copies; return *this; }
+    Tracked& operator=( Tracked&& other ) noexcept = default;
+    ~Tracked() { --alive; }
+
+    static void reset() { alive = 0; built = 0; copies = 0; }
+};
+int Tracked::alive{0};
+int Tracked::built{0};
+int Tracked::copies{0};
+
+/// Owns a heap integer; opts in to bitwise relocation and counts move constructions.
+struct Relocatable {
+    static int moves;  //!< Number of move constructions.
+    std::unique_ptr<int> m_value;
+
+    Relocatable( int v = 0 ) : m_value{ std::make_unique<int>(v) } {}
+    Relocatable( const Relocatable& other ) : m_value{ std::make_unique<int>(*other.m_value) } {}
+    Relocatable( Relocatable&& other ) noexcept : m_value{ std::move(other.m_value) } { ++moves; }
+    Relocatable& operator=( const Relocatable& other ) { *m_value = *other.m_value; return *this; }
+    Relocatable& operator=( Relocatable&& other ) noexcept = default;
+};
+int Relocatable::moves{0};
+
+template <>
+struct sc::is_trivially_relocatable<Relocatable> : std::true_type {};
+
+void run_storage_tests( void )
+{
+    TestManager tm{ "Storage testing"};
+
+#if RESERVE_NO_CTRO
+    {
+        BEGIN_TEST(tm, "ReserveNoCtro", "vec.reserve(n) constructs nothing");
+        Tracked::reset();
+        {
+            sc::vector<Tracked> vec;
+            vec.reserve( 1'000'000 );
+            EXPECT_EQ( vec.capacity(), 1'000'000 );
+            EXPECT_EQ( Tracked::built, 0 );
+            EXPECT_EQ( Tracked::alive, 0 );
+        }
+        EXPECT_EQ( Tracked::alive, 0 );
+    }
+#endif
+
+#if CTRO_SIZE_COUNT
+    {
+        BEGIN_TEST(tm, "CtroSizeCount", "vec(n) constructs exactly n elements");
+        Tracked::reset();
+        {
+            sc::vector<Tracked> vec( 7 );
+            EXPECT_EQ( Tracked::built, 7 );
+            vec.reserve( 100 );
+            EXPECT_EQ( Tracked::alive, 7 );
+        }
+        EXPECT_EQ( Tracked::alive, 0 );
+    }
+#endif
+
+#if DTRO_LIVE_ONLY
+    {
+        BEGIN_TEST(tm, "DtroLiveOnly", "only [0, size) is destroyed");
+        Tracked::reset();
+        {
+            sc::vector<Tracked> vec{ Tracked{"a"}, Tracked{"b"}, Tracked{"c"} };
+            vec.reserve( 50 );
+            vec.pop_back();
+            EXPECT_EQ( Tracked::alive, 2 );
+            vec.shrink_to_fit();
+            EXPECT_EQ( vec.capacity(), 2 );
+            EXPECT_EQ( Tracked::alive, 2 );
+            vec.clear();
+            EXPECT_EQ( Tracked::alive, 0 );
+        }
+        EXPECT_EQ( Tracked::alive, 0 );
+    }
+#endif
+
+#if PUSH_BACK_BALANCE
+    {
+        BEGIN_TEST(tm, "PushBackBalance", "growth keeps construction/destruction balanced");
+        Tracked::reset();
+        {
+            sc::vector<Tracked> vec;
+            for ( auto i{0} ; i < 100 ; ++i )
+                vec.push_back( Tracked{ std::to_string(i) } );
+            EXPECT_EQ( Tracked::alive, 100 );
+            vec.insert( vec.begin()+10, Tracked{"x"} );
+            vec.erase( vec.begin(), vec.begin()+5 );
+            EXPECT_EQ( Tracked::alive, 96 );
+            EXPECT_EQ( vec[5].m_value, "x" );
+            vec.assign( size_t(3), Tracked{"y"} );
+            EXPECT_EQ( Tracked::alive, 3 );
+        }
+        EXPECT_EQ( Tracked::alive, 0 );
+    }
+#endif
+
+#if GROWTH_MOVES
+    {
+        BEGIN_TEST(tm, "GrowthMoves", "reserve/shrink_to_fit relocate by moving");
+        Tracked::reset();
+        sc::vector<Tracked> vec{ Tracked{"a"}, Tracked{"b"}, Tracked{"c"} };
+        auto copies_before = Tracked::copies; // The initializer_list always copies.
+        vec.reserve( 100 );
+        vec.shrink_to_fit();
+        vec.insert( vec.begin()+1, { Tracked{"x"}, Tracked{"y"} } );
+        vec.erase( vec.begin() );
+        // Only the two initializer_list elements were copied.
+        EXPECT_EQ( Tracked::copies - copies_before, 2 );
+        EXPECT_EQ( vec[0].m_value, "x" );
+        EXPECT_EQ( vec[3].m_value, "c" );
+    }
+#endif
+
+#if RVALUE_INSERT
+    {
+        BEGIN_TEST(tm, "RvalueInsert", "push_back(T&&)/insert(pos, T&&) do not copy");
+        Tracked::reset();
+        sc::vector<Tracked> vec;
+        for ( auto i{0} ; i < 50 ; ++i )
+            vec.push_back( Tracked{ std::to_string(i) } );
+        vec.insert( vec.begin()+3, Tracked{"mid"} );
+        vec.push_front( Tracked{"first"} );
+        EXPECT_EQ( Tracked::copies, 0 );
+        EXPECT_EQ( vec.size(), 52 );
+        EXPECT_EQ( vec[0].m_value, "first" );
+        EXPECT_EQ( vec[4].m_value, "mid" );
+        EXPECT_EQ( vec[51].m_value, "49" );
+
+        sc::vector<Tracked> moved{ std::move(vec) };
+        EXPECT_EQ( Tracked::copies, 0 );
+        EXPECT_TRUE( vec.empty() );
+        EXPECT_EQ( moved.size(), 52 );
+    }
+#endif
+
+#if EMPLACE_IN_PLACE
+    {
+        BEGIN_TEST(tm, "EmplaceInPlace", "emplace_back(args) constructs exactly once");
+        Tracked::reset();
+        sc::vector<Tracked> vec;
+        vec.reserve( 10 );
+        for ( auto i{0} ; i < 10 ; ++i )
+            vec.emplace_back( std::to_string(i) );
+        // One constructor call per element: no temporary, no copy, no move.
+        EXPECT_EQ( Tracked::built, 10 );
+        vec.emplace( vec.begin()+10, "end" ); // Growth: still built straight in the new buffer.
+        EXPECT_EQ( Tracked::copies, 0 );
+        EXPECT_EQ( vec.back().m_value, "end" );
+        EXPECT_EQ( vec.size(), 11 );
+    }
+#endif
+
+#if BITWISE_RELOCATION
+    {
+        BEGIN_TEST(tm, "BitwiseRelocation", "memcpy/memmove for trivially relocatable T");
+        static_assert( sc::is_trivially_relocatable_v<int> );
+        static_assert( not sc::is_trivially_relocatable_v<std::string> );
+
+        Relocatable::moves = 0;
+        sc::vector<Relocatable> vec;
+        for ( auto i{0} ; i < 100 ; ++i )
+            vec.emplace_back( i );
+        vec.reserve( 1000 );
+        vec.shrink_to_fit();
+        // Reallocating never calls the move constructor.
+        EXPECT_EQ( Relocatable::moves, 0 );
+        vec.insert( vec.begin(), Relocatable{ -1 } );
+        vec.emplace( vec.begin()+50, -2 );
+        vec.push_front( Relocatable{ -3 } );
+        // Only the new elements were moved in; the shifted ones were memmove'd.
+        auto inserted_moves = Relocatable::moves;
+        EXPECT_LE( inserted_moves, 5 );
+        vec.erase( vec.begin()+1, vec.begin()+3 );
+        vec.pop_front();
+        EXPECT_EQ( Relocatable::moves, inserted_moves );
+
+        EXPECT_EQ( vec.size(), 100 );
+        EXPECT_EQ( *vec[0].m_value, 1 );
+        EXPECT_EQ( *vec[47].m_value, 48 );
+        EXPECT_EQ( *vec[48].m_value, -2 );
+        EXPECT_EQ( *vec.back().m_value, 99 );
+
+        // The same paths with a plain trivially copyable type.
+        sc::vector<int> ivec{ 1, 2, 3, 4, 5 };
+        ivec.insert( ivec.begin()+1, { 10, 20 } );
+        ivec.push_front( 0 );
+        ivec.erase( ivec.begin()+4 );
+        EXPECT_EQ( ivec, ( sc::vector<int>{ 0, 1, 10, 20, 3, 4, 5 } ) );
+    }
+#endif
+
+#if RANGE_INSERT_GEOMETRIC
+    {
+        BEGIN_TEST(tm, "RangeInsertGeometric", "repeated range inserts reallocate O(log n) times");
+        sc::vector<int> vec;
+        sc::vector<int> chunk{ 1, 2, 3, 4, 5, 6, 7, 8 };
+        auto reallocs{0};
+        auto last_capacity = vec.capacity();
+        for ( auto i{0} ; i < 1000 ; ++i )
+        {
+            vec.insert( vec.end(), chunk.begin(), chunk.end() );
+            if ( vec.capacity() != last_capacity ) { ++reallocs; last_capacity = vec.capacity(); }
+        }
+        EXPECT_EQ( vec.size(), 8000 );
+        EXPECT_LE( reallocs, 12 );
+        EXPECT_EQ( vec[7999], 8 );
+        // A single big insert still gets all the room it needs at once.
+        sc::vector<int> big( 3 );
+        big.insert( big.begin(), vec.begin(), vec.end() );
+        EXPECT_GE( big.capacity(), 8003 );
+    }
+#endif
+
+#if GROWTH_POLICIES
+    {
+        BEGIN_TEST(tm, "GrowthPolicies", "doubling_growth, half_growth and size_class_growth");
+        static_assert( std::is_same_v< sc::vector<int>::growth_policy, sc::doubling_growth > );
+
+        sc::vector<int> dflt;
+        dflt.push_back( 1 );
+        EXPECT_EQ( dflt.capacity(), 10 );
+        for ( auto i{0} ; i < 10 ; ++i ) dflt.push_back( i );
+        EXPECT_EQ( dflt.capacity(), 20 );
+
+        sc::vector<int, std::allocator<int>, 0, sc::half_growth> half;
+        half.push_back( 1 );
+        EXPECT_EQ( half.capacity(), 8 );
+        for ( auto i{0} ; i < 8 ; ++i ) half.emplace_back( i );
+        EXPECT_EQ( half.capacity(), 12 );
+        half.insert( half.begin(), { 1, 2, 3, 4 } );
+        EXPECT_EQ( half.capacity(), 18 );
+        half.push_front( 0 );
+        EXPECT_EQ( half.size(), 14 );
+
+        // Every capacity fills a whole jemalloc size class.
+        static_assert( sc::size_class_growth::round_to_class( 1 ) == 16 );
+        static_assert( sc::size_class_growth::round_to_class( 100 ) == 112 );
+        static_assert( sc::size_class_growth::round_to_class( 129 ) == 160 );
+        static_assert( sc::size_class_growth::round_to_class( 256 ) == 256 );
+        static_assert( sc::size_class_growth::round_to_class( 4097 ) == 5120 );
+        sc::vector<std::string, std::allocator<std::string>, 0, sc::size_class_growth> sized;
+        auto last_capacity = sized.capacity();
+        for ( auto i{0} ; i < 500 ; ++i )
+        {
+            sized.push_back( std::to_string(i) );
+            if ( sized.capacity() != last_capacity )
+            {
+                last_capacity = sized.capacity();
+                auto bytes = last_capacity * sizeof(std::string);
+                EXPECT_GE( sc::size_class_growth::round_to_class( bytes ), bytes );
+                EXPECT_LT( sc::size_class_growth::round_to_class( bytes ) - bytes, sizeof(std::string) );
+            }
+        }
+        EXPECT_EQ( sized[499], "499" );
+        EXPECT_TRUE( ( sized == sized ) );
+    }
+#endif
+
+#if APPEND_RANGE
+    {
+        BEGIN_TEST(tm, "AppendRange", "vec.append_range(first, last) and vec.append_range(range)");
+        Tracked::reset();
+        sc::vector<Tracked> src;
+        for ( auto i{0} ; i < 100 ; ++i )
+            src.emplace_back( std::to_string(i) );
+        sc::vector<Tracked> vec{ Tracked{"a"} };
+        Tracked::reset();
+
+        vec.append_range( src.begin(), src.end() );
+        // One copy per appended element; the existing element is moved once, by the only reallocation.
+        EXPECT_EQ( Tracked::copies, 100 );
+        EXPECT_EQ( Tracked::built, 101 );
+        EXPECT_EQ( vec.size(), 101 );
+        EXPECT_EQ( vec[0].m_value, "a" );
+        EXPECT_EQ( vec[100].m_value, "99" );
+
+        sc::vector<int> ivec{ 1, 2 };
+        std::array<int, 3> more{ 3, 4, 5 };
+        ivec.append_range( more );
+        ivec.append_range( sc::vector<int>{} );
+        ivec.append_range( std::initializer_list<int>{ 6 } );
+        EXPECT_EQ( ivec, ( sc::vector<int>{ 1, 2, 3, 4, 5, 6 } ) );
+    }
+#endif
+
+#if RESIZE_FOR_OVERWRITE
+    {
+        BEGIN_TEST(tm, "ResizeForOverwrite", "vec.resize_for_overwrite(n) then fill through data()");
+        sc::vector<unsigned char> buffer;
+        buffer.resize_for_overwrite( 4096 );
+        EXPECT_EQ( buffer.size(), 4096 );
+        // Stand-in for read()/recv() writing straight into the buffer.
+        std::memset( buffer.data(), 0x7f, buffer.size() );
+        EXPECT_EQ( buffer[4095], 0x7f );
+        buffer.resize_for_overwrite( 10 );
+        EXPECT_EQ( buffer.size(), 10 );
+        EXPECT_EQ( buffer.capacity(), 4096 );
+
+        // Non-trivial elements are still default-constructed.
+        Tracked::reset();
+        {
+            sc::vector<Tracked> vec;
+            vec.resize_for_overwrite( 8 );
+            EXPECT_EQ( Tracked::built, 8 );
+            EXPECT_EQ( vec[7].m_value, "" );
+        }
+        EXPECT_EQ( Tracked::alive, 0 );
+    }
+#endif
+
+#if INPUT_ITERATOR_RANGES
+    {
+        BEGIN_TEST(tm, "InputIteratorRanges", "construct/assign/insert from std::istream_iterator");
+        using in_itr = std::istream_iterator<int>;
+        std::istringstream numbers{ "1 2 3 4 5 6 7 8 9 10 11 12" };
+        sc::vector<int> vec( in_itr{numbers}, in_itr{} );
+        EXPECT_EQ( vec.size(), 12 );
+        EXPECT_EQ( vec.front(), 1 );
+        EXPECT_EQ( vec.back(), 12 );
+
+        std::istringstream shorter{ "7 8" };
+        vec.assign( in_itr{shorter}, in_itr{} );
+        EXPECT_EQ( vec, ( sc::vector<int>{ 7, 8 } ) );
+        std::istringstream longer{ "1 2 3 4" };
+        vec.assign( in_itr{longer}, in_itr{} );
+        EXPECT_EQ( vec, ( sc::vector<int>{ 1, 2, 3, 4 } ) );
+
+        std::istringstream middle{ "20 30" };
+        auto it = vec.insert( vec.begin()+1, in_itr{middle}, in_itr{} );
+        EXPECT_EQ( *it, 20 );
+        EXPECT_EQ( vec, ( sc::vector<int>{ 1, 20, 30, 2, 3, 4 } ) );
+        std::istringstream tail{ "5" };
+        vec.append_range( in_itr{tail}, in_itr{} );
+        EXPECT_EQ( vec.back(), 5 );
+        std::istringstream empty{ "" };
+        vec.insert( vec.cbegin(), in_itr{empty}, in_itr{} );
+        EXPECT_EQ( vec.size(), 7 );
+
+        // Still usable as a size constructor / fill assign with integral arguments.
+        sc::vector<int> sized( 3 );
+        EXPECT_EQ( sized.size(), 3 );
+    }
+#endif
+
+#if FORWARD_ITERATOR_RANGES
+    {
+        BEGIN_TEST(tm, "ForwardIteratorRanges", "std::list and contiguous sources, sized up front");
+        std::list<Tracked> src;
+        for ( auto i{0} ; i < 50 ; ++i )
+            src.emplace_back( std::to_string(i) );
+        Tracked::reset();
+        sc::vector<Tracked> vec( src.begin(), src.end() );
+        EXPECT_EQ( vec.capacity(), 50 );
+        EXPECT_EQ( Tracked::copies, 50 );
+        EXPECT_EQ( Tracked::built, 50 );
+        EXPECT_EQ( vec[49].m_value, "49" );
+
+        Tracked::reset();
+        vec.assign( src.begin(), std::next(src.begin(), 10) );
+        EXPECT_EQ( vec.size(), 10 );
+        EXPECT_EQ( vec.capacity(), 50 );
+        EXPECT_EQ( Tracked::copies, 10 );
+
+        // Trivially copyable elements from a contiguous source are copied with memcpy/memmove.
+        int raw[]{ 1, 2, 3, 4, 5 };
+        sc::vector<int> ivec( std::begin(raw), std::end(raw) );
+        EXPECT_EQ( ivec, ( sc::vector<int>{ 1, 2, 3, 4, 5 } ) );
+        sc::vector<int> copy( ivec.cbegin(), ivec.cend() );
+        EXPECT_EQ( copy, ivec );
+        ivec.assign( ivec.begin()+2, ivec.end() );
+        EXPECT_EQ( ivec, ( sc::vector<int>{ 3, 4, 5 } ) );
+        ivec.insert( ivec.begin()+1, std::begin(raw), std::begin(raw)+2 );
+        EXPECT_EQ( ivec, ( sc::vector<int>{ 3, 1, 2, 4, 5 } ) );
+        std::list<int> lst{ 9, 8 };
+        ivec.assign( lst.begin(), lst.end() );
+        EXPECT_EQ( ivec, ( sc::vector<int>{ 9, 8 } ) );
+    }
+#endif
+
+#if ERASE_UNORDERED
+    {
+        BEGIN_TEST(tm, "EraseUnordered", "vec.erase_unordered(pos) swaps with the last and pops");
+        sc::vector<Tracked> vec;
+        for ( auto i{0} ; i < 5 ; ++i )
+            vec.emplace_back( std::to_string(i) );
+        Tracked::reset();
+        auto it = vec.erase_unordered( vec.begin()+1 );
+        EXPECT_EQ( it->m_value, "4" );
+        EXPECT_EQ( vec.size(), 4 );
+        EXPECT_EQ( Tracked::alive, -1 );
+        EXPECT_EQ( Tracked::copies, 0 );
+        it = vec.erase_unordered( vec.cend()-1 );
+        EXPECT_TRUE( ( it == vec.end() ) );
+        EXPECT_EQ( vec[0].m_value + vec[1].m_value + vec[2].m_value, "042" );
+
+        // Relocatable elements are memcpy'd over the hole, not moved.
+        Relocatable::moves = 0;
+        sc::vector<Relocatable> rvec;
+        rvec.reserve( 3 );
+        for ( auto i{0} ; i < 3 ; ++i )
+            rvec.emplace_back( i );
+        rvec.erase_unordered( rvec.begin() );
+        EXPECT_EQ( Relocatable::moves, 0 );
+        EXPECT_EQ( *rvec[0].m_value, 2 );
+        EXPECT_EQ( *rvec[1].m_value, 1 );
+
+        // A bad position throws from `checked` on (see checks.h); below, it is undefined behavior.
+        if constexpr ( sc::vector_checks >= sc::check_level::checked ) {
+            bool thrown{false};
+            try { rvec.erase_unordered( rvec.end() ); }
+            catch ( const std::out_of_range& ) { thrown = true; }
+            EXPECT_TRUE( thrown );
+        }
+    }
+#endif
+
+#if ERASE_IF_SINGLE_PASS
+    {
+        BEGIN_TEST(tm, "EraseIfSinglePass", "sc::erase_if(vec, pred) and sc::erase(vec, value)");
+        sc::vector<Tracked> vec;
+        for ( auto i{0} ; i < 10 ; ++i )
+            vec.emplace_back( std::to_string(i % 3) );
+        Tracked::reset();
+        int calls{0};
+        auto removed = sc::erase_if( vec, [&]( const Tracked& t ){ ++calls; return t.m_value == "1"; } );
+        EXPECT_EQ( removed, 3 );
+        EXPECT_EQ( calls, 10 );
+        EXPECT_EQ( vec.size(), 7 );
+        EXPECT_EQ( Tracked::alive, -3 );
+        std::string joined;
+        for ( const auto& t : vec )
+            joined += t.m_value;
+        EXPECT_EQ( joined, "0202020" );
+
+        sc::vector<int> ivec{ 5, 1, 5, 5, 2, 3, 5 };
+        EXPECT_EQ( sc::erase( ivec, 5 ), 4 );
+        EXPECT_EQ( ivec, ( sc::vector<int>{ 1, 2, 3 } ) );
+        EXPECT_EQ( ivec.remove_if( []( int x ){ return x > 10; } ), 0 );
+        EXPECT_EQ( ivec.size(), 3 );
+
+        // Runs of relocatable elements slide down with memmove; the removed ones are destroyed.
+        Relocatable::moves = 0;
+        sc::vector<Relocatable> rvec;
+        rvec.reserve( 8 );
+        for ( auto i{0} ; i < 8 ; ++i )
+            rvec.emplace_back( i );
+        EXPECT_EQ( rvec.remove_if( []( const Relocatable& r ){ return *r.m_value % 3 == 0; } ), 3 );
+        EXPECT_EQ( Relocatable::moves, 0 );
+        EXPECT_EQ( rvec.size(), 5 );
+        EXPECT_EQ( *rvec[0].m_value, 1 );
+        EXPECT_EQ( *rvec[2].m_value, 4 );
+        EXPECT_EQ( *rvec[4].m_value, 7 );
+
+        // Everything removed.
+        EXPECT_EQ( sc::erase_if( rvec, []( const Relocatable& ){ return true; } ), 5 );
+        EXPECT_TRUE( rvec.empty() );
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
@@ -0,0 +1,170 @@
+#include <cstddef>
+#include<iostream>
+#include<string>
+#include<thread>
+
+#include "include/tm/test_manager.h"
+#include "../include/vector.h"
+#include "../include/vector_stats.h"
+#include "main.h"
+
+// =============================================================
+// vector_stats tests. Most of them need a build with SC_VECTOR_STATS
+// (cmake -DSC_VECTOR_STATS=ON); otherwise only STATS_DISABLED runs.
+// =============================================================
+
+#ifdef SC_VECTOR_STATS
+// Allocations and deallocations are counted, with their sizes.
+#define COUNT_ALLOCATIONS YES
+// Element copies, moves and bitwise relocations are told apart.
+#define COPIES_VS_MOVES YES
+// Reallocations are counted per vector, and the worst vector is remembered.
+#define PER_INSTANCE_REALLOCS YES
+// The biggest unused capacity is recorded.
+#define PEAK_SLACK YES
+// The counters of every thread end up in the global stats.
+#define THREAD_REGISTRY YES
+#define STATS_DISABLED NO
+#else
+#define COUNT_ALLOCATIONS NO
+#define COPIES_VS_MOVES NO
+#define PER_INSTANCE_REALLOCS NO
+#define PEAK_SLACK NO
+#define THREAD_REGISTRY NO
+// Without SC_VECTOR_STATS nothing is recorded.
+#define STATS_DISABLED YES
+#endif
+
+void run_vector_stats_tests( void )
+{
+    TestManager tm{ "vector_stats testing"};
+
+#if COUNT_ALLOCATIONS
+    {
+        BEGIN_TEST(tm, "CountAllocations", "allocations, deallocations and bytes");
+        sc::reset_vector_stats();
+        {
+            sc::vector<int> vec;
+            for ( auto i{0} ; i < 100 ; ++i )
+                vec.push_back( i );
+            auto stats = sc::thread_vector_stats();
+            EXPECT_EQ( stats.allocations, stats.reallocations + 1 );
+            EXPECT_EQ( stats.deallocations, stats.reallocations );
+            EXPECT_GE( stats.bytes_allocated, 100 * sizeof(int) );
+        }
+        auto stats = sc::thread_vector_stats();
+        EXPECT_EQ( stats.deallocations, stats.allocations );
+        EXPECT_EQ( stats.bytes_deallocated, stats.bytes_allocated );
+    }
+#endif
+
+#if COPIES_VS_MOVES
+    {
+        BEGIN_TEST(tm, "CopiesVsMoves", "reserve/insert/assign copies and moves");
+        sc::reset_vector_stats();
+        sc::vector<std::string> vec;
+        vec.reserve( 10 );
+        std::string s{ "element" };
+        vec.push_back( s );
+        vec.push_back( std::move(s) );
+        EXPECT_EQ( sc::thread_vector_stats().copies, 1 );
+        EXPECT_EQ( sc::thread_vector_stats().moves, 1 );
+
+        // The new element is built aside (1 move), the two elements shift (2 moves)
+        // and the new one moves into its slot (1 move).
+        vec.insert( vec.begin(), std::string{ "first" } );
+        EXPECT_EQ( sc::thread_vector_stats().moves, 5 );
+
+        sc::vector<std::string> copy{ vec };
+        EXPECT_EQ( sc::thread_vector_stats().copies, 4 );
+        copy.assign( vec.begin(), vec.end() );
+        EXPECT_EQ( sc::thread_vector_stats().copies, 7 );
+        // Reallocating std::string moves every element (its move constructor is noexcept).
+        vec.reserve( 100 );
+        EXPECT_EQ( sc::thread_vector_stats().moves, 8 );
+
+        // Trivially copyable elements are relocated bitwise.
+        sc::vector<int> ivec{ 1, 2, 3, 4 };
+        EXPECT_EQ( sc::thread_vector_stats().copies, 11 );
+        ivec.erase( ivec.begin() );
+        ivec.reserve( 10 );
+        EXPECT_EQ( sc::thread_vector_stats().bitwise, 6 );
+    }
+#endif
+
+#if PER_INSTANCE_REALLOCS
+    {
+        BEGIN_TEST(tm, "PerInstanceReallocs", "vec.reallocations() and max_reallocations");
+        sc::reset_vector_stats();
+        sc::vector<int> grown;
+        for ( auto i{0} ; i < 1000 ; ++i )
+            grown.push_back( i );
+        sc::vector<int> reserved;
+        reserved.reserve( 1000 );
+        for ( auto i{0} ; i < 1000 ; ++i )
+            reserved.push_back( i );
+
+        // 10, 20, 40, ..., 1280: seven reallocations after the first allocation.
+        EXPECT_EQ( grown.reallocations(), 7 );
+        EXPECT_EQ( reserved.reallocations(), 0 );
+        EXPECT_EQ( sc::thread_vector_stats().reallocations, 7 );
+        EXPECT_EQ( sc::thread_vector_stats().max_reallocations, 7 );
+    }
+#endif
+
+#if PEAK_SLACK
+    {
+        BEGIN_TEST(tm, "PeakSlack", "biggest (capacity - size)");
+        sc::reset_vector_stats();
+        sc::vector<int> vec{ 1, 2, 3 };
+        vec.reserve( 1000 );
+        EXPECT_EQ( sc::thread_vector_stats().peak_slack_bytes, 997 * sizeof(int) );
+        vec.shrink_to_fit();
+        vec.clear();
+        EXPECT_EQ( sc::thread_vector_stats().peak_slack_bytes, 997 * sizeof(int) );
+    }
+#endif
+
+#if THREAD_REGISTRY
+    {
+        BEGIN_TEST(tm, "ThreadRegistry", "global_vector_stats() adds up every thread");
+        sc::reset_vector_stats();
+        auto work = []{
+            sc::vector<int> vec;
+            for ( auto i{0} ; i < 1000 ; ++i )
+                vec.push_back( i );
+        };
+        std::thread t1{ work };
+        std::thread t2{ work };
+        t1.join();
+        t2.join();
+        work();
+        auto global = sc::global_vector_stats();
+        EXPECT_EQ( global.reallocations, 21 );
+        EXPECT_EQ( global.max_reallocations, 7 );
+        EXPECT_EQ( sc::thread_vector_stats().reallocations, 7 );
+        EXPECT_EQ( global.allocations, global.deallocations );
+        sc::dump_vector_stats( std::cout );
+    }
+#endif
+
+#if STATS_DISABLED
+    {
+        BEGIN_TEST(tm, "StatsDisabled", "no SC_VECTOR_STATS, nothing recorded");
+        static_assert( not sc::vector_stats_enabled );
+        sc::reset_vector_stats();
+        sc::vector<std::string> vec;
+        for ( auto i{0} ; i < 100 ; ++i )
+            vec.push_back( std::to_string(i) );
+        vec.insert( vec.begin(), "x" );
+        auto stats = sc::global_vector_stats();
+        EXPECT_EQ( stats.allocations, 0 );
+        EXPECT_EQ( stats.copies, 0 );
+        EXPECT_EQ( stats.moves, 0 );
+        EXPECT_EQ( stats.reallocations, 0 );
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}
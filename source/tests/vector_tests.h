@@ -71,6 +71,10 @@
 #define ERASE_RANGE YES
 // Erase a single values at pos
 #define ERASE_SINGLE_VALUE YES
+// Resize, value-initializing the new elements
+#define RESIZE YES
+// Resize, copying a value into the new elements
+#define RESIZE_VALUE YES
 
 /// Tests the basic operations with a vector of integers.
 template <typename T, size_t S>
@@ -752,6 +756,54 @@ void run_regular_vector_tests( const std::array<T,S>& values, const std::array<T
     }
 #endif
 
+#if RESIZE
+    {
+        BEGIN_TEST(tm, "Resize","vec.resize(count)");
+        which_lib::vector<T> vec { values[0], values[1], values[2], values[3], values[4] };
+
+        // Shrinking keeps the capacity.
+        vec.resize( 2 );
+        EXPECT_EQ( vec.size(), 2 );
+        EXPECT_EQ( vec.capacity(), 5 );
+        EXPECT_EQ( vec, ( which_lib::vector<T>{ values[0], values[1] } ) );
+
+        // Growing within the capacity.
+        vec.resize( 4 );
+        EXPECT_EQ( vec.size(), 4 );
+        EXPECT_EQ( vec.capacity(), 5 );
+        EXPECT_EQ( vec[1], values[1] );
+        EXPECT_EQ( vec[2], T{} );
+        EXPECT_EQ( vec[3], T{} );
+
+        // Growing past the capacity.
+        vec.resize( 50 );
+        EXPECT_EQ( vec.size(), 50 );
+        EXPECT_GE( vec.capacity(), 50 );
+        EXPECT_EQ( vec[0], values[0] );
+        EXPECT_EQ( vec[49], T{} );
+
+        vec.resize( 0 );
+        EXPECT_TRUE( vec.empty() );
+    }
+#endif
+
+#if RESIZE_VALUE
+    {
+        BEGIN_TEST(tm, "ResizeValue","vec.resize(count, value)");
+        which_lib::vector<T> vec { values[0], values[1], values[2] };
+
+        vec.resize( 5, source[0] );
+        EXPECT_EQ( vec, ( which_lib::vector<T>{ values[0], values[1], values[2], source[0], source[0] } ) );
+        vec.resize( 1, source[1] );
+        EXPECT_EQ( vec, ( which_lib::vector<T>{ values[0] } ) );
+
+        // The value may be an element of the vector itself, even when it reallocates.
+        vec.shrink_to_fit();
+        vec.resize( 4, vec[0] );
+        EXPECT_EQ( vec, ( which_lib::vector<T>{ values[0], values[0], values[0], values[0] } ) );
+    }
+#endif
+
     tm.summary();
     std::cout << "\n\n";
 }
@@ -0,0 +1,141 @@
+#include <cstddef>
+#include<algorithm>
+#include<iostream>
+#include<numeric>
+#include<stdexcept>
+#include<string>
+
+#include "include/tm/test_manager.h"
+#include "../include/vector.h"
+#include "main.h"
+
+// =============================================================
+// vector_view tests: non-owning views and slices of vectors,
+// and vectors built back from them.
+// =============================================================
+
+// A view of a vector looks at its elements, not at a copy.
+#define VIEW_OF_VECTOR YES
+// subview/first/last/remove_prefix/remove_suffix only move the pointer.
+#define SLICING YES
+// sc::vector can be built from a view; const vectors give const views.
+#define VECTOR_FROM_VIEW YES
+// Views of arrays, conversions, iteration with standard algorithms.
+#define CONVERSIONS YES
+
+namespace {
+
+/// What a parser would do with a slice: read it, without owning it.
+int sum( sc::vector_view<const int> values ) {
+    return std::accumulate( values.begin(), values.end(), 0 );
+}
+
+} // namespace.
+
+void run_vector_view_tests( void )
+{
+    TestManager tm{ "vector_view testing"};
+
+#if VIEW_OF_VECTOR
+    {
+        BEGIN_TEST(tm, "ViewOfVector", "vec.view(), vector_view{vec}, writes through the view");
+        sc::vector<int> vec{ 1, 2, 3, 4, 5 };
+        sc::vector_view<int> view = vec;
+        EXPECT_EQ( view.data(), &vec[0] );
+        EXPECT_EQ( view.size(), 5 );
+        view[0] = 10;
+        EXPECT_EQ( vec[0], 10 );
+        EXPECT_EQ( view.front(), 10 );
+        EXPECT_EQ( view.back(), 5 );
+        EXPECT_EQ( sum( vec ), 24 );
+        EXPECT_EQ( sum( vec.view() ), 24 );
+        bool thrown{false};
+        try { view.at( 5 ); }
+        catch ( const std::out_of_range& ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+        EXPECT_TRUE( sc::vector_view<int>{}.empty() );
+        EXPECT_TRUE( sc::vector<int>{}.view().empty() );
+    }
+#endif
+
+#if SLICING
+    {
+        BEGIN_TEST(tm, "Slicing", "subview, first, last, remove_prefix, remove_suffix");
+        sc::vector<int> vec{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        auto middle = vec.subview( 2, 5 );
+        EXPECT_EQ( middle.data(), &vec[2] );
+        EXPECT_EQ( middle.size(), 5 );
+        EXPECT_EQ( middle[4], 6 );
+        // The count is clamped to the end; the offset is checked.
+        EXPECT_EQ( vec.subview( 7 ).size(), 3 );
+        EXPECT_EQ( vec.subview( 8, 100 ).size(), 2 );
+        EXPECT_TRUE( vec.subview( 10 ).empty() );
+        bool thrown{false};
+        try { vec.subview( 11 ); }
+        catch ( const std::out_of_range& ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+
+        EXPECT_EQ( middle.subview( 1, 2 )[0], 3 );
+        EXPECT_EQ( middle.first( 2 ).back(), 3 );
+        EXPECT_EQ( middle.last( 2 ).front(), 5 );
+        EXPECT_EQ( middle.last( 50 ).size(), 5 );
+        middle.remove_prefix( 1 );
+        middle.remove_suffix( 1 );
+        EXPECT_EQ( middle.size(), 3 );
+        EXPECT_EQ( middle.front(), 3 );
+        EXPECT_EQ( middle.back(), 5 );
+        thrown = false;
+        try { middle.remove_prefix( 4 ); }
+        catch ( const std::out_of_range& ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+    }
+#endif
+
+#if VECTOR_FROM_VIEW
+    {
+        BEGIN_TEST(tm, "VectorFromView", "explicit vector(view), const vectors, ==");
+        sc::vector<std::string> words{ "let", "x", "=", "1", ";" };
+        sc::vector<std::string> statement{ words.subview( 1, 3 ) };
+        EXPECT_EQ( statement, ( sc::vector<std::string>{ "x", "=", "1" } ) );
+        statement[0] = "y";
+        EXPECT_EQ( words[1], "x" );
+
+        const auto& cwords = words;
+        sc::vector_view<const std::string> cview = cwords;
+        auto tail = cwords.subview( 3 );
+        EXPECT_EQ( tail.size(), 2 );
+        sc::vector<std::string> copied{ tail };
+        EXPECT_EQ( copied.back(), ";" );
+        EXPECT_TRUE( ( cview.subview( 1, 3 ) != statement.view() ) );
+        sc::vector<std::string> again{ words.subview( 1, 3 ) };
+        EXPECT_TRUE( ( again.view() == words.subview( 1, 3 ) ) );
+        EXPECT_TRUE( ( again.view() != words.subview( 0, 3 ) ) );
+    }
+#endif
+
+#if CONVERSIONS
+    {
+        BEGIN_TEST(tm, "Conversions", "arrays, mutable to const, deduction guides, std::span");
+        int raw[]{ 4, 5, 6 };
+        sc::vector_view view{ raw };
+        EXPECT_EQ( view.size(), 3 );
+        sc::vector_view<const int> cview = view;
+        EXPECT_EQ( cview.data(), raw );
+        EXPECT_EQ( sum( raw ), 15 );
+        sc::vector<int> vec{ 1, 2 };
+        sc::vector_view deduced{ vec };
+        deduced[1] = 20;
+        EXPECT_EQ( vec[1], 20 );
+        EXPECT_EQ( std::count( view.begin(), view.end(), 5 ), 1 );
+#ifdef SC_VECTOR_HAS_SPAN
+        std::span<int> span = view;
+        EXPECT_EQ( span.size(), 3 );
+        sc::vector_view<const int> from_span{ span };
+        EXPECT_EQ( from_span.data(), raw );
+#endif
+    }
+#endif
+
+    tm.summary();
+    std::cout << "\n\n";
+}